@@ -1,8 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/benchmark/catch_benchmark.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <random>
 #include <cstdio>
+#include <cstdlib>
+#include <thread>
 
 #include "radixsort.hpp"
 #if HAVE_C99_SUPPORT
@@ -59,6 +63,27 @@ struct InitData
     }
 };
 
+/**
+ * A 32 byte record sorted by its float depth.
+ */
+struct Particle
+{
+    float position[3];
+    float depth;
+    uint32_t payload[4];
+};
+
+std::vector<Particle> make_particles(const float* depths, uint32_t size)
+{
+    std::vector<Particle> particles(size);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        particles[i].depth = depths[i];
+        particles[i].payload[0] = i;
+    }
+    return particles;
+}
+
 TEST_CASE("bench") 
 {
     // mersenne twister prng
@@ -68,6 +93,8 @@ TEST_CASE("bench")
     const InitData<uint32_t> uint32_data(rnd32);
     const InitData<uint64_t> uint64_data(rnd64);
     const InitData<float> float_data(rnd32);
+    const InitData<double> double_data(rnd64);
+    const InitData<uint16_t> uint16_data(rnd32);
 
     constexpr uint32_t start = 64, end = 65536, inc = 2;
 
@@ -77,50 +104,157 @@ TEST_CASE("bench")
     {
         snprintf(name, NAME_SIZE, "%d uint32_t key bits::radix8sort", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = uint32_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return bits::radix8sort(keys0, keys1, values0, values1, size);
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix8sort(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
                         });
                 };
 
 #if HAVE_C99_SUPPORT
         snprintf(name, NAME_SIZE, "%d uint32_t key radix8sort_u32", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = uint32_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return radix8sort_u32(keys0, keys1, values0, values1, size);
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return radix8sort_u32(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+#endif
+
+        snprintf(name, NAME_SIZE, "%d uint32_t key bits::radix11sort_desc", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix11sort_desc(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%d uint32_t key radix11sort_desc_u32", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return radix11sort_desc_u32(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+#endif
+
+        snprintf(name, NAME_SIZE, "%d uint32_t key only bits::radix11sort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix11sort(data.keys0(), data.keys1(), size);
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%d uint32_t key only radix11sort_keys_u32", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return radix11sort_keys_u32(data.keys0(), data.keys1(), size);
+                        });
+                };
+#endif
+
+        snprintf(name, NAME_SIZE, "%d uint32_t key bits::radix11argsort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix11argsort(data.keys0(), data.keys1(), data.values0(), data.values1(), size,
+                            false);
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%d uint32_t key radix11argsort_u32", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return radix11argsort_u32(data.keys0(), data.keys1(), data.values0(), data.values1(), size, 0);
+                        });
+                };
+#endif
+
+        snprintf(name, NAME_SIZE, "%d uint32_t key uint64_t value bits::radix11sort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                std::vector<uint64_t> values0(size), values1(size);
+                meter.measure([&runs, &values0, &values1, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix11sort(data.keys0(), data.keys1(), values0.data(), values1.data(), size);
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%d uint32_t key uint64_t value radix11sort_values64_u32", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                std::vector<uint64_t> values0(size), values1(size);
+                meter.measure([&runs, &values0, &values1, size](int i) {
+                        auto& data = runs[i];
+                        return radix11sort_values64_u32(data.keys0(), data.keys1(), values0.data(), values1.data(),
+                            size);
                         });
                 };
 #endif
 
         snprintf(name, NAME_SIZE, "%d uint32_t key bits::radix11sort", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = uint32_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return bits::radix11sort(keys0, keys1, values0, values1, size);
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix11sort(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
                         });
                 };
 
 #if HAVE_C99_SUPPORT
         snprintf(name, NAME_SIZE, "%d uint32_t key radix11sort_u32", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = uint32_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return radix11sort_u32(keys0, keys1, values0, values1, size);
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return radix11sort_u32(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+#endif
+
+        snprintf(name, NAME_SIZE, "%d uint32_t key bits::radix_sort_inplace", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        bits::radix_sort_inplace(data.keys0(), data.values0(), size);
+                        return data.keys0_[0];
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%d uint32_t key radixsort_inplace_u32", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        radixsort_inplace_u32(data.keys0(), data.values0(), size);
+                        return data.keys0_[0];
                         });
                 };
 #endif
 
         snprintf(name, NAME_SIZE, "%d uint32_t key std::sort", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = uint32_data.run_data(size);
-                meter.measure([first=std::begin(data.keys0_), last=std::end(data.keys0_)] {
-                        std::sort(first, last);
-                        return first;
+                std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                meter.measure([&runs](int i) {
+                        auto& data = runs[i];
+                        std::sort(data.keys0_.begin(), data.keys0_.end());
+                        return data.keys0_[0];
                         });
                 };
     }
@@ -129,50 +263,73 @@ TEST_CASE("bench")
     {
         snprintf(name, NAME_SIZE, "%d uint64_t key bits::radix8sort", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = uint64_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return bits::radix8sort(keys0, keys1, values0, values1, size);
+                std::vector<decltype(uint64_data.run_data(size))> runs(meter.runs(), uint64_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix8sort(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
                         });
                 };
 
 #if HAVE_C99_SUPPORT
         snprintf(name, NAME_SIZE, "%d uint64_t key radix8sort_u64", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = uint64_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return radix8sort_u64(keys0, keys1, values0, values1, size);
+                std::vector<decltype(uint64_data.run_data(size))> runs(meter.runs(), uint64_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return radix8sort_u64(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
                         });
                 };
 #endif
 
         snprintf(name, NAME_SIZE, "%d uint64_t key bits::radix11sort", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = uint64_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return bits::radix11sort(keys0, keys1, values0, values1, size);
+                std::vector<decltype(uint64_data.run_data(size))> runs(meter.runs(), uint64_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix11sort(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
                         });
                 };
 
 #if HAVE_C99_SUPPORT
         snprintf(name, NAME_SIZE, "%d uint64_t key radix11sort_u64", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = uint64_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return radix11sort_u64(keys0, keys1, values0, values1, size);
+                std::vector<decltype(uint64_data.run_data(size))> runs(meter.runs(), uint64_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return radix11sort_u64(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+#endif
+
+        snprintf(name, NAME_SIZE, "%d uint64_t key bits::radix_sort_inplace", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint64_data.run_data(size))> runs(meter.runs(), uint64_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        bits::radix_sort_inplace(data.keys0(), data.values0(), size);
+                        return data.keys0_[0];
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%d uint64_t key radixsort_inplace_u64", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint64_data.run_data(size))> runs(meter.runs(), uint64_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        radixsort_inplace_u64(data.keys0(), data.values0(), size);
+                        return data.keys0_[0];
                         });
                 };
 #endif
 
         snprintf(name, NAME_SIZE, "%d uint64_t key std::sort", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = uint64_data.run_data(size);
-                meter.measure([first=std::begin(data.keys0_), last=std::end(data.keys0_)] {
-                        std::sort(first, last);
-                        return first;
+                std::vector<decltype(uint64_data.run_data(size))> runs(meter.runs(), uint64_data.run_data(size));
+                meter.measure([&runs](int i) {
+                        auto& data = runs[i];
+                        std::sort(data.keys0_.begin(), data.keys0_.end());
+                        return data.keys0_[0];
                         });
                 };
     }
@@ -181,52 +338,692 @@ TEST_CASE("bench")
     {
         snprintf(name, NAME_SIZE, "%d float key bits::radix8sort", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = float_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return bits::radix8sort(keys0, keys1, values0, values1, size);
+                std::vector<decltype(float_data.run_data(size))> runs(meter.runs(), float_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix8sort(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
                         });
                 };
 
 #if HAVE_C99_SUPPORT
         snprintf(name, NAME_SIZE, "%d float key radix8sort_f32", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = float_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return radix8sort_f32(keys0, keys1, values0, values1, size);
+                std::vector<decltype(float_data.run_data(size))> runs(meter.runs(), float_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return radix8sort_f32(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
                         });
                 };
 #endif
 
         snprintf(name, NAME_SIZE, "%d float key bits::radix11sort", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = float_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return bits::radix11sort(keys0, keys1, values0, values1, size);
+                std::vector<decltype(float_data.run_data(size))> runs(meter.runs(), float_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix11sort(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
                         });
                 };
 
 #if HAVE_C99_SUPPORT
         snprintf(name, NAME_SIZE, "%d float key radix11sort_f32", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = float_data.run_data(size);
-                meter.measure([keys0=data.keys0(), keys1=data.keys1(),
-                        values0=data.values0(), values1=data.values1(), size] {
-                        return radix11sort_f32(keys0, keys1, values0, values1, size);
+                std::vector<decltype(float_data.run_data(size))> runs(meter.runs(), float_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return radix11sort_f32(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+#endif
+
+        snprintf(name, NAME_SIZE, "%d float key bits::radix_sort_inplace", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(float_data.run_data(size))> runs(meter.runs(), float_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        bits::radix_sort_inplace(data.keys0(), data.values0(), size);
+                        return data.keys0_[0];
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%d float key radixsort_inplace_f32", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(float_data.run_data(size))> runs(meter.runs(), float_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        radixsort_inplace_f32(data.keys0(), data.values0(), size);
+                        return data.keys0_[0];
                         });
                 };
 #endif
 
         snprintf(name, NAME_SIZE, "%d float key std::sort", size);
         BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
-                auto data = float_data.run_data(size);
-                meter.measure([first=std::begin(data.keys0_), last=std::end(data.keys0_)] {
-                        std::sort(first, last);
-                        return first;
+                std::vector<decltype(float_data.run_data(size))> runs(meter.runs(), float_data.run_data(size));
+                meter.measure([&runs](int i) {
+                        auto& data = runs[i];
+                        std::sort(data.keys0_.begin(), data.keys0_.end());
+                        return data.keys0_[0];
+                        });
+                };
+
+        snprintf(name, NAME_SIZE, "%d float key 32 byte record bits::radix_sort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                const std::vector<Particle> particles = make_particles(float_data.keys_.data(), size);
+                std::vector<std::vector<Particle>> runs(meter.runs(), particles);
+                std::vector<Particle> temp(size);
+                meter.measure([&runs, &temp, size](int i) {
+                        return bits::radix_sort(runs[i].data(), temp.data(), size,
+                            [](const Particle& particle) { return particle.depth; });
+                        });
+                };
+
+        snprintf(name, NAME_SIZE, "%d float key 32 byte record bits::radix11argsort and gather", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                const std::vector<Particle> particles = make_particles(float_data.keys_.data(), size);
+                std::vector<std::vector<Particle>> runs(meter.runs(), particles);
+                std::vector<Particle> temp(size);
+                std::vector<float> keys0(size), keys1(size);
+                std::vector<uint32_t> indices0(size), indices1(size);
+                meter.measure([&](int i) {
+                        const Particle* records = runs[i].data();
+                        for (uint32_t j = 0; j < size; ++j)
+                        {
+                            keys0[j] = records[j].depth;
+                        }
+                        const uint32_t out = bits::radix11argsort(keys0.data(), keys1.data(), indices0.data(),
+                            indices1.data(), size, false);
+                        const uint32_t* indices = out ? indices1.data() : indices0.data();
+                        for (uint32_t j = 0; j < size; ++j)
+                        {
+                            temp[j] = records[indices[j]];
+                        }
+                        return temp[0].depth;
+                        });
+                };
+    }
+
+    for (uint32_t size = start; size <= end; size = size << inc)
+    {
+        snprintf(name, NAME_SIZE, "%d double key bits::radix8sort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(double_data.run_data(size))> runs(meter.runs(), double_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix8sort(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%d double key radix8sort_f64", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(double_data.run_data(size))> runs(meter.runs(), double_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return radix8sort_f64(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+#endif
+
+        snprintf(name, NAME_SIZE, "%d double key bits::radix11sort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(double_data.run_data(size))> runs(meter.runs(), double_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::radix11sort(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%d double key radix11sort_f64", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(double_data.run_data(size))> runs(meter.runs(), double_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return radix11sort_f64(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+#endif
+
+        snprintf(name, NAME_SIZE, "%d double key std::sort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(double_data.run_data(size))> runs(meter.runs(), double_data.run_data(size));
+                meter.measure([&runs](int i) {
+                        auto& data = runs[i];
+                        std::sort(data.keys0_.begin(), data.keys0_.end());
+                        return data.keys0_[0];
                         });
                 };
     }
+
+    for (uint32_t size = start; size <= end; size = size << inc)
+    {
+        snprintf(name, NAME_SIZE, "%d uint16_t key bits::counting_sort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint16_data.run_data(size))> runs(meter.runs(), uint16_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::counting_sort(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%d uint16_t key counting_sort_u16", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint16_data.run_data(size))> runs(meter.runs(), uint16_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return counting_sort_u16(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+#endif
+
+        snprintf(name, NAME_SIZE, "%d uint16_t key std::sort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint16_data.run_data(size))> runs(meter.runs(), uint16_data.run_data(size));
+                meter.measure([&runs](int i) {
+                        auto& data = runs[i];
+                        std::sort(data.keys0_.begin(), data.keys0_.end());
+                        return data.keys0_[0];
+                        });
+                };
+    }
+
+    // half float keys are the random uint16_t keys reinterpreted
+    for (uint32_t size = start; size <= end; size = size << inc)
+    {
+        snprintf(name, NAME_SIZE, "%d half key bits::counting_sort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint16_data.run_data(size))> runs(meter.runs(), uint16_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return bits::counting_sort(reinterpret_cast<bits::Float16*>(data.keys0()),
+                            reinterpret_cast<bits::Float16*>(data.keys1()), data.values0(), data.values1(), size);
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%d half key counting_sort_f16", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<decltype(uint16_data.run_data(size))> runs(meter.runs(), uint16_data.run_data(size));
+                meter.measure([&runs, size](int i) {
+                        auto& data = runs[i];
+                        return counting_sort_f16(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                        });
+                };
+#endif
+    }
 };
+
+/**
+ * Largest array size for the large array benchmarks, which can be lowered
+ * with the BENCH_MAX_SIZE environment variable on machines with less than the
+ * 24GB of memory needed to sort 1G 64 bit keys.
+ */
+uint32_t bench_max_size()
+{
+    const char* max_size = std::getenv("BENCH_MAX_SIZE");
+    return max_size ? static_cast<uint32_t>(std::strtoul(max_size, nullptr, 0)) : (1u << 30);
+}
+
+template <typename KeyType, typename Rand>
+RunData<KeyType> large_run_data(uint32_t size, Rand& rand)
+{
+    std::vector<KeyType> keys(size);
+    std::vector<uint32_t> values(size);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys[i] = static_cast<KeyType>(rand());
+        values[i] = i;
+    }
+    return RunData<KeyType>(size, keys.begin(), values.begin());
+}
+
+TEST_CASE("bench msd", "[.][large]")
+{
+    std::mt19937_64 rnd64;
+
+    constexpr uint32_t start = 1 << 20, inc = 2;
+    const uint32_t end = bench_max_size();
+
+    constexpr size_t NAME_SIZE = 1024;
+    char name[NAME_SIZE];
+    for (uint32_t size = start; size <= end && size != 0; size = size << inc)
+    {
+        auto data = large_run_data<uint64_t>(size, rnd64);
+
+        snprintf(name, NAME_SIZE, "%u uint64_t key bits::radix_sort_msd", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<RunData<uint64_t>> runs(meter.runs(), data);
+                meter.measure([&runs, size](int i) {
+                        auto& run = runs[i];
+                        return bits::radix_sort_msd(run.keys0(), run.keys1(), run.values0(), run.values1(), size);
+                        });
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%u uint64_t key radixsort_msd_u64", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<RunData<uint64_t>> runs(meter.runs(), data);
+                meter.measure([&runs, size](int i) {
+                        auto& run = runs[i];
+                        return radixsort_msd_u64(run.keys0(), run.keys1(), run.values0(), run.values1(), size);
+                        });
+                };
+#endif
+
+        snprintf(name, NAME_SIZE, "%u uint64_t key bits::radix8sort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<RunData<uint64_t>> runs(meter.runs(), data);
+                meter.measure([&runs, size](int i) {
+                        auto& run = runs[i];
+                        return bits::radix8sort(run.keys0(), run.keys1(), run.values0(), run.values1(), size);
+                        });
+                };
+
+        snprintf(name, NAME_SIZE, "%u uint64_t key bits::radix_sort_inplace", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<RunData<uint64_t>> runs(meter.runs(), data);
+                meter.measure([&runs, size](int i) {
+                        auto& run = runs[i];
+                        bits::radix_sort_inplace(run.keys0(), run.values0(), size);
+                        return run.keys0_[0];
+                        });
+                };
+
+        snprintf(name, NAME_SIZE, "%u uint64_t key bits::radix11sort", size);
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                std::vector<RunData<uint64_t>> runs(meter.runs(), data);
+                meter.measure([&runs, size](int i) {
+                        auto& run = runs[i];
+                        return bits::radix11sort(run.keys0(), run.keys1(), run.values0(), run.values1(), size);
+                        });
+                };
+    }
+}
+
+/**
+ * Keys drawn from a Zipf distribution over random 64 bit ids, like user ids
+ * where a few users account for most of the records.
+ */
+RunData<uint64_t> zipf_run_data(uint32_t size, std::mt19937_64& rand, uint32_t num_ids = 1 << 20,
+    double exponent = 1.0)
+{
+    std::vector<uint64_t> ids(num_ids);
+    std::vector<double> cdf(num_ids);
+    double sum = 0.0;
+    for (uint32_t i = 0; i < num_ids; ++i)
+    {
+        ids[i] = rand();
+        sum += 1.0 / std::pow(double(i + 1), exponent);
+        cdf[i] = sum;
+    }
+
+    std::uniform_real_distribution<double> uniform(0.0, sum);
+    std::vector<uint64_t> keys(size);
+    std::vector<uint32_t> values(size);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const auto rank = std::lower_bound(cdf.begin(), cdf.end(), uniform(rand)) - cdf.begin();
+        keys[i] = ids[std::min<size_t>(rank, num_ids - 1)];
+        values[i] = i;
+    }
+    return RunData<uint64_t>(size, keys.begin(), values.begin());
+}
+
+TEST_CASE("bench parallel", "[.][large]")
+{
+    std::mt19937_64 rnd64;
+
+    constexpr uint32_t start = 1 << 20, inc = 2;
+    const uint32_t end = bench_max_size();
+    const uint32_t max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    constexpr size_t NAME_SIZE = 1024;
+    char name[NAME_SIZE];
+    for (uint32_t size = start; size <= end && size != 0; size = size << inc)
+    {
+        const RunData<uint64_t> inputs[] = {large_run_data<uint64_t>(size, rnd64), zipf_run_data(size, rnd64)};
+        const char* input_names[] = {"uniform", "zipf"};
+
+        for (uint32_t input = 0; input < 2; ++input)
+        {
+            const auto& data = inputs[input];
+            const char* input_name = input_names[input];
+
+            for (uint32_t num_threads = 1; num_threads <= max_threads; num_threads *= 2)
+            {
+                snprintf(name, NAME_SIZE, "%u %s uint64_t key bits::radix11sort_parallel %u threads", size,
+                    input_name, num_threads);
+                BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                        std::vector<RunData<uint64_t>> runs(meter.runs(), data);
+                        meter.measure([&runs, size, num_threads](int i) {
+                                auto& run = runs[i];
+                                return bits::radix11sort_parallel(run.keys0(), run.keys1(), run.values0(),
+                                    run.values1(), size, num_threads);
+                                });
+                        };
+
+#if HAVE_C99_SUPPORT
+                snprintf(name, NAME_SIZE, "%u %s uint64_t key radix11sort_parallel_u64 %u threads", size,
+                    input_name, num_threads);
+                BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                        std::vector<RunData<uint64_t>> runs(meter.runs(), data);
+                        meter.measure([&runs, size, num_threads](int i) {
+                                auto& run = runs[i];
+                                return radix11sort_parallel_u64(run.keys0(), run.keys1(), run.values0(),
+                                    run.values1(), size, num_threads);
+                                });
+                        };
+#endif
+
+                snprintf(name, NAME_SIZE, "%u %s uint64_t key bits::radix_sort_msd_parallel %u threads", size,
+                    input_name, num_threads);
+                BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                        std::vector<RunData<uint64_t>> runs(meter.runs(), data);
+                        meter.measure([&runs, size, num_threads](int i) {
+                                auto& run = runs[i];
+                                return bits::radix_sort_msd_parallel(run.keys0(), run.keys1(), run.values0(),
+                                    run.values1(), size, num_threads);
+                                });
+                        };
+
+                snprintf(name, NAME_SIZE, "%u %s uint64_t key bits::radix_sort_inplace_parallel %u threads",
+                    size, input_name, num_threads);
+                BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                        std::vector<RunData<uint64_t>> runs(meter.runs(), data);
+                        meter.measure([&runs, size, num_threads](int i) {
+                                auto& run = runs[i];
+                                bits::radix_sort_inplace_parallel(run.keys0(), run.values0(), size, num_threads);
+                                return run.keys0_[0];
+                                });
+                        };
+            }
+        }
+    }
+}
+
+/**
+ * Reorder columns of 64 bit values by a random permutation, gathering each
+ * column directly and with apply_permutation on every hardware thread.
+ */
+TEST_CASE("bench permutation", "[.][large]")
+{
+    std::mt19937 rnd32;
+
+    constexpr uint32_t start = 1 << 20, inc = 2, num_columns = 4;
+    const uint32_t end = bench_max_size();
+    const uint32_t num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    constexpr size_t NAME_SIZE = 1024;
+    char name[NAME_SIZE];
+    for (uint32_t size = start; size <= end && size != 0; size = size << inc)
+    {
+        std::vector<uint32_t> indices(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            indices[i] = i;
+        }
+        std::shuffle(indices.begin(), indices.end(), rnd32);
+        std::vector<uint64_t> values_in[num_columns];
+        std::vector<uint64_t> values_out[num_columns];
+        bits::PermutationColumn columns[num_columns];
+#if HAVE_C99_SUPPORT
+        radixsort_permutation_column c_columns[num_columns];
+#endif
+        for (uint32_t column = 0; column < num_columns; ++column)
+        {
+            values_in[column].assign(size, column);
+            values_out[column].resize(size);
+            columns[column] = {values_in[column].data(), values_out[column].data(), sizeof(uint64_t)};
+#if HAVE_C99_SUPPORT
+            c_columns[column] = {values_in[column].data(), values_out[column].data(), sizeof(uint64_t)};
+#endif
+        }
+
+        snprintf(name, NAME_SIZE, "%u rows %u uint64_t columns gather", size, num_columns);
+        BENCHMARK(name) {
+                for (uint32_t column = 0; column < num_columns; ++column)
+                {
+                    const uint64_t* in = values_in[column].data();
+                    uint64_t* out = values_out[column].data();
+                    for (uint32_t i = 0; i < size; ++i)
+                    {
+                        out[i] = in[indices[i]];
+                    }
+                }
+                return values_out[0][0];
+                };
+
+        snprintf(name, NAME_SIZE, "%u rows %u uint64_t columns bits::apply_permutation %u threads", size,
+            num_columns, num_threads);
+        BENCHMARK(name) {
+                bits::apply_permutation(indices.data(), size, columns, num_columns, num_threads);
+                return values_out[0][0];
+                };
+
+#if HAVE_C99_SUPPORT
+        snprintf(name, NAME_SIZE, "%u rows %u uint64_t columns radixsort_apply_permutation %u threads", size,
+            num_columns, num_threads);
+        BENCHMARK(name) {
+                radixsort_apply_permutation(indices.data(), size, c_columns, num_columns, num_threads);
+                return values_out[0][0];
+                };
+#endif
+    }
+}
+
+/**
+ * Sort random keys, keys repeating a few values, nearly sorted keys and 16 bit
+ * keys, the last two having long runs of equal digits, which the sorts count
+ * with two sets of histograms.
+ */
+TEST_CASE("bench counting", "[.][large]")
+{
+    std::mt19937 rnd32;
+
+    constexpr uint32_t start = 1 << 16, inc = 2;
+    const uint32_t end = bench_max_size();
+
+    static const char* key_names[] = {"random", "16 repeated", "nearly sorted", "16 bit"};
+
+    constexpr size_t NAME_SIZE = 1024;
+    char name[NAME_SIZE];
+    for (uint32_t size = start; size <= end && size != 0; size = size << inc)
+    {
+        std::vector<uint32_t> inputs[4] = {std::vector<uint32_t>(size), std::vector<uint32_t>(size),
+            std::vector<uint32_t>(), std::vector<uint32_t>(size)};
+        uint32_t repeated[16];
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            repeated[i] = rnd32();
+        }
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            inputs[0][i] = rnd32();
+            inputs[1][i] = repeated[rnd32() & 15];
+            inputs[3][i] = rnd32() & 0xffff;
+        }
+        inputs[2] = inputs[0];
+        std::sort(inputs[2].begin(), inputs[2].end());
+        for (uint32_t i = 0; i < size / 100; ++i)
+        {
+            std::swap(inputs[2][rnd32() % size], inputs[2][rnd32() % size]);
+        }
+
+        std::vector<uint32_t> values(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            values[i] = i;
+        }
+
+        for (uint32_t input = 0; input < 4; ++input)
+        {
+            const RunData<uint32_t> data(size, inputs[input].begin(), values.begin());
+
+            snprintf(name, NAME_SIZE, "%u %s uint32_t key bits::radix8sort", size, key_names[input]);
+            BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                    std::vector<RunData<uint32_t>> runs(meter.runs(), data);
+                    meter.measure([&runs, size](int i) {
+                            auto& run = runs[i];
+                            return bits::radix8sort(run.keys0(), run.keys1(), run.values0(), run.values1(), size);
+                            });
+                    };
+
+            snprintf(name, NAME_SIZE, "%u %s uint32_t key bits::radix11sort", size, key_names[input]);
+            BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                    std::vector<RunData<uint32_t>> runs(meter.runs(), data);
+                    meter.measure([&runs, size](int i) {
+                            auto& run = runs[i];
+                            return bits::radix11sort(run.keys0(), run.keys1(), run.values0(), run.values1(), size);
+                            });
+                    };
+
+#if HAVE_C99_SUPPORT
+            snprintf(name, NAME_SIZE, "%u %s uint32_t key radix8sort_u32", size, key_names[input]);
+            BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                    std::vector<RunData<uint32_t>> runs(meter.runs(), data);
+                    meter.measure([&runs, size](int i) {
+                            auto& run = runs[i];
+                            return radix8sort_u32(run.keys0(), run.keys1(), run.values0(), run.values1(), size);
+                            });
+                    };
+
+            snprintf(name, NAME_SIZE, "%u %s uint32_t key radix11sort_u32", size, key_names[input]);
+            BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                    std::vector<RunData<uint32_t>> runs(meter.runs(), data);
+                    meter.measure([&runs, size](int i) {
+                            auto& run = runs[i];
+                            return radix11sort_u32(run.keys0(), run.keys1(), run.values0(), run.values1(), size);
+                            });
+                    };
+#endif
+        }
+    }
+}
+
+TEST_CASE("bench scatter", "[.][large]")
+{
+    std::mt19937 rnd32;
+    std::mt19937_64 rnd64;
+
+    constexpr uint32_t start = 1 << 16, inc = 2;
+    const uint32_t end = bench_max_size();
+
+    static const bits::ScatterMode modes[] = {bits::kScatterDirect, bits::kScatterBuffered, bits::kScatterStreaming,
+        bits::kScatterBlock};
+    static const char* mode_names[] = {"direct", "buffered", "streaming", "block"};
+#if HAVE_C99_SUPPORT
+    static const radixsort_scatter_mode c_modes[] = {RADIXSORT_SCATTER_DIRECT, RADIXSORT_SCATTER_BUFFERED,
+        RADIXSORT_SCATTER_STREAMING, RADIXSORT_SCATTER_BLOCK};
+#endif
+
+    constexpr size_t NAME_SIZE = 1024;
+    char name[NAME_SIZE];
+    for (uint32_t size = start; size <= end && size != 0; size = size << inc)
+    {
+        auto data32 = large_run_data<uint32_t>(size, rnd32);
+        auto data64 = large_run_data<uint64_t>(size, rnd64);
+
+        for (uint32_t mode = 0; mode < 4; ++mode)
+        {
+            const bits::ScatterMode scatter_mode = modes[mode];
+
+            snprintf(name, NAME_SIZE, "%u uint32_t key bits::radix8sort %s", size, mode_names[mode]);
+            BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                    std::vector<RunData<uint32_t>> runs(meter.runs(), data32);
+                    meter.measure([&runs, size, scatter_mode](int i) {
+                            auto& run = runs[i];
+                            return bits::radix8sort(run.keys0(), run.keys1(), run.values0(), run.values1(), size,
+                                scatter_mode);
+                            });
+                    };
+
+            snprintf(name, NAME_SIZE, "%u uint64_t key bits::radix8sort %s", size, mode_names[mode]);
+            BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                    std::vector<RunData<uint64_t>> runs(meter.runs(), data64);
+                    meter.measure([&runs, size, scatter_mode](int i) {
+                            auto& run = runs[i];
+                            return bits::radix8sort(run.keys0(), run.keys1(), run.values0(), run.values1(), size,
+                                scatter_mode);
+                            });
+                    };
+
+#if HAVE_C99_SUPPORT
+            radixsort_set_scatter_mode(c_modes[mode]);
+
+            snprintf(name, NAME_SIZE, "%u uint32_t key radix8sort_u32 %s", size, mode_names[mode]);
+            BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                    std::vector<RunData<uint32_t>> runs(meter.runs(), data32);
+                    meter.measure([&runs, size](int i) {
+                            auto& run = runs[i];
+                            return radix8sort_u32(run.keys0(), run.keys1(), run.values0(), run.values1(), size);
+                            });
+                    };
+
+            snprintf(name, NAME_SIZE, "%u uint64_t key radix8sort_u64 %s", size, mode_names[mode]);
+            BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                    std::vector<RunData<uint64_t>> runs(meter.runs(), data64);
+                    meter.measure([&runs, size](int i) {
+                            auto& run = runs[i];
+                            return radix8sort_u64(run.keys0(), run.keys1(), run.values0(), run.values1(), size);
+                            });
+                    };
+
+            radixsort_set_scatter_mode(RADIXSORT_SCATTER_AUTO);
+#endif
+        }
+    }
+}
+
+#if HAVE_C99_SUPPORT
+TEST_CASE("bench isa", "[.]")
+{
+    std::mt19937 rnd32;
+    std::mt19937_64 rnd64;
+
+    const InitData<uint32_t> uint32_data(rnd32);
+    const InitData<uint64_t> uint64_data(rnd64);
+
+    constexpr uint32_t start = 16, end = 65536, inc = 2;
+
+    static const radixsort_isa isas[] = {RADIXSORT_ISA_BASELINE, RADIXSORT_ISA_AVX2, RADIXSORT_ISA_AVX512};
+    static const char* isa_names[] = {"auto", "baseline", "avx2", "avx512"};
+
+    constexpr size_t NAME_SIZE = 1024;
+    char name[NAME_SIZE];
+    for (uint32_t size = start; size <= end; size = size << inc)
+    {
+        for (const radixsort_isa requested : isas)
+        {
+            // levels the CPU doesn't support fall back to one already measured
+            const radixsort_isa isa = radixsort_set_isa(requested);
+            if (isa != requested)
+            {
+                continue;
+            }
+
+            snprintf(name, NAME_SIZE, "%u uint32_t key radix8sort_u32 %s", size, isa_names[isa]);
+            BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                    std::vector<decltype(uint32_data.run_data(size))> runs(meter.runs(), uint32_data.run_data(size));
+                    meter.measure([&runs, size](int i) {
+                            auto& data = runs[i];
+                            return radix8sort_u32(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                            });
+                    };
+
+            snprintf(name, NAME_SIZE, "%u uint64_t key radix8sort_u64 %s", size, isa_names[isa]);
+            BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                    std::vector<decltype(uint64_data.run_data(size))> runs(meter.runs(), uint64_data.run_data(size));
+                    meter.measure([&runs, size](int i) {
+                            auto& data = runs[i];
+                            return radix8sort_u64(data.keys0(), data.keys1(), data.values0(), data.values1(), size);
+                            });
+                    };
+        }
+    }
+    radixsort_set_isa(RADIXSORT_ISA_AUTO);
+}
+#endif
 } // namespace
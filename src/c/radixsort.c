@@ -17,10 +17,39 @@
  *    misrepresented as being the original software.
  * 3. This notice may not be removed or altered from any source distribution.
  */
-#include "radixsort.h"
+#include "radixsort_isa.h"
 #include <assert.h>
+#include <stdbool.h>
 #include <string.h>
 
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* this file is compiled once for each instruction set level, see
+ * radixsort_isa.h, and without a level it builds the baseline */
+#if !defined(RADIXSORT_ISA_SUFFIX)
+#define RADIXSORT_ISA_SUFFIX baseline
+#endif
+#define RADIXSORT_ISA_FN(name) RADIXSORT_ISA_CONCAT(name, RADIXSORT_ISA_SUFFIX)
+
+#define RADIXSORT_ISA_DECLARE_R(type, name, params, args) type RADIXSORT_ISA_FN(name) params;
+#define RADIXSORT_ISA_DECLARE_V(name, params, args) void RADIXSORT_ISA_FN(name) params;
+RADIXSORT_ISA_FUNCTIONS(RADIXSORT_ISA_DECLARE_R, RADIXSORT_ISA_DECLARE_V)
+RADIXSORT_ISA_INTERNAL_FUNCTIONS(RADIXSORT_ISA_DECLARE_R, RADIXSORT_ISA_DECLARE_V)
+
 #define RADIX_BITS_8 8
 #define RADIX_BITS_11 11
 #define HIST_SIZE_8 (1 << 8)
@@ -32,6 +61,76 @@
 #define HIST_BUCKETS_64_8 (uint32_t)(1 + (((sizeof(uint64_t) * 8) - 1) / 8))
 #define HIST_BUCKETS_64_11 (uint32_t)(1 + (((sizeof(uint64_t) * 8) - 1) / 11))
 
+/* arrays up to this size are sorted with a sorting network, as clearing and
+ * summing the histograms costs more than sorting them */
+#define SMALL_SORT_THRESHOLD_8 32
+#define SMALL_SORT_THRESHOLD_11 128
+/* arrays of at least this many keys are counted into two sets of histograms
+ * when at least COUNT_SPLIT_REPEATS of COUNT_SPLIT_SAMPLES pairs of
+ * neighbouring keys share a digit, so runs of equal digits don't wait on the
+ * previous increment of the same counter. On random keys the second set only
+ * costs time, and on small arrays clearing and merging it costs more than it
+ * saves. */
+#define COUNT_SPLIT_MIN_KEYS (1 << 16)
+#define COUNT_SPLIT_SAMPLES 64
+#define COUNT_SPLIT_REPEATS 16
+/* partitions of 64 bit keys and 32 bit values whose keys and values, plus
+ * their temporary buffers, fit in 1MB are finished with the LSD sort */
+#define MSD_LSD_THRESHOLD_64 ((1 << 20) / (2 * (sizeof(uint64_t) + sizeof(uint32_t))))
+/* arrays up to this size are insertion sorted */
+#define INSERTION_SORT_THRESHOLD 32
+/* each thread of a parallel sort is given at least this many keys, smaller
+ * arrays use fewer threads and arrays too small for two threads are sorted on
+ * the calling thread */
+#define PARALLEL_MIN_KEYS_PER_THREAD (1 << 16)
+/* the buffered scatter stages a cache line of keys per digit, and the block
+ * scatter partitions enough keys for a cache line per digit on average */
+#define SCATTER_LINE_BYTES 64
+#define SCATTER_LINE_KEYS_32 (SCATTER_LINE_BYTES / sizeof(uint32_t))
+#define SCATTER_LINE_KEYS_64 (SCATTER_LINE_BYTES / sizeof(uint64_t))
+/* 16 bit keys are counting sorted in one pass with a 65536 entry histogram
+ * from this many keys, smaller arrays take two passes with 8 bit digits as
+ * clearing and summing the large histogram costs more than the second pass */
+#define COUNTING_SORT_MIN_SIZE_16 (1 << 16)
+/* arrays whose keys and values take at least this many bytes are scattered
+ * through line buffers with streaming stores when the scatter mode is
+ * automatic, below it writing directly is faster */
+#define SCATTER_STREAMING_BYTES (1 << 23)
+/* columns of at least this many bytes are reordered through a partition of
+ * the permutation by input block, smaller ones mostly stay in the last level
+ * cache and are gathered directly */
+#define PERMUTE_PARTITION_MIN_BYTES (1 << 25)
+/* each partition of the permutation reads a block of the input of about this
+ * size, which stays in the L2 cache */
+#define PERMUTE_BLOCK_BYTES (1 << 20)
+/* interleaving the partitions keeps a cache line of each in use */
+#define PERMUTE_MAX_PARTITIONS 4096
+
+/* the radix passes are inlined into each case of DISPATCH_VALUE_SIZE, which
+ * must happen for the value size to be a constant in their loops */
+#if defined(_MSC_VER)
+#define FORCE_INLINE __forceinline
+#elif defined(__GNUC__)
+#define FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define FORCE_INLINE inline
+#endif
+
+/* evaluate call, which passes kValueSize as its value size, with kValueSize
+ * a constant for each common value size so each size gets its own copy of the
+ * loop, moving values as integers rather than by a memcpy of value_size bytes.
+ * Key only sorts have a value size of 0. */
+#define DISPATCH_VALUE_SIZE(value_size, call) \
+    switch (value_size) \
+    { \
+    case 0: { const size_t kValueSize = 0; call; } break; \
+    case sizeof(uint8_t): { const size_t kValueSize = sizeof(uint8_t); call; } break; \
+    case sizeof(uint16_t): { const size_t kValueSize = sizeof(uint16_t); call; } break; \
+    case sizeof(uint32_t): { const size_t kValueSize = sizeof(uint32_t); call; } break; \
+    case sizeof(uint64_t): { const size_t kValueSize = sizeof(uint64_t); call; } break; \
+    default: { const size_t kValueSize = value_size; call; } break; \
+    }
+
 /**
  * Flip a float for sorting.
  *  finds SIGN of fp number.
@@ -57,293 +156,4401 @@ static inline uint32_t inv_float_flip(const uint32_t f)
 }
 
 /**
-  * Initialise each histogram bucket with the key value
-  */
-static void init_histograms_u32(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize,
-    uint32_t* restrict hist, const uint32_t* restrict keys_in, const uint32_t size)
+ * Flip a double for sorting, as float_flip.
+ */
+static inline uint64_t double_flip(const uint64_t f)
 {
-    memset(hist, 0, sizeof(uint32_t) * kHistBuckets * kHistSize);
+    uint64_t mask = -((int64_t)(f >> 63)) | UINT64_C(0x8000000000000000);
+    return f ^ mask;
+}
 
-    const uint32_t kHistMask = kHistSize - 1;
-    for (uint32_t i = 0; i < size; ++i)
+/**
+ * Flip a double back (invert double_flip).
+ */
+static inline uint64_t inv_double_flip(const uint64_t f)
+{
+    uint64_t mask = ((f >> 63) - 1) | UINT64_C(0x8000000000000000);
+    return f ^ mask;
+}
+
+/**
+ * Flip a half float or bfloat16 for sorting, as float_flip. Both share the
+ * sign bit and put the exponent above the mantissa, so one flip serves both.
+ */
+static inline uint16_t half_flip(const uint16_t f)
+{
+    uint16_t mask = (uint16_t)(-((int16_t)(f >> 15)) | 0x8000);
+    return f ^ mask;
+}
+
+/**
+ * Flip a half float or bfloat16 back (invert half_flip).
+ */
+static inline uint16_t inv_half_flip(const uint16_t f)
+{
+    uint16_t mask = (uint16_t)(((f >> 15) - 1) | 0x8000);
+    return f ^ mask;
+}
+
+/**
+ * Compare and exchange packed keys and indices so the lower item is stored
+ * first if ascending, or last if not.
+ */
+static inline void compare_exchange_packed(uint64_t* restrict items_a, uint64_t* restrict items_b,
+    const uint32_t count, const bool ascending)
+{
+    uint32_t i = 0;
+#if defined(__AVX2__)
+    const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i invert = ascending ? _mm256_setzero_si256() : _mm256_set1_epi64x(-1);
+    for (; i + 4 <= count; i += 4)
     {
-        const uint32_t key = keys_in[i];
-        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
-        {
-            const uint32_t shift = bucket * kRadixBits;
-            const uint32_t pos = (key >> shift) & kHistMask;
-            uint32_t* offset = hist + (bucket * kHistSize);
-            ++offset[pos];
-        }
+        const __m256i a = _mm256_loadu_si256((const __m256i*)(items_a + i));
+        const __m256i b = _mm256_loadu_si256((const __m256i*)(items_b + i));
+        const __m256i swap = _mm256_xor_si256(_mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias)), invert);
+        _mm256_storeu_si256((__m256i*)(items_a + i), _mm256_blendv_epi8(a, b, swap));
+        _mm256_storeu_si256((__m256i*)(items_b + i), _mm256_blendv_epi8(b, a, swap));
+    }
+#elif defined(__SSE4_2__)
+    const __m128i bias = _mm_set1_epi64x(INT64_MIN);
+    const __m128i invert = ascending ? _mm_setzero_si128() : _mm_set1_epi64x(-1);
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i*)(items_a + i));
+        const __m128i b = _mm_loadu_si128((const __m128i*)(items_b + i));
+        const __m128i swap = _mm_xor_si128(_mm_cmpgt_epi64(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)), invert);
+        _mm_storeu_si128((__m128i*)(items_a + i), _mm_blendv_epi8(a, b, swap));
+        _mm_storeu_si128((__m128i*)(items_b + i), _mm_blendv_epi8(b, a, swap));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const uint64_t a = items_a[i];
+        const uint64_t b = items_b[i];
+        const uint64_t lo = a < b ? a : b;
+        const uint64_t hi = a < b ? b : a;
+        items_a[i] = ascending ? lo : hi;
+        items_b[i] = ascending ? hi : lo;
     }
 }
 
 
-static void init_histograms_u64(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize,
-    uint32_t* restrict hist, const uint64_t* restrict keys_in, const uint32_t size)
+/**
+ * Compare and exchange pairs of keys and indices so the lower pair is stored
+ * first if ascending, or last if not. Indices are unique so ties between keys
+ * are broken on the index, which keeps the sort stable. Indices are compared
+ * unsigned like the keys, so the UINT64_MAX index of the padding sorts after
+ * every real pair, even one whose key is UINT64_MAX.
+ */
+static inline void compare_exchange_pairs(uint64_t* restrict keys_a, uint64_t* restrict keys_b,
+    uint64_t* restrict indices_a, uint64_t* restrict indices_b, const uint32_t count, const bool ascending)
 {
-    memset(hist, 0, sizeof(uint32_t) * kHistBuckets * kHistSize);
+    uint32_t i = 0;
+#if defined(__AVX2__)
+    const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i invert = ascending ? _mm256_setzero_si256() : _mm256_set1_epi64x(-1);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256i ka = _mm256_loadu_si256((const __m256i*)(keys_a + i));
+        const __m256i kb = _mm256_loadu_si256((const __m256i*)(keys_b + i));
+        const __m256i ia = _mm256_loadu_si256((const __m256i*)(indices_a + i));
+        const __m256i ib = _mm256_loadu_si256((const __m256i*)(indices_b + i));
+        const __m256i key_gt = _mm256_cmpgt_epi64(_mm256_xor_si256(ka, bias), _mm256_xor_si256(kb, bias));
+        const __m256i key_eq = _mm256_cmpeq_epi64(ka, kb);
+        const __m256i index_gt = _mm256_cmpgt_epi64(_mm256_xor_si256(ia, bias), _mm256_xor_si256(ib, bias));
+        const __m256i swap = _mm256_xor_si256(_mm256_or_si256(key_gt, _mm256_and_si256(key_eq, index_gt)), invert);
+        _mm256_storeu_si256((__m256i*)(keys_a + i), _mm256_blendv_epi8(ka, kb, swap));
+        _mm256_storeu_si256((__m256i*)(keys_b + i), _mm256_blendv_epi8(kb, ka, swap));
+        _mm256_storeu_si256((__m256i*)(indices_a + i), _mm256_blendv_epi8(ia, ib, swap));
+        _mm256_storeu_si256((__m256i*)(indices_b + i), _mm256_blendv_epi8(ib, ia, swap));
+    }
+#elif defined(__SSE4_2__)
+    const __m128i bias = _mm_set1_epi64x(INT64_MIN);
+    const __m128i invert = ascending ? _mm_setzero_si128() : _mm_set1_epi64x(-1);
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128i ka = _mm_loadu_si128((const __m128i*)(keys_a + i));
+        const __m128i kb = _mm_loadu_si128((const __m128i*)(keys_b + i));
+        const __m128i ia = _mm_loadu_si128((const __m128i*)(indices_a + i));
+        const __m128i ib = _mm_loadu_si128((const __m128i*)(indices_b + i));
+        const __m128i key_gt = _mm_cmpgt_epi64(_mm_xor_si128(ka, bias), _mm_xor_si128(kb, bias));
+        const __m128i key_eq = _mm_cmpeq_epi64(ka, kb);
+        const __m128i index_gt = _mm_cmpgt_epi64(_mm_xor_si128(ia, bias), _mm_xor_si128(ib, bias));
+        const __m128i swap = _mm_xor_si128(_mm_or_si128(key_gt, _mm_and_si128(key_eq, index_gt)), invert);
+        _mm_storeu_si128((__m128i*)(keys_a + i), _mm_blendv_epi8(ka, kb, swap));
+        _mm_storeu_si128((__m128i*)(keys_b + i), _mm_blendv_epi8(kb, ka, swap));
+        _mm_storeu_si128((__m128i*)(indices_a + i), _mm_blendv_epi8(ia, ib, swap));
+        _mm_storeu_si128((__m128i*)(indices_b + i), _mm_blendv_epi8(ib, ia, swap));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const uint64_t ka = keys_a[i];
+        const uint64_t kb = keys_b[i];
+        const uint64_t ia = indices_a[i];
+        const uint64_t ib = indices_b[i];
+        const uint64_t swap = 0 - (uint64_t)(((ka > kb) | ((ka == kb) & (ia > ib))) ^ !ascending);
+        const uint64_t key_diff = (ka ^ kb) & swap;
+        const uint64_t index_diff = (ia ^ ib) & swap;
+        keys_a[i] = ka ^ key_diff;
+        keys_b[i] = kb ^ key_diff;
+        indices_a[i] = ia ^ index_diff;
+        indices_b[i] = ib ^ index_diff;
+    }
+}
 
-    const uint32_t kHistMask = kHistSize - 1;
-    for (uint32_t i = 0; i < size; ++i)
+
+/**
+ * Round a small array size up to the power of two sorted by the network.
+ */
+static inline uint32_t bitonic_size(const uint32_t size)
+{
+    uint32_t padded_size = INSERTION_SORT_THRESHOLD;
+    while (padded_size < size)
     {
-        const uint64_t key = keys_in[i];
-        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
-        {
-            const uint32_t shift = bucket * kRadixBits;
-            const uint32_t pos = (key >> shift) & kHistMask;
-            uint32_t* offset = hist + (bucket * kHistSize);
-            ++offset[pos];
-        }
+        padded_size <<= 1;
     }
+    return padded_size;
 }
 
 
-static void init_histograms_f32(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize,
-    uint32_t* restrict hist, const uint32_t* restrict keys_in, const uint32_t size)
+/**
+ * Sort packed keys and indices with a bitonic sorting network, or insertion
+ * sort for the smallest arrays. Items are padded to a power of two with
+ * items that sort after every input item.
+ */
+static void small_sort_packed(uint64_t* restrict items, const uint32_t size)
 {
-    memset(hist, 0, sizeof(uint32_t) * kHistBuckets * kHistSize);
+    if (size <= INSERTION_SORT_THRESHOLD)
+    {
+        for (uint32_t i = 1; i < size; ++i)
+        {
+            const uint64_t item = items[i];
+            uint32_t j = i;
+            for (; j > 0 && items[j - 1] > item; --j)
+            {
+                items[j] = items[j - 1];
+            }
+            items[j] = item;
+        }
+        return;
+    }
 
-    const uint32_t kHistMask = kHistSize - 1;
-    for (uint32_t i = 0; i < size; ++i)
+    const uint32_t padded_size = bitonic_size(size);
+    for (uint32_t i = size; i < padded_size; ++i)
     {
-        const uint32_t key = float_flip(keys_in[i]);
-        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        items[i] = UINT64_MAX;
+    }
+    for (uint32_t k = 2; k <= padded_size; k <<= 1)
+    {
+        for (uint32_t j = k >> 1; j > 0; j >>= 1)
         {
-            const uint32_t shift = bucket * kRadixBits;
-            const uint32_t pos = (key >> shift) & kHistMask;
-            uint32_t* offset = hist + (bucket * kHistSize);
-            ++offset[pos];
+            // every item in a run of j items is sorted in the same direction
+            for (uint32_t base = 0; base < padded_size; base += j << 1)
+            {
+                compare_exchange_packed(items + base, items + base + j, j, (base & k) == 0);
+            }
         }
     }
 }
 
 
 /**
- * Update the histogram data so each entry sums the previous entries.
+ * Sort pairs of keys and indices with a bitonic sorting network, or stable
+ * insertion sort for the smallest arrays. Pairs are padded to a power of two
+ * with pairs that sort after every input pair.
  */
-static void sum_histograms(uint32_t* restrict sum, const uint32_t kHistBuckets, const uint32_t kHistSize, uint32_t* restrict hist)
+static void small_sort_pairs(uint64_t* restrict keys, uint64_t* restrict indices, const uint32_t size)
 {
-    for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+    if (size <= INSERTION_SORT_THRESHOLD)
     {
-        uint32_t* restrict offset = hist + (bucket * kHistSize);
-        sum[bucket] = offset[0];
-        offset[0] = 0;
+        for (uint32_t i = 1; i < size; ++i)
+        {
+            const uint64_t key = keys[i];
+            const uint64_t index = indices[i];
+            uint32_t j = i;
+            for (; j > 0 && keys[j - 1] > key; --j)
+            {
+                keys[j] = keys[j - 1];
+                indices[j] = indices[j - 1];
+            }
+            keys[j] = key;
+            indices[j] = index;
+        }
+        return;
     }
 
-    uint32_t tsum;
-    for (uint32_t i = 1; i < kHistSize; ++i)
+    const uint32_t padded_size = bitonic_size(size);
+    for (uint32_t i = size; i < padded_size; ++i)
     {
-        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        keys[i] = UINT64_MAX;
+        indices[i] = UINT64_MAX;
+    }
+    for (uint32_t k = 2; k <= padded_size; k <<= 1)
+    {
+        for (uint32_t j = k >> 1; j > 0; j >>= 1)
         {
-            uint32_t* restrict offset = hist + (bucket * kHistSize);
-            tsum = offset[i] + sum[bucket];
-            offset[i] = sum[bucket];
-            sum[bucket] = tsum;
+            // every pair in a run of j pairs is sorted in the same direction
+            for (uint32_t base = 0; base < padded_size; base += j << 1)
+            {
+                compare_exchange_pairs(keys + base, keys + base + j, indices + base, indices + base + j, j,
+                    (base & k) == 0);
+            }
         }
     }
 }
 
 
 /**
- * Perform a radix sort pass for the given bit shift and mask.
+ * Copy the value at index in to index out, or write in itself as a 32 bit
+ * index when values_in is null for argsorts. Values are value_size bytes
+ * apart, and value_size is a constant wherever this is inlined into a
+ * scatter loop, so the copy compiles to a load and store of the value.
  */
-static inline void radixpass_u32(uint32_t* restrict hist, const uint32_t shift, const uint32_t mask,
-    const uint32_t* restrict keys_in, uint32_t* restrict keys_out,
-    const uint32_t* restrict values_in, uint32_t* restrict values_out, const uint32_t size)
+static FORCE_INLINE void copy_value(void* restrict values_out, const uint32_t out, const void* restrict values_in,
+    const uint32_t in, const size_t value_size)
 {
-    for (uint32_t i = 0; i < size; ++i)
+    if (values_in)
     {
-        const uint32_t key = keys_in[i];
-        const uint32_t pos = (key >> shift) & mask;
-        const uint32_t index = hist[pos]++;
-        keys_out[index] = key;
-        values_out[index] = values_in[i];
+        memcpy((char*)values_out + (size_t)out * value_size, (const char*)values_in + (size_t)in * value_size,
+            value_size);
+    }
+    else
+    {
+        memcpy((char*)values_out + (size_t)out * sizeof(uint32_t), &in, sizeof(uint32_t));
     }
 }
 
 
-static inline void radixpass_u64(uint32_t* restrict hist, const uint32_t shift, const uint32_t mask,
-    const uint64_t* restrict keys_in, uint64_t* restrict keys_out,
-    const uint32_t* restrict values_in, uint32_t* restrict values_out, const uint32_t size)
+/**
+ * Sort small arrays of keys and values into the temporary buffers, writing
+ * each key's index as its value when values_in is null for argsorts. Keys are
+ * packed above their index so the network only moves one array. Keys are
+ * compared relative to bias, which orders signed keys when it is the sign
+ * bit, and inverted for descending sorts, which keeps equal keys in order.
+ * Returns the index of the buffer holding the sorted data, like the radix
+ * sort.
+ */
+static uint32_t small_sort_u32(const uint32_t* restrict keys_in, uint32_t* restrict keys_temp,
+    const void* restrict values_in, void* restrict values_temp, const size_t value_size, const uint32_t size,
+    const bool flip, const uint32_t bias, const bool descending)
 {
+    const uint32_t invert = descending ? UINT32_MAX : 0;
+    uint64_t items[SMALL_SORT_THRESHOLD_11];
     for (uint32_t i = 0; i < size; ++i)
     {
-        const uint64_t key = keys_in[i];
-        const uint32_t pos = (key >> shift) & mask;
-        const uint32_t index = hist[pos]++;
-        keys_out[index] = key;
-        values_out[index] = values_in[i];
+        const uint32_t key = ((flip ? float_flip(keys_in[i]) : keys_in[i]) - bias) ^ invert;
+        items[i] = ((uint64_t)key << 32) | i;
     }
-}
-
-
-static inline uint32_t radixsort_u32(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize, uint32_t* restrict hist, uint32_t* restrict sum, uint32_t* restrict keys_in,
-    uint32_t* restrict keys_temp, uint32_t* restrict values_in, uint32_t* values_temp,
-    const uint32_t size)
-{
-    init_histograms_u32(kRadixBits, kHistBuckets, kHistSize, hist, keys_in, size);
-
-    sum_histograms(sum, kHistBuckets, kHistSize, hist);
 
-    // alternate input and output buffers on each radix pass
-    uint32_t* restrict keys[2] = {keys_in, keys_temp};
-    uint32_t* restrict values[2] = {values_in, values_temp};
+    small_sort_packed(items, size);
 
-    uint32_t out = 0;
-    const uint32_t kHistMask = kHistSize - 1;
-    for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+    for (uint32_t i = 0; i < size; ++i)
     {
-        const uint32_t in = bucket & 1;
-        out = !in;
-        uint32_t* restrict offset = hist + (bucket * kHistSize);
-        radixpass_u32(offset, bucket * kRadixBits, kHistMask, keys[in], keys[out], values[in],
-            values[out], size);
+        const uint32_t key = ((uint32_t)(items[i] >> 32) ^ invert) + bias;
+        keys_temp[i] = flip ? inv_float_flip(key) : key;
+        if (values_temp)
+        {
+            copy_value(values_temp, i, values_in, (uint32_t)items[i], value_size);
+        }
     }
-
-    return out;
+    return 1;
 }
 
 
-uint32_t radix8sort_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
-    uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size)
+static uint32_t small_sort_u64(const uint64_t* restrict keys_in, uint64_t* restrict keys_temp,
+    const void* restrict values_in, void* restrict values_temp, const size_t value_size, const uint32_t size,
+    const bool flip, const uint64_t bias, const bool descending)
 {
-    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
-    uint32_t sum[HIST_BUCKETS_32_8];
-    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, size);
-}
+    const uint64_t invert = descending ? UINT64_MAX : 0;
+    uint64_t keys[SMALL_SORT_THRESHOLD_11];
+    uint64_t indices[SMALL_SORT_THRESHOLD_11];
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys[i] = ((flip ? double_flip(keys_in[i]) : keys_in[i]) - bias) ^ invert;
+        indices[i] = i;
+    }
 
+    small_sort_pairs(keys, indices, size);
 
-uint32_t radix11sort_u32(uint32_t* restrict keys_in, uint32_t* restrict keys_out,
-    uint32_t* restrict values_in, uint32_t* restrict values_out, uint32_t size)
-{
-    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
-    uint32_t sum[HIST_BUCKETS_32_11];
-    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in, keys_out, values_in, values_out, size);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint64_t key = (keys[i] ^ invert) + bias;
+        keys_temp[i] = flip ? inv_double_flip(key) : key;
+        if (values_temp)
+        {
+            copy_value(values_temp, i, values_in, (uint32_t)indices[i], value_size);
+        }
+    }
+    return 1;
 }
 
 
-static inline uint32_t radixsort_u64(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize, uint32_t* restrict hist, uint32_t* restrict sum, uint64_t* restrict keys_in,
-    uint64_t* restrict keys_temp, uint32_t* restrict values_in, uint32_t* values_temp,
-    const uint32_t size)
+/**
+ * Order of the keys, found before building the histograms.
+ */
+enum key_order
 {
-    init_histograms_u64(kRadixBits, kHistBuckets, kHistSize, hist, keys_in, size);
-
-    sum_histograms(sum, kHistBuckets, kHistSize, hist);
+    KEY_ORDER_UNSORTED,
+    KEY_ORDER_ASCENDING,
+    KEY_ORDER_DESCENDING, // strictly descending
+};
 
-    // alternate input and output buffers on each radix pass
-    uint64_t* restrict keys[2] = {keys_in, keys_temp};
-    uint32_t* restrict values[2] = {values_in, values_temp};
 
-    uint32_t out = 0;
-    const uint32_t kHistMask = kHistSize - 1;
-    for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+/**
+ * Find whether keys are in ascending or strictly descending order, stopping
+ * at the first key which is in neither, which for unsorted keys is usually
+ * one of the first few. The first key is compared with itself, counting as
+ * ascending. This is kept out of the histogram loop, where tracking the order
+ * of every key costs more than this scan. Keys are compared relative to bias
+ * and inverted for descending sorts as in the small sort, so ascending keys
+ * are always in the order sorted.
+ */
+static enum key_order find_order_u32(const uint32_t* restrict keys_in, const uint32_t size, const bool flip,
+    const uint32_t bias, const bool descending)
+{
+    const uint32_t invert = descending ? UINT32_MAX : 0;
+    uint32_t prev_key = ((flip ? float_flip(keys_in[0]) : keys_in[0]) - bias) ^ invert;
+    uint32_t i = 1;
+    for (; i < size; ++i)
     {
-        const uint32_t in = bucket & 1;
-        out = !in;
-        uint32_t* restrict offset = hist + (bucket * kHistSize);
-        radixpass_u64(offset, bucket * kRadixBits, kHistMask, keys[in], keys[out], values[in],
-            values[out], size);
+        const uint32_t key = ((flip ? float_flip(keys_in[i]) : keys_in[i]) - bias) ^ invert;
+        if (key < prev_key)
+        {
+            break;
+        }
+        prev_key = key;
     }
-
-    return out;
+    if (i == size)
+    {
+        return KEY_ORDER_ASCENDING;
+    }
+    if (i > 1)
+    {
+        return KEY_ORDER_UNSORTED;
+    }
+    for (; i < size; ++i)
+    {
+        const uint32_t key = ((flip ? float_flip(keys_in[i]) : keys_in[i]) - bias) ^ invert;
+        if (key >= prev_key)
+        {
+            return KEY_ORDER_UNSORTED;
+        }
+        prev_key = key;
+    }
+    return KEY_ORDER_DESCENDING;
 }
 
 
-uint32_t radix8sort_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
-    uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size)
+static enum key_order find_order_u64(const uint64_t* restrict keys_in, const uint32_t size, const bool flip,
+    const uint64_t bias, const bool descending)
 {
-    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
-    uint32_t sum[HIST_BUCKETS_64_8];
-    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, size);
+    const uint64_t invert = descending ? UINT64_MAX : 0;
+    uint64_t prev_key = ((flip ? double_flip(keys_in[0]) : keys_in[0]) - bias) ^ invert;
+    uint32_t i = 1;
+    for (; i < size; ++i)
+    {
+        const uint64_t key = ((flip ? double_flip(keys_in[i]) : keys_in[i]) - bias) ^ invert;
+        if (key < prev_key)
+        {
+            break;
+        }
+        prev_key = key;
+    }
+    if (i == size)
+    {
+        return KEY_ORDER_ASCENDING;
+    }
+    if (i > 1)
+    {
+        return KEY_ORDER_UNSORTED;
+    }
+    for (; i < size; ++i)
+    {
+        const uint64_t key = ((flip ? double_flip(keys_in[i]) : keys_in[i]) - bias) ^ invert;
+        if (key >= prev_key)
+        {
+            return KEY_ORDER_UNSORTED;
+        }
+        prev_key = key;
+    }
+    return KEY_ORDER_DESCENDING;
 }
 
 
-uint32_t radix11sort_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
-    uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size)
+/**
+ * Find whether neighbouring keys relative to base, flipped if they are floats,
+ * often share a digit in the first kHistBuckets digits, sampling pairs spread
+ * over the keys.
+ */
+static bool repeats_digits_u32(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize,
+    const uint32_t* restrict keys_in, const uint32_t size, const uint32_t base, const bool flip)
 {
-    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
-    uint32_t sum[HIST_BUCKETS_64_11];
-    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, size);
+    const uint32_t kHistMask = kHistSize - 1;
+    uint32_t repeats = 0;
+    for (uint32_t sample = 0; sample < COUNT_SPLIT_SAMPLES; ++sample)
+    {
+        const uint32_t i = (uint32_t)(((uint64_t)(size - 1) * sample) / COUNT_SPLIT_SAMPLES);
+        const uint32_t key = (flip ? float_flip(keys_in[i]) : keys_in[i]) - base;
+        const uint32_t next_key = (flip ? float_flip(keys_in[i + 1]) : keys_in[i + 1]) - base;
+        bool repeat = false;
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        {
+            repeat = repeat || (((key ^ next_key) >> (bucket * kRadixBits)) & kHistMask) == 0;
+        }
+        repeats += repeat;
+    }
+    return repeats >= COUNT_SPLIT_REPEATS;
 }
 
 
-static inline uint32_t radixsort_f32(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize, uint32_t* restrict hist, uint32_t* restrict sum, float* keys_in_f32,
-    float* restrict keys_temp_f32, uint32_t* restrict values_in, uint32_t* values_temp,
-    const uint32_t size)
+static bool repeats_digits_u64(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize,
+    const uint64_t* restrict keys_in, const uint32_t size, const uint64_t base, const bool flip)
 {
-    // create uint32_t pointers to inputs to avoid float to int casting
-    uint32_t* restrict keys_in = (uint32_t*)keys_in_f32;
-    uint32_t* restrict keys_temp = (uint32_t*)keys_temp_f32;
-
-    init_histograms_f32(kRadixBits, kHistBuckets, kHistSize, hist, keys_in, size);
-
-    sum_histograms(sum, kHistBuckets, kHistSize, hist);
-
-    // alternate input and output buffers on each radix pass
-    uint32_t* restrict keys[2] = {keys_in, keys_temp};
-    uint32_t* restrict values[2] = {values_in, values_temp};
     const uint32_t kHistMask = kHistSize - 1;
-
-    uint32_t out;
-
+    uint32_t repeats = 0;
+    for (uint32_t sample = 0; sample < COUNT_SPLIT_SAMPLES; ++sample)
     {
-        const uint32_t bucket = 0;
-        const uint32_t in = bucket & 1;
-        out = !in;
-        uint32_t* restrict offset = hist + (bucket * kHistSize);
-        for (uint32_t i = 0; i < size; ++i)
+        const uint32_t i = (uint32_t)(((uint64_t)(size - 1) * sample) / COUNT_SPLIT_SAMPLES);
+        const uint64_t key = (flip ? double_flip(keys_in[i]) : keys_in[i]) - base;
+        const uint64_t next_key = (flip ? double_flip(keys_in[i + 1]) : keys_in[i + 1]) - base;
+        bool repeat = false;
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
         {
-            const uint32_t key = float_flip(keys[in][i]);
-            const uint32_t pos = key & kHistMask;
-            const uint32_t index = offset[pos]++;
-            keys[out][index] = key;
-            values[out][index] = values[in][i];
+            repeat = repeat || (((key ^ next_key) >> (bucket * kRadixBits)) & kHistMask) == 0;
         }
+        repeats += repeat;
     }
+    return repeats >= COUNT_SPLIT_REPEATS;
+}
 
-    for (uint32_t bucket = 1; bucket < kHistBuckets - 1; ++bucket)
-    {
-        const uint32_t in = bucket & 1;
-        out = !in;
-        uint32_t* restrict offset = hist + (bucket * kHistSize);
-        radixpass_u32(offset, bucket * kRadixBits, kHistMask, keys[in], keys[out], values[in],
-            values[out], size);
-    }
 
+/**
+ * Count the digits of each key relative to base, flipped if they are floats,
+ * into kHistBuckets histograms and find the range of the keys.
+ */
+static FORCE_INLINE void count_keys_u32(const uint32_t kRadixBits, const uint32_t kHistBuckets,
+    const uint32_t kHistSize, uint32_t* restrict hist, const uint32_t* restrict keys_in, const uint32_t size,
+    const uint32_t base, const bool flip, uint32_t* restrict min_key, uint32_t* restrict max_key)
+{
+    const uint32_t kHistMask = kHistSize - 1;
+    uint32_t key_min = (uint32_t)-1;
+    uint32_t key_max = 0;
+    for (uint32_t i = 0; i < size; ++i)
     {
-        const uint32_t bucket = kHistBuckets - 1;
-        const uint32_t shift = bucket * kRadixBits;
-        const uint32_t in = bucket & 1;
-        out = !in;
-        uint32_t* restrict offset = hist + (bucket * kHistSize);
-        for (uint32_t i = 0; i < size; ++i)
+        const uint32_t key = (flip ? float_flip(keys_in[i]) : keys_in[i]) - base;
+        key_min = key < key_min ? key : key_min;
+        key_max = key > key_max ? key : key_max;
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
         {
-            const uint32_t key = keys[in][i];
+            const uint32_t shift = bucket * kRadixBits;
             const uint32_t pos = (key >> shift) & kHistMask;
-            const uint32_t index = offset[pos]++;
-            keys[out][index] = inv_float_flip(key);
-            values[out][index] = values[in][i];
+            uint32_t* offset = hist + (bucket * kHistSize);
+            ++offset[pos];
         }
     }
-
-    return out;
+    *min_key = key_min;
+    *max_key = key_max;
 }
 
 
-uint32_t radix8sort_f32(float* restrict keys_in_out_f32, float* restrict keys_temp_f32,
-    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+/**
+ * As count_keys_u32, but even keys are counted into hist_even and odd keys
+ * into hist_odd.
+ */
+static void count_keys_split_u32(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize,
+    uint32_t* restrict hist_even, uint32_t* restrict hist_odd, const uint32_t* restrict keys_in, const uint32_t size,
+    const uint32_t base, const bool flip, uint32_t* restrict min_key, uint32_t* restrict max_key)
 {
-    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
-    uint32_t sum[HIST_BUCKETS_32_8];
-    return radixsort_f32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out_f32, keys_temp_f32, values_in_out, values_temp, size);
+    const uint32_t kHistMask = kHistSize - 1;
+    uint32_t key_min = (uint32_t)-1;
+    uint32_t key_max = 0;
+    uint32_t i = 0;
+    for (; i + 1 < size; i += 2)
+    {
+        const uint32_t key_even = (flip ? float_flip(keys_in[i]) : keys_in[i]) - base;
+        const uint32_t key_odd = (flip ? float_flip(keys_in[i + 1]) : keys_in[i + 1]) - base;
+        key_min = key_even < key_min ? key_even : key_min;
+        key_min = key_odd < key_min ? key_odd : key_min;
+        key_max = key_even > key_max ? key_even : key_max;
+        key_max = key_odd > key_max ? key_odd : key_max;
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        {
+            const uint32_t shift = bucket * kRadixBits;
+            ++hist_even[(bucket * kHistSize) + ((key_even >> shift) & kHistMask)];
+            ++hist_odd[(bucket * kHistSize) + ((key_odd >> shift) & kHistMask)];
+        }
+    }
+    if (i < size)
+    {
+        const uint32_t key = (flip ? float_flip(keys_in[i]) : keys_in[i]) - base;
+        key_min = key < key_min ? key : key_min;
+        key_max = key > key_max ? key : key_max;
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        {
+            const uint32_t shift = bucket * kRadixBits;
+            ++hist_even[(bucket * kHistSize) + ((key >> shift) & kHistMask)];
+        }
+    }
+    *min_key = key_min;
+    *max_key = key_max;
 }
 
 
-uint32_t radix11sort_f32(float* restrict keys_in_f32, float* restrict keys_out_f32,
-    uint32_t* restrict values_in, uint32_t* restrict values_out, uint32_t size)
+static FORCE_INLINE void count_keys_u64(const uint32_t kRadixBits, const uint32_t kHistBuckets,
+    const uint32_t kHistSize, uint32_t* restrict hist, const uint64_t* restrict keys_in, const uint32_t size,
+    const uint64_t base, const bool flip, uint64_t* restrict min_key, uint64_t* restrict max_key)
 {
+    const uint32_t kHistMask = kHistSize - 1;
+    uint64_t key_min = (uint64_t)-1;
+    uint64_t key_max = 0;
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint64_t key = (flip ? double_flip(keys_in[i]) : keys_in[i]) - base;
+        key_min = key < key_min ? key : key_min;
+        key_max = key > key_max ? key : key_max;
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        {
+            const uint32_t shift = bucket * kRadixBits;
+            const uint32_t pos = (key >> shift) & kHistMask;
+            uint32_t* offset = hist + (bucket * kHistSize);
+            ++offset[pos];
+        }
+    }
+    *min_key = key_min;
+    *max_key = key_max;
+}
+
+
+static void count_keys_split_u64(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize,
+    uint32_t* restrict hist_even, uint32_t* restrict hist_odd, const uint64_t* restrict keys_in, const uint32_t size,
+    const uint64_t base, const bool flip, uint64_t* restrict min_key, uint64_t* restrict max_key)
+{
+    const uint32_t kHistMask = kHistSize - 1;
+    uint64_t key_min = (uint64_t)-1;
+    uint64_t key_max = 0;
+    uint32_t i = 0;
+    for (; i + 1 < size; i += 2)
+    {
+        const uint64_t key_even = (flip ? double_flip(keys_in[i]) : keys_in[i]) - base;
+        const uint64_t key_odd = (flip ? double_flip(keys_in[i + 1]) : keys_in[i + 1]) - base;
+        key_min = key_even < key_min ? key_even : key_min;
+        key_min = key_odd < key_min ? key_odd : key_min;
+        key_max = key_even > key_max ? key_even : key_max;
+        key_max = key_odd > key_max ? key_odd : key_max;
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        {
+            const uint32_t shift = bucket * kRadixBits;
+            ++hist_even[(bucket * kHistSize) + ((key_even >> shift) & kHistMask)];
+            ++hist_odd[(bucket * kHistSize) + ((key_odd >> shift) & kHistMask)];
+        }
+    }
+    if (i < size)
+    {
+        const uint64_t key = (flip ? double_flip(keys_in[i]) : keys_in[i]) - base;
+        key_min = key < key_min ? key : key_min;
+        key_max = key > key_max ? key : key_max;
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        {
+            const uint32_t shift = bucket * kRadixBits;
+            ++hist_even[(bucket * kHistSize) + ((key >> shift) & kHistMask)];
+        }
+    }
+    *min_key = key_min;
+    *max_key = key_max;
+}
+
+
+/**
+ * Initialise each histogram bucket with the key value relative to the given
+ * base, flipped if the keys are floats, and find the range of the keys. Keys
+ * with runs of equal digits are counted into a second set of histograms for
+ * the odd keys, which is then merged.
+ */
+static void init_histograms_u32(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize,
+    uint32_t* restrict hist, const uint32_t* restrict keys_in, const uint32_t size, const uint32_t base,
+    const bool flip, uint32_t* restrict min_key, uint32_t* restrict max_key)
+{
+    memset(hist, 0, sizeof(uint32_t) * kHistBuckets * kHistSize);
+
+    uint32_t* hist_odd = NULL;
+    if (size >= COUNT_SPLIT_MIN_KEYS && repeats_digits_u32(kRadixBits, kHistBuckets, kHistSize, keys_in, size, base,
+        flip))
+    {
+        hist_odd = (uint32_t*)calloc(kHistBuckets * kHistSize, sizeof(uint32_t));
+    }
+    if (!hist_odd)
+    {
+        if (flip)
+        {
+            count_keys_u32(kRadixBits, kHistBuckets, kHistSize, hist, keys_in, size, base, true, min_key,
+                max_key);
+        }
+        else
+        {
+            count_keys_u32(kRadixBits, kHistBuckets, kHistSize, hist, keys_in, size, base, false, min_key,
+                max_key);
+        }
+        return;
+    }
+
+    count_keys_split_u32(kRadixBits, kHistBuckets, kHistSize, hist, hist_odd, keys_in, size, base, flip, min_key,
+        max_key);
+    for (uint32_t i = 0; i < kHistBuckets * kHistSize; ++i)
+    {
+        hist[i] += hist_odd[i];
+    }
+    free(hist_odd);
+}
+
+
+static void init_histograms_u64(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize,
+    uint32_t* restrict hist, const uint64_t* restrict keys_in, const uint32_t size, const uint64_t base,
+    const bool flip, uint64_t* restrict min_key, uint64_t* restrict max_key)
+{
+    memset(hist, 0, sizeof(uint32_t) * kHistBuckets * kHistSize);
+
+    uint32_t* hist_odd = NULL;
+    if (size >= COUNT_SPLIT_MIN_KEYS && repeats_digits_u64(kRadixBits, kHistBuckets, kHistSize, keys_in, size, base,
+        flip))
+    {
+        hist_odd = (uint32_t*)calloc(kHistBuckets * kHistSize, sizeof(uint32_t));
+    }
+    if (!hist_odd)
+    {
+        if (flip)
+        {
+            count_keys_u64(kRadixBits, kHistBuckets, kHistSize, hist, keys_in, size, base, true, min_key,
+                max_key);
+        }
+        else
+        {
+            count_keys_u64(kRadixBits, kHistBuckets, kHistSize, hist, keys_in, size, base, false, min_key,
+                max_key);
+        }
+        return;
+    }
+
+    count_keys_split_u64(kRadixBits, kHistBuckets, kHistSize, hist, hist_odd, keys_in, size, base, flip, min_key,
+        max_key);
+    for (uint32_t i = 0; i < kHistBuckets * kHistSize; ++i)
+    {
+        hist[i] += hist_odd[i];
+    }
+    free(hist_odd);
+}
+
+
+/**
+ * Find the radix passes which need to be performed. A pass can be skipped
+ * when every key shares the same digit, which is the case when the histogram
+ * entry for the first key's digit counts every key.
+ */
+static uint32_t plan_passes(uint32_t* restrict passes, const uint32_t kRadixBits, const uint32_t kHistBuckets,
+    const uint32_t kHistSize, const uint32_t* restrict hist, const uint64_t first_key, const uint32_t size)
+{
+    uint32_t num_passes = 0;
+    const uint32_t kHistMask = kHistSize - 1;
+    for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+    {
+        const uint32_t shift = bucket * kRadixBits;
+        const uint32_t pos = (first_key >> shift) & kHistMask;
+        if (hist[(bucket * kHistSize) + pos] != size)
+        {
+            passes[num_passes++] = bucket;
+        }
+    }
+    return num_passes;
+}
+
+
+/**
+ * Number of radix passes needed to sort keys relative to the minimum key,
+ * given the range between the minimum and maximum key.
+ */
+static inline uint32_t rebased_buckets(const uint32_t kRadixBits, uint64_t range)
+{
+    uint32_t range_bits = 0;
+    while (range != 0)
+    {
+        range >>= 1;
+        ++range_bits;
+    }
+    return (range_bits + kRadixBits - 1) / kRadixBits;
+}
+
+
+/**
+ * Update the histogram data so each entry sums the previous entries. For
+ * descending sorts each entry sums the following entries instead, so keys
+ * with higher digits are written first while keys sharing a digit still keep
+ * their order.
+ */
+static void sum_histograms(uint32_t* restrict sum, const uint32_t kHistBuckets, const uint32_t kHistSize,
+    uint32_t* restrict hist, const bool descending)
+{
+    const uint32_t first = descending ? kHistSize - 1 : 0;
+    for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+    {
+        uint32_t* restrict offset = hist + (bucket * kHistSize);
+        sum[bucket] = offset[first];
+        offset[first] = 0;
+    }
+
+    uint32_t tsum;
+    for (uint32_t n = 1; n < kHistSize; ++n)
+    {
+        const uint32_t i = descending ? kHistSize - 1 - n : n;
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        {
+            uint32_t* restrict offset = hist + (bucket * kHistSize);
+            tsum = offset[i] + sum[bucket];
+            offset[i] = sum[bucket];
+            sum[bucket] = tsum;
+        }
+    }
+}
+
+
+/**
+ * Perform a radix sort pass for the given bit shift and mask. Digits are taken
+ * from the key relative to the given base. Key only sorts pass null values,
+ * which are never read or written, the first pass of an argsort passes null
+ * input values to write each key's index instead, and its last pass may pass
+ * null output keys when only the permutation is wanted.
+ */
+static FORCE_INLINE void radixpass_u32(uint32_t* restrict hist, const uint32_t base, const uint32_t shift,
+    const uint32_t mask, const uint32_t* restrict keys_in, uint32_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint32_t key = keys_in[i];
+        const uint32_t pos = ((key - base) >> shift) & mask;
+        const uint32_t index = hist[pos]++;
+        if (keys_out)
+        {
+            keys_out[index] = key;
+        }
+        if (values_out)
+        {
+            copy_value(values_out, index, values_in, i, value_size);
+        }
+    }
+}
+
+
+static FORCE_INLINE void radixpass_u64(uint32_t* restrict hist, const uint64_t base, const uint32_t shift,
+    const uint32_t mask, const uint64_t* restrict keys_in, uint64_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint64_t key = keys_in[i];
+        const uint32_t pos = ((key - base) >> shift) & mask;
+        const uint32_t index = hist[pos]++;
+        if (keys_out)
+        {
+            keys_out[index] = key;
+        }
+        if (values_out)
+        {
+            copy_value(values_out, index, values_in, i, value_size);
+        }
+    }
+}
+
+
+/**
+ * Perform a float radix sort pass, flipping the key on the way in if this is
+ * the first pass and flipping it back on the way out if it is the last.
+ */
+static FORCE_INLINE void radixpass_f32(uint32_t* restrict hist, const uint32_t base, const uint32_t shift,
+    const uint32_t mask, const uint32_t* restrict keys_in, uint32_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size,
+    const int flip, const int unflip)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint32_t key = flip ? float_flip(keys_in[i]) : keys_in[i];
+        const uint32_t pos = ((key - base) >> shift) & mask;
+        const uint32_t index = hist[pos]++;
+        if (keys_out)
+        {
+            keys_out[index] = unflip ? inv_float_flip(key) : key;
+        }
+        if (values_out)
+        {
+            copy_value(values_out, index, values_in, i, value_size);
+        }
+    }
+}
+
+
+/**
+ * Perform a double radix sort pass, flipping the key as radixpass_f32.
+ */
+static FORCE_INLINE void radixpass_f64(uint32_t* restrict hist, const uint64_t base, const uint32_t shift,
+    const uint32_t mask, const uint64_t* restrict keys_in, uint64_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size,
+    const int flip, const int unflip)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint64_t key = flip ? double_flip(keys_in[i]) : keys_in[i];
+        const uint32_t pos = ((key - base) >> shift) & mask;
+        const uint32_t index = hist[pos]++;
+        if (keys_out)
+        {
+            keys_out[index] = unflip ? inv_double_flip(key) : key;
+        }
+        if (values_out)
+        {
+            copy_value(values_out, index, values_in, i, value_size);
+        }
+    }
+}
+
+
+/**
+ * Copy bytes using non-temporal stores, which bypass the cache, when the
+ * destination is suitably aligned, otherwise copy them normally.
+ */
+static inline void stream_copy(void* restrict dst, const void* restrict src, const size_t bytes)
+{
+#if defined(__SSE2__)
+    if (((uintptr_t)dst & 15) == 0 && (bytes & 15) == 0)
+    {
+        char* restrict dst_bytes = (char*)dst;
+        const char* restrict src_bytes = (const char*)src;
+        for (size_t i = 0; i < bytes; i += 16)
+        {
+            _mm_stream_si128((__m128i*)(dst_bytes + i), _mm_loadu_si128((const __m128i*)(src_bytes + i)));
+        }
+        return;
+    }
+#endif
+    memcpy(dst, src, bytes);
+}
+
+
+/**
+ * Order non-temporal stores before any following stores, so the data they
+ * wrote is visible once the sort returns.
+ */
+static inline void stream_fence(void)
+{
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+}
+
+
+/**
+ * Pick the scatter to use for an array of the given size, when the scatter
+ * mode is automatic. Values larger than 8 bytes are always scattered
+ * directly, as staging buffers for them would no longer fit in cache.
+ */
+static inline enum radixsort_scatter_mode resolve_scatter_mode(const uint32_t size, const size_t key_size,
+    const size_t value_size)
+{
+    if (value_size > sizeof(uint64_t))
+    {
+        return RADIXSORT_SCATTER_DIRECT;
+    }
+    if (radixsort_scatter_mode_setting != RADIXSORT_SCATTER_AUTO)
+    {
+        return radixsort_scatter_mode_setting;
+    }
+    const uint64_t bytes = (uint64_t)size * (key_size + value_size);
+    return bytes >= SCATTER_STREAMING_BYTES ? RADIXSORT_SCATTER_STREAMING : RADIXSORT_SCATTER_DIRECT;
+}
+
+
+/**
+ * The staging buffers of the scatters, either the line buffers of the
+ * buffered and streaming scatters, a cache line of keys and their values per
+ * digit, or the block of keys, values and digits of the block scatter, which
+ * holds as many keys. They take hundreds of KB, too much for the stack of a
+ * sort or of the threads of the parallel sorts, so they are allocated once per
+ * sort, or per thread by the parallel sorts.
+ */
+struct scatter_buffers
+{
+    enum radixsort_scatter_mode scatter_mode;
+    void* keys;
+    void* values;
+    uint16_t* digits;
+};
+
+
+/**
+ * Allocate the buffers the scatter mode needs for hist_size digits and values
+ * of value_size bytes, falling back to the direct scatter if they can't be
+ * allocated.
+ */
+static void scatter_buffers_init(struct scatter_buffers* restrict buffers,
+    const enum radixsort_scatter_mode scatter_mode, const uint32_t hist_size, const size_t key_size,
+    const size_t value_size)
+{
+    buffers->scatter_mode = scatter_mode;
+    buffers->keys = NULL;
+    buffers->values = NULL;
+    buffers->digits = NULL;
+    if (scatter_mode == RADIXSORT_SCATTER_DIRECT)
+    {
+        return;
+    }
+    /* staged values are value_size bytes apart, and only the block scatter
+     * stages digits */
+    const size_t num_keys = (size_t)hist_size * (SCATTER_LINE_BYTES / key_size);
+    const size_t key_bytes = num_keys * key_size;
+    const size_t value_bytes = num_keys * value_size;
+    const size_t digit_bytes = scatter_mode == RADIXSORT_SCATTER_BLOCK ? num_keys * sizeof(uint16_t) : 0;
+    char* buffer = (char*)malloc(key_bytes + value_bytes + digit_bytes);
+    if (!buffer)
+    {
+        buffers->scatter_mode = RADIXSORT_SCATTER_DIRECT;
+        return;
+    }
+    buffers->keys = buffer;
+    buffers->values = buffer + key_bytes;
+    buffers->digits = scatter_mode == RADIXSORT_SCATTER_BLOCK ? (uint16_t*)(buffer + key_bytes + value_bytes) : NULL;
+}
+
+
+static void scatter_buffers_free(struct scatter_buffers* restrict buffers)
+{
+    free(buffers->keys);
+}
+
+
+/**
+ * Write the given number of staged keys and values ending at the line slot for
+ * index, streaming whole lines if requested.
+ */
+static FORCE_INLINE void flush_line_u32(uint32_t* restrict keys_out, void* restrict values_out,
+    const uint32_t* restrict key_line, const void* restrict value_line, const size_t value_size, const uint32_t index,
+    const uint32_t slot, const uint32_t count, const int streaming)
+{
+    const uint32_t first = index + 1 - count;
+    const uint32_t first_slot = slot + 1 - count;
+    if (streaming && count == SCATTER_LINE_KEYS_32)
+    {
+        if (keys_out)
+        {
+            stream_copy(keys_out + first, key_line + first_slot, sizeof(uint32_t) * count);
+        }
+        if (values_out)
+        {
+            stream_copy((char*)values_out + (size_t)first * value_size,
+                (const char*)value_line + (size_t)first_slot * value_size, value_size * count);
+        }
+    }
+    else
+    {
+        if (keys_out)
+        {
+            memcpy(keys_out + first, key_line + first_slot, sizeof(uint32_t) * count);
+        }
+        if (values_out)
+        {
+            memcpy((char*)values_out + (size_t)first * value_size,
+                (const char*)value_line + (size_t)first_slot * value_size, value_size * count);
+        }
+    }
+}
+
+
+static FORCE_INLINE void flush_line_u64(uint64_t* restrict keys_out, void* restrict values_out,
+    const uint64_t* restrict key_line, const void* restrict value_line, const size_t value_size, const uint32_t index,
+    const uint32_t slot, const uint32_t count, const int streaming)
+{
+    const uint32_t first = index + 1 - count;
+    const uint32_t first_slot = slot + 1 - count;
+    if (streaming && count == SCATTER_LINE_KEYS_64)
+    {
+        if (keys_out)
+        {
+            stream_copy(keys_out + first, key_line + first_slot, sizeof(uint64_t) * count);
+        }
+        if (values_out)
+        {
+            stream_copy((char*)values_out + (size_t)first * value_size,
+                (const char*)value_line + (size_t)first_slot * value_size, value_size * count);
+        }
+    }
+    else
+    {
+        if (keys_out)
+        {
+            memcpy(keys_out + first, key_line + first_slot, sizeof(uint64_t) * count);
+        }
+        if (values_out)
+        {
+            memcpy((char*)values_out + (size_t)first * value_size,
+                (const char*)value_line + (size_t)first_slot * value_size, value_size * count);
+        }
+    }
+}
+
+
+/**
+ * Perform a radix sort pass like radixpass_f32, but stage keys and values in a
+ * buffer per digit and write them a cache line of keys at a time. Slots line
+ * up with cache lines of the output keys, and lines are never written before
+ * the first index of their digit in this pass.
+ */
+static FORCE_INLINE void radixpass_buffered_sized_u32(uint32_t* restrict hist, const uint32_t base, const uint32_t shift,
+    const uint32_t mask, const uint32_t* restrict keys_in, uint32_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size,
+    const int flip, const int unflip, const int streaming,
+    uint32_t (*restrict key_lines)[SCATTER_LINE_KEYS_32], char* restrict value_lines)
+{
+    const uint32_t kSlotMask = SCATTER_LINE_KEYS_32 - 1;
+    const size_t kValueLineBytes = SCATTER_LINE_KEYS_32 * value_size;
+    uint32_t begin[HIST_SIZE_11];
+    memcpy(begin, hist, sizeof(uint32_t) * (mask + 1));
+    /* when keys aren't written the lines follow the output values instead */
+    const uint32_t align = keys_out ? (uint32_t)((uintptr_t)keys_out / sizeof(uint32_t)) :
+        (uint32_t)((uintptr_t)values_out / sizeof(uint32_t));
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint32_t key = flip ? float_flip(keys_in[i]) : keys_in[i];
+        const uint32_t pos = ((key - base) >> shift) & mask;
+        const uint32_t index = hist[pos]++;
+        const uint32_t slot = (index + align) & kSlotMask;
+        key_lines[pos][slot] = unflip ? inv_float_flip(key) : key;
+        if (values_out)
+        {
+            copy_value(value_lines + pos * kValueLineBytes, slot, values_in, i, value_size);
+        }
+        if (slot == kSlotMask)
+        {
+            const uint32_t staged = index - begin[pos] + 1;
+            flush_line_u32(keys_out, values_out, key_lines[pos], value_lines + pos * kValueLineBytes, value_size, index, slot,
+                staged < slot + 1 ? staged : slot + 1, streaming);
+        }
+    }
+
+    // write the lines which weren't filled
+    for (uint32_t pos = 0; pos <= mask; ++pos)
+    {
+        if (hist[pos] == begin[pos])
+        {
+            continue;
+        }
+        const uint32_t index = hist[pos] - 1;
+        const uint32_t slot = (index + align) & kSlotMask;
+        if (slot != kSlotMask)
+        {
+            const uint32_t staged = index - begin[pos] + 1;
+            flush_line_u32(keys_out, values_out, key_lines[pos], value_lines + pos * kValueLineBytes, value_size, index, slot,
+                staged < slot + 1 ? staged : slot + 1, 0);
+        }
+    }
+
+    if (streaming)
+    {
+        stream_fence();
+    }
+}
+
+
+/**
+ * Perform a buffered radix pass with the copy of radixpass_buffered_sized_u32
+ * or _u64 for the value size, which all share the line buffers.
+ */
+static void radixpass_buffered_u32(uint32_t* restrict hist, const uint32_t base, const uint32_t shift,
+    const uint32_t mask, const uint32_t* restrict keys_in, uint32_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size,
+    const int flip, const int unflip, const int streaming, const struct scatter_buffers* restrict buffers)
+{
+    uint32_t (*restrict key_lines)[SCATTER_LINE_KEYS_32] = (uint32_t (*)[SCATTER_LINE_KEYS_32])buffers->keys;
+    char* restrict value_lines = (char*)buffers->values;
+    DISPATCH_VALUE_SIZE(value_size, radixpass_buffered_sized_u32(hist, base, shift, mask, keys_in, keys_out,
+        values_in, values_out, kValueSize, size, flip, unflip, streaming, key_lines, value_lines));
+}
+
+
+static FORCE_INLINE void radixpass_buffered_sized_u64(uint32_t* restrict hist, const uint64_t base, const uint32_t shift,
+    const uint32_t mask, const uint64_t* restrict keys_in, uint64_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size,
+    const int flip, const int unflip, const int streaming,
+    uint64_t (*restrict key_lines)[SCATTER_LINE_KEYS_64], char* restrict value_lines)
+{
+    const uint32_t kSlotMask = SCATTER_LINE_KEYS_64 - 1;
+    const size_t kValueLineBytes = SCATTER_LINE_KEYS_64 * value_size;
+    uint32_t begin[HIST_SIZE_11];
+    memcpy(begin, hist, sizeof(uint32_t) * (mask + 1));
+    /* when keys aren't written the lines follow the output values instead */
+    const uint32_t align = keys_out ? (uint32_t)((uintptr_t)keys_out / sizeof(uint64_t)) :
+        (uint32_t)((uintptr_t)values_out / sizeof(uint32_t));
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint64_t key = flip ? double_flip(keys_in[i]) : keys_in[i];
+        const uint32_t pos = ((key - base) >> shift) & mask;
+        const uint32_t index = hist[pos]++;
+        const uint32_t slot = (index + align) & kSlotMask;
+        key_lines[pos][slot] = unflip ? inv_double_flip(key) : key;
+        if (values_out)
+        {
+            copy_value(value_lines + pos * kValueLineBytes, slot, values_in, i, value_size);
+        }
+        if (slot == kSlotMask)
+        {
+            const uint32_t staged = index - begin[pos] + 1;
+            flush_line_u64(keys_out, values_out, key_lines[pos], value_lines + pos * kValueLineBytes, value_size, index, slot,
+                staged < slot + 1 ? staged : slot + 1, streaming);
+        }
+    }
+
+    // write the lines which weren't filled
+    for (uint32_t pos = 0; pos <= mask; ++pos)
+    {
+        if (hist[pos] == begin[pos])
+        {
+            continue;
+        }
+        const uint32_t index = hist[pos] - 1;
+        const uint32_t slot = (index + align) & kSlotMask;
+        if (slot != kSlotMask)
+        {
+            const uint32_t staged = index - begin[pos] + 1;
+            flush_line_u64(keys_out, values_out, key_lines[pos], value_lines + pos * kValueLineBytes, value_size, index, slot,
+                staged < slot + 1 ? staged : slot + 1, 0);
+        }
+    }
+
+    if (streaming)
+    {
+        stream_fence();
+    }
+}
+
+
+static void radixpass_buffered_u64(uint32_t* restrict hist, const uint64_t base, const uint32_t shift,
+    const uint32_t mask, const uint64_t* restrict keys_in, uint64_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size,
+    const int flip, const int unflip, const int streaming, const struct scatter_buffers* restrict buffers)
+{
+    uint64_t (*restrict key_lines)[SCATTER_LINE_KEYS_64] = (uint64_t (*)[SCATTER_LINE_KEYS_64])buffers->keys;
+    char* restrict value_lines = (char*)buffers->values;
+    DISPATCH_VALUE_SIZE(value_size, radixpass_buffered_sized_u64(hist, base, shift, mask, keys_in, keys_out,
+        values_in, values_out, kValueSize, size, flip, unflip, streaming, key_lines, value_lines));
+}
+
+
+/**
+ * Perform a radix sort pass like radixpass_f32, but partition each block of
+ * keys and values by digit in a buffer first, so every digit of the block is
+ * written to the output as one contiguous run.
+ */
+static FORCE_INLINE void radixpass_block_sized_u32(uint32_t* restrict hist, const uint32_t base, const uint32_t shift,
+    const uint32_t mask, const uint32_t* restrict keys_in, uint32_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size,
+    const int flip, const int unflip,
+    uint32_t* restrict block_keys, void* restrict block_values, uint16_t* restrict block_digits)
+{
+    const uint32_t kBlockKeys = (mask + 1) * SCATTER_LINE_KEYS_32;
+    uint32_t block_hist[HIST_SIZE_11];
+
+    for (uint32_t begin = 0; begin < size; begin += kBlockKeys)
+    {
+        const uint32_t block_size = size - begin < kBlockKeys ? size - begin : kBlockKeys;
+        const uint32_t* restrict block_keys_in = keys_in + begin;
+
+        memset(block_hist, 0, sizeof(uint32_t) * (mask + 1));
+        for (uint32_t i = 0; i < block_size; ++i)
+        {
+            const uint32_t key = flip ? float_flip(block_keys_in[i]) : block_keys_in[i];
+            const uint32_t pos = ((key - base) >> shift) & mask;
+            block_digits[i] = (uint16_t)pos;
+            ++block_hist[pos];
+        }
+
+        uint32_t sum = 0;
+        for (uint32_t pos = 0; pos <= mask; ++pos)
+        {
+            const uint32_t count = block_hist[pos];
+            block_hist[pos] = sum;
+            sum += count;
+        }
+
+        for (uint32_t i = 0; i < block_size; ++i)
+        {
+            const uint32_t index = block_hist[block_digits[i]]++;
+            const uint32_t key = block_keys_in[i];
+            block_keys[index] = flip == unflip ? key : (flip ? float_flip(key) : inv_float_flip(key));
+            if (values_out)
+            {
+                copy_value(block_values, index, values_in, begin + i, value_size);
+            }
+        }
+
+        /* block_hist now holds the end of each digit's run in the block */
+        uint32_t first = 0;
+        for (uint32_t pos = 0; pos <= mask; ++pos)
+        {
+            const uint32_t count = block_hist[pos] - first;
+            if (count != 0)
+            {
+                const uint32_t index = hist[pos];
+                if (keys_out)
+                {
+                    memcpy(keys_out + index, block_keys + first, sizeof(uint32_t) * count);
+                }
+                if (values_out)
+                {
+                    memcpy((char*)values_out + (size_t)index * value_size,
+                        (const char*)block_values + (size_t)first * value_size, value_size * count);
+                }
+                hist[pos] = index + count;
+            }
+            first = block_hist[pos];
+        }
+    }
+}
+
+
+/**
+ * Perform a block radix pass with the copy of radixpass_block_sized_u32 or
+ * _u64 for the value size, which all share the block buffers.
+ */
+static void radixpass_block_u32(uint32_t* restrict hist, const uint32_t base, const uint32_t shift,
+    const uint32_t mask, const uint32_t* restrict keys_in, uint32_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size,
+    const int flip, const int unflip, const struct scatter_buffers* restrict buffers)
+{
+    DISPATCH_VALUE_SIZE(value_size, radixpass_block_sized_u32(hist, base, shift, mask, keys_in, keys_out,
+        values_in, values_out, kValueSize, size, flip, unflip, (uint32_t*)buffers->keys, buffers->values,
+        buffers->digits));
+}
+
+
+static FORCE_INLINE void radixpass_block_sized_u64(uint32_t* restrict hist, const uint64_t base, const uint32_t shift,
+    const uint32_t mask, const uint64_t* restrict keys_in, uint64_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size,
+    const int flip, const int unflip,
+    uint64_t* restrict block_keys, void* restrict block_values, uint16_t* restrict block_digits)
+{
+    const uint32_t kBlockKeys = (mask + 1) * SCATTER_LINE_KEYS_64;
+    uint32_t block_hist[HIST_SIZE_11];
+
+    for (uint32_t begin = 0; begin < size; begin += kBlockKeys)
+    {
+        const uint32_t block_size = size - begin < kBlockKeys ? size - begin : kBlockKeys;
+        const uint64_t* restrict block_keys_in = keys_in + begin;
+
+        memset(block_hist, 0, sizeof(uint32_t) * (mask + 1));
+        for (uint32_t i = 0; i < block_size; ++i)
+        {
+            const uint64_t key = flip ? double_flip(block_keys_in[i]) : block_keys_in[i];
+            const uint32_t pos = ((key - base) >> shift) & mask;
+            block_digits[i] = (uint16_t)pos;
+            ++block_hist[pos];
+        }
+
+        uint32_t sum = 0;
+        for (uint32_t pos = 0; pos <= mask; ++pos)
+        {
+            const uint32_t count = block_hist[pos];
+            block_hist[pos] = sum;
+            sum += count;
+        }
+
+        for (uint32_t i = 0; i < block_size; ++i)
+        {
+            const uint32_t index = block_hist[block_digits[i]]++;
+            const uint64_t key = block_keys_in[i];
+            block_keys[index] = flip == unflip ? key : (flip ? double_flip(key) : inv_double_flip(key));
+            if (values_out)
+            {
+                copy_value(block_values, index, values_in, begin + i, value_size);
+            }
+        }
+
+        /* block_hist now holds the end of each digit's run in the block */
+        uint32_t first = 0;
+        for (uint32_t pos = 0; pos <= mask; ++pos)
+        {
+            const uint32_t count = block_hist[pos] - first;
+            if (count != 0)
+            {
+                const uint32_t index = hist[pos];
+                if (keys_out)
+                {
+                    memcpy(keys_out + index, block_keys + first, sizeof(uint64_t) * count);
+                }
+                if (values_out)
+                {
+                    memcpy((char*)values_out + (size_t)index * value_size,
+                        (const char*)block_values + (size_t)first * value_size, value_size * count);
+                }
+                hist[pos] = index + count;
+            }
+            first = block_hist[pos];
+        }
+    }
+}
+
+
+static void radixpass_block_u64(uint32_t* restrict hist, const uint64_t base, const uint32_t shift,
+    const uint32_t mask, const uint64_t* restrict keys_in, uint64_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size,
+    const int flip, const int unflip, const struct scatter_buffers* restrict buffers)
+{
+    DISPATCH_VALUE_SIZE(value_size, radixpass_block_sized_u64(hist, base, shift, mask, keys_in, keys_out,
+        values_in, values_out, kValueSize, size, flip, unflip, (uint64_t*)buffers->keys, buffers->values,
+        buffers->digits));
+}
+
+
+/**
+ * Perform a radix sort pass of 32 bit or float keys, or 64 bit or double keys,
+ * with the scatter mode of the buffers, which must not be automatic.
+ */
+static inline void scatter_pass_u32(const struct scatter_buffers* restrict buffers, uint32_t* restrict hist,
+    const uint32_t base, const uint32_t shift, const uint32_t mask, const uint32_t* restrict keys_in,
+    uint32_t* restrict keys_out, const void* restrict values_in, void* restrict values_out,
+    const size_t value_size, const uint32_t size, const int flip, const int unflip)
+{
+    if (buffers->scatter_mode == RADIXSORT_SCATTER_DIRECT)
+    {
+        if (flip || unflip)
+        {
+            DISPATCH_VALUE_SIZE(value_size, radixpass_f32(hist, base, shift, mask, keys_in, keys_out, values_in,
+                values_out, kValueSize, size, flip, unflip));
+        }
+        else
+        {
+            DISPATCH_VALUE_SIZE(value_size, radixpass_u32(hist, base, shift, mask, keys_in, keys_out, values_in,
+                values_out, kValueSize, size));
+        }
+    }
+    else if (buffers->scatter_mode == RADIXSORT_SCATTER_BLOCK)
+    {
+        radixpass_block_u32(hist, base, shift, mask, keys_in, keys_out, values_in, values_out, value_size, size, flip,
+            unflip, buffers);
+    }
+    else
+    {
+        radixpass_buffered_u32(hist, base, shift, mask, keys_in, keys_out, values_in, values_out, value_size, size, flip,
+            unflip, buffers->scatter_mode == RADIXSORT_SCATTER_STREAMING, buffers);
+    }
+}
+
+
+static inline void scatter_pass_u64(const struct scatter_buffers* restrict buffers, uint32_t* restrict hist,
+    const uint64_t base, const uint32_t shift, const uint32_t mask, const uint64_t* restrict keys_in,
+    uint64_t* restrict keys_out, const void* restrict values_in, void* restrict values_out,
+    const size_t value_size, const uint32_t size, const int flip, const int unflip)
+{
+    if (buffers->scatter_mode == RADIXSORT_SCATTER_DIRECT)
+    {
+        if (flip || unflip)
+        {
+            DISPATCH_VALUE_SIZE(value_size, radixpass_f64(hist, base, shift, mask, keys_in, keys_out, values_in,
+                values_out, kValueSize, size, flip, unflip));
+        }
+        else
+        {
+            DISPATCH_VALUE_SIZE(value_size, radixpass_u64(hist, base, shift, mask, keys_in, keys_out, values_in,
+                values_out, kValueSize, size));
+        }
+    }
+    else if (buffers->scatter_mode == RADIXSORT_SCATTER_BLOCK)
+    {
+        radixpass_block_u64(hist, base, shift, mask, keys_in, keys_out, values_in, values_out, value_size, size, flip,
+            unflip, buffers);
+    }
+    else
+    {
+        radixpass_buffered_u64(hist, base, shift, mask, keys_in, keys_out, values_in, values_out, value_size, size, flip,
+            unflip, buffers->scatter_mode == RADIXSORT_SCATTER_STREAMING, buffers);
+    }
+}
+
+
+/**
+ * Write the index of each key as its value, for argsorts of keys which are
+ * already sorted.
+ */
+static inline void fill_indices(uint32_t* restrict indices, const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        indices[i] = i;
+    }
+}
+
+
+/**
+ * Copy keys and values in reverse order, or write each key's index when
+ * values_in is null.
+ */
+static inline void reverse_copy_u32(const uint32_t* restrict keys_in, uint32_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys_out[i] = keys_in[size - 1 - i];
+        if (values_out)
+        {
+            copy_value(values_out, i, values_in, size - 1 - i, value_size);
+        }
+    }
+}
+
+
+static inline void reverse_copy_u64(const uint64_t* restrict keys_in, uint64_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys_out[i] = keys_in[size - 1 - i];
+        if (values_out)
+        {
+            copy_value(values_out, i, values_in, size - 1 - i, value_size);
+        }
+    }
+}
+
+
+/**
+ * Radix sort keys relative to bias, so every digit is taken from the key minus
+ * bias. Unsigned keys have a bias of 0, and signed keys the sign bit, which
+ * orders them as the sign flip would without writing flipped keys. Descending
+ * sorts reverse the histogram offsets rather than the keys, so they cost the
+ * same as ascending sorts. Argsorts write each key's index as its value
+ * without reading values_in, and only write the keys of the last pass if
+ * sort_keys is set.
+ */
+static inline uint32_t radixsort_u32(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize, uint32_t* restrict hist, uint32_t* restrict sum, uint32_t* restrict keys_in,
+    uint32_t* restrict keys_temp, void* restrict values_in, void* values_temp, const size_t value_size,
+    const uint32_t size, const uint32_t bias, const bool descending, const bool argsort, const bool sort_keys)
+{
+    if (size <= 1)
+    {
+        if (argsort)
+        {
+            fill_indices(values_in, size);
+        }
+        return 0;
+    }
+
+    if (size <= (kRadixBits > RADIX_BITS_8 ? SMALL_SORT_THRESHOLD_11 : SMALL_SORT_THRESHOLD_8))
+    {
+        return small_sort_u32(keys_in, keys_temp, argsort ? NULL : values_in, values_temp, value_size, size, false, bias, descending);
+    }
+
+    // already sorted keys are left where they are and strictly descending keys
+    // only need reversing
+    const enum key_order order = find_order_u32(keys_in, size, false, bias, descending);
+    if (order == KEY_ORDER_ASCENDING)
+    {
+        if (argsort)
+        {
+            fill_indices(values_in, size);
+        }
+        return 0;
+    }
+    if (order == KEY_ORDER_DESCENDING)
+    {
+        reverse_copy_u32(keys_in, keys_temp, argsort ? NULL : values_in, values_temp, value_size, size);
+        return 1;
+    }
+
+    uint32_t min_key, max_key;
+    init_histograms_u32(kRadixBits, kHistBuckets, kHistSize, hist, keys_in, size, bias, false, &min_key, &max_key);
+
+    // skip passes where all keys have the same digit
+    uint32_t passes[HIST_BUCKETS_64_8];
+    uint32_t num_passes = plan_passes(passes, kRadixBits, kHistBuckets, kHistSize, hist, keys_in[0] - bias, size);
+
+    // if the keys span a narrow range which straddles digit boundaries it
+    // takes fewer passes to sort on the key relative to the minimum key, in
+    // which case build the histograms again for the rebased digits
+    uint32_t base = bias;
+    const uint32_t num_rebased = rebased_buckets(kRadixBits, max_key - min_key);
+    if (num_rebased < num_passes)
+    {
+        base = bias + min_key;
+        init_histograms_u32(kRadixBits, num_rebased, kHistSize, hist, keys_in, size, base, false, &min_key,
+            &max_key);
+        num_passes = plan_passes(passes, kRadixBits, num_rebased, kHistSize, hist, keys_in[0] - base, size);
+    }
+
+    sum_histograms(sum, kHistBuckets, kHistSize, hist, descending);
+
+    // alternate input and output buffers on each radix pass
+    uint32_t* restrict keys[2] = {keys_in, keys_temp};
+    void* restrict values[2] = {values_in, values_temp};
+
+    uint32_t out = 0;
+    const uint32_t kHistMask = kHistSize - 1;
+    struct scatter_buffers buffers;
+    scatter_buffers_init(&buffers, resolve_scatter_mode(size, sizeof(uint32_t), value_size), kHistSize,
+        sizeof(uint32_t), value_size);
+    for (uint32_t pass = 0; pass < num_passes; ++pass)
+    {
+        const uint32_t in = out;
+        out = !in;
+        uint32_t* restrict offset = hist + (passes[pass] * kHistSize);
+        // argsorts make indices on the first pass, and may leave the keys of
+        // the last pass unwritten
+        const void* restrict pass_values_in = argsort && pass == 0 ? NULL : values[in];
+        uint32_t* restrict pass_keys_out = sort_keys || pass != num_passes - 1 ? keys[out] : NULL;
+        scatter_pass_u32(&buffers, offset, base, passes[pass] * kRadixBits, kHistMask, keys[in], pass_keys_out,
+            pass_values_in, values[out], value_size, size, 0, 0);
+    }
+
+    scatter_buffers_free(&buffers);
+    return out;
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_u32)(uint32_t* restrict keys_in, uint32_t* restrict keys_out,
+    uint32_t* restrict values_in, uint32_t* restrict values_out, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in, keys_out, values_in, values_out, sizeof(uint32_t), size, 0, false, false, true);
+}
+
+
+/**
+ * Radix sort keys relative to bias, so every digit is taken from the key minus
+ * bias. Unsigned keys have a bias of 0, and signed keys the sign bit, which
+ * orders them as the sign flip would without writing flipped keys. Descending
+ * sorts reverse the histogram offsets rather than the keys, so they cost the
+ * same as ascending sorts. Argsorts write each key's index as its value
+ * without reading values_in, and only write the keys of the last pass if
+ * sort_keys is set.
+ */
+static inline uint32_t radixsort_u64(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize, uint32_t* restrict hist, uint32_t* restrict sum, uint64_t* restrict keys_in,
+    uint64_t* restrict keys_temp, void* restrict values_in, void* values_temp, const size_t value_size,
+    const uint32_t size, const uint64_t bias, const bool descending, const bool argsort, const bool sort_keys)
+{
+    if (size <= 1)
+    {
+        if (argsort)
+        {
+            fill_indices(values_in, size);
+        }
+        return 0;
+    }
+
+    if (size <= (kRadixBits > RADIX_BITS_8 ? SMALL_SORT_THRESHOLD_11 : SMALL_SORT_THRESHOLD_8))
+    {
+        return small_sort_u64(keys_in, keys_temp, argsort ? NULL : values_in, values_temp, value_size, size, false, bias, descending);
+    }
+
+    // already sorted keys are left where they are and strictly descending keys
+    // only need reversing
+    const enum key_order order = find_order_u64(keys_in, size, false, bias, descending);
+    if (order == KEY_ORDER_ASCENDING)
+    {
+        if (argsort)
+        {
+            fill_indices(values_in, size);
+        }
+        return 0;
+    }
+    if (order == KEY_ORDER_DESCENDING)
+    {
+        reverse_copy_u64(keys_in, keys_temp, argsort ? NULL : values_in, values_temp, value_size, size);
+        return 1;
+    }
+
+    uint64_t min_key, max_key;
+    init_histograms_u64(kRadixBits, kHistBuckets, kHistSize, hist, keys_in, size, bias, false, &min_key, &max_key);
+
+    // skip passes where all keys have the same digit
+    uint32_t passes[HIST_BUCKETS_64_8];
+    uint32_t num_passes = plan_passes(passes, kRadixBits, kHistBuckets, kHistSize, hist, keys_in[0] - bias, size);
+
+    // if the keys span a narrow range which straddles digit boundaries it
+    // takes fewer passes to sort on the key relative to the minimum key, in
+    // which case build the histograms again for the rebased digits
+    uint64_t base = bias;
+    const uint32_t num_rebased = rebased_buckets(kRadixBits, max_key - min_key);
+    if (num_rebased < num_passes)
+    {
+        base = bias + min_key;
+        init_histograms_u64(kRadixBits, num_rebased, kHistSize, hist, keys_in, size, base, false, &min_key,
+            &max_key);
+        num_passes = plan_passes(passes, kRadixBits, num_rebased, kHistSize, hist, keys_in[0] - base, size);
+    }
+
+    sum_histograms(sum, kHistBuckets, kHistSize, hist, descending);
+
+    // alternate input and output buffers on each radix pass
+    uint64_t* restrict keys[2] = {keys_in, keys_temp};
+    void* restrict values[2] = {values_in, values_temp};
+
+    uint32_t out = 0;
+    const uint32_t kHistMask = kHistSize - 1;
+    struct scatter_buffers buffers;
+    scatter_buffers_init(&buffers, resolve_scatter_mode(size, sizeof(uint64_t), value_size), kHistSize,
+        sizeof(uint64_t), value_size);
+    for (uint32_t pass = 0; pass < num_passes; ++pass)
+    {
+        const uint32_t in = out;
+        out = !in;
+        uint32_t* restrict offset = hist + (passes[pass] * kHistSize);
+        // argsorts make indices on the first pass, and may leave the keys of
+        // the last pass unwritten
+        const void* restrict pass_values_in = argsort && pass == 0 ? NULL : values[in];
+        uint64_t* restrict pass_keys_out = sort_keys || pass != num_passes - 1 ? keys[out] : NULL;
+        scatter_pass_u64(&buffers, offset, base, passes[pass] * kRadixBits, kHistMask, keys[in], pass_keys_out,
+            pass_values_in, values[out], value_size, size, 0, 0);
+    }
+
+    scatter_buffers_free(&buffers);
+    return out;
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, UINT32_C(0x80000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, UINT32_C(0x80000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, UINT64_C(0x8000000000000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, UINT64_C(0x8000000000000000), false, false, true);
+}
+
+
+/**
+ * Sort small arrays of 8 or 16 bit keys relative to bias with the sorting
+ * network, as small_sort_u32.
+ */
+static uint32_t small_sort_u8(const uint8_t* restrict keys_in, uint8_t* restrict keys_temp,
+    const uint32_t* restrict values_in, uint32_t* restrict values_temp, const uint32_t size, const uint8_t bias)
+{
+    uint64_t items[SMALL_SORT_THRESHOLD_8];
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        items[i] = ((uint64_t)(uint8_t)(keys_in[i] - bias) << 32) | i;
+    }
+
+    small_sort_packed(items, size);
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys_temp[i] = (uint8_t)((items[i] >> 32) + bias);
+        values_temp[i] = values_in[(uint32_t)items[i]];
+    }
+    return 1;
+}
+
+
+static uint32_t small_sort_u16(const uint16_t* restrict keys_in, uint16_t* restrict keys_temp,
+    const uint32_t* restrict values_in, uint32_t* restrict values_temp, const uint32_t size, const bool flip,
+    const uint16_t bias)
+{
+    uint64_t items[SMALL_SORT_THRESHOLD_8];
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        items[i] = ((uint64_t)(uint16_t)((flip ? half_flip(keys_in[i]) : keys_in[i]) - bias) << 32) | i;
+    }
+
+    small_sort_packed(items, size);
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint16_t key = (uint16_t)((items[i] >> 32) + bias);
+        keys_temp[i] = flip ? inv_half_flip(key) : key;
+        values_temp[i] = values_in[(uint32_t)items[i]];
+    }
+    return 1;
+}
+
+
+/**
+ * Whether 8 or 16 bit keys are ascending relative to bias. Unlike the wider
+ * keys descending keys aren't looked for, as reversing them costs as much as
+ * the counting pass.
+ */
+static bool keys_ascending_u8(const uint8_t* restrict keys_in, const uint32_t size, const uint8_t bias)
+{
+    for (uint32_t i = 1; i < size; ++i)
+    {
+        if ((uint8_t)(keys_in[i] - bias) < (uint8_t)(keys_in[i - 1] - bias))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+static bool keys_ascending_u16(const uint16_t* restrict keys_in, const uint32_t size, const bool flip,
+    const uint16_t bias)
+{
+    uint16_t prev = (uint16_t)((flip ? half_flip(keys_in[0]) : keys_in[0]) - bias);
+    for (uint32_t i = 1; i < size; ++i)
+    {
+        const uint16_t key = (uint16_t)((flip ? half_flip(keys_in[i]) : keys_in[i]) - bias);
+        if (key < prev)
+        {
+            return false;
+        }
+        prev = key;
+    }
+    return true;
+}
+
+
+/**
+ * Counting sort 8 bit keys relative to bias in a single pass, returning the
+ * buffer holding the sorted data like the radix sorts.
+ */
+static uint32_t counting_sort_biased_u8(uint8_t* restrict keys_in, uint8_t* restrict keys_temp,
+    uint32_t* restrict values_in, uint32_t* restrict values_temp, const uint32_t size, const uint8_t bias)
+{
+    if (size <= 1)
+    {
+        return 0;
+    }
+
+    if (size <= SMALL_SORT_THRESHOLD_8)
+    {
+        return small_sort_u8(keys_in, keys_temp, values_in, values_temp, size, bias);
+    }
+
+    if (keys_ascending_u8(keys_in, size, bias))
+    {
+        return 0;
+    }
+
+    uint32_t hist[HIST_SIZE_8];
+    uint32_t sum;
+    memset(hist, 0, sizeof(hist));
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        ++hist[(uint8_t)(keys_in[i] - bias)];
+    }
+    sum_histograms(&sum, 1, HIST_SIZE_8, hist, false);
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint8_t key = keys_in[i];
+        const uint32_t index = hist[(uint8_t)(key - bias)]++;
+        keys_temp[index] = key;
+        values_temp[index] = values_in[i];
+    }
+    return 1;
+}
+
+
+/**
+ * Scatter 16 bit keys and values on the digit at the given shift. Keys are
+ * written unchanged, so flipped keys never need flipping back.
+ */
+static inline void counting_pass_u16(uint32_t* restrict hist, const bool flip, const uint16_t bias,
+    const uint32_t shift, const uint32_t mask, const uint16_t* restrict keys_in, uint16_t* restrict keys_out,
+    const uint32_t* restrict values_in, uint32_t* restrict values_out, const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint16_t key = keys_in[i];
+        const uint16_t sort_key = (uint16_t)((flip ? half_flip(key) : key) - bias);
+        const uint32_t index = hist[(sort_key >> shift) & mask]++;
+        keys_out[index] = key;
+        values_out[index] = values_in[i];
+    }
+}
+
+
+/**
+ * Counting sort 16 bit keys relative to bias, or half float and bfloat16 keys
+ * when flip is set. Large arrays are sorted in a single pass with an
+ * allocated 65536 entry histogram; smaller arrays, or when the allocation
+ * fails, are radix sorted on two 8 bit digits with the histograms on the
+ * stack.
+ */
+static uint32_t counting_sort_biased_u16(uint16_t* restrict keys_in, uint16_t* restrict keys_temp,
+    uint32_t* restrict values_in, uint32_t* restrict values_temp, const uint32_t size, const bool flip,
+    const uint16_t bias)
+{
+    if (size <= 1)
+    {
+        return 0;
+    }
+
+    if (size <= SMALL_SORT_THRESHOLD_8)
+    {
+        return small_sort_u16(keys_in, keys_temp, values_in, values_temp, size, flip, bias);
+    }
+
+    if (keys_ascending_u16(keys_in, size, flip, bias))
+    {
+        return 0;
+    }
+
+    uint32_t* hist = size >= COUNTING_SORT_MIN_SIZE_16 ? (uint32_t*)calloc(1 << 16, sizeof(uint32_t)) : NULL;
+    if (hist)
+    {
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            ++hist[(uint16_t)((flip ? half_flip(keys_in[i]) : keys_in[i]) - bias)];
+        }
+        uint32_t sum;
+        sum_histograms(&sum, 1, 1 << 16, hist, false);
+        counting_pass_u16(hist, flip, bias, 0, 0xffff, keys_in, keys_temp, values_in, values_temp, size);
+        free(hist);
+        return 1;
+    }
+
+    uint32_t digit_hist[2][HIST_SIZE_8];
+    memset(digit_hist, 0, sizeof(digit_hist));
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint16_t key = (uint16_t)((flip ? half_flip(keys_in[i]) : keys_in[i]) - bias);
+        ++digit_hist[0][key & 0xff];
+        ++digit_hist[1][key >> 8];
+    }
+
+    // skip a digit every key shares
+    const uint16_t first_key = (uint16_t)((flip ? half_flip(keys_in[0]) : keys_in[0]) - bias);
+    const bool sort_low = digit_hist[0][first_key & 0xff] != size;
+    const bool sort_high = digit_hist[1][first_key >> 8] != size;
+    uint32_t sum[2];
+    sum_histograms(sum, 2, HIST_SIZE_8, digit_hist[0], false);
+
+    if (!sort_low)
+    {
+        counting_pass_u16(digit_hist[1], flip, bias, 8, 0xff, keys_in, keys_temp, values_in, values_temp, size);
+        return 1;
+    }
+    counting_pass_u16(digit_hist[0], flip, bias, 0, 0xff, keys_in, keys_temp, values_in, values_temp, size);
+    if (!sort_high)
+    {
+        return 1;
+    }
+    counting_pass_u16(digit_hist[1], flip, bias, 8, 0xff, keys_temp, keys_in, values_temp, values_in, size);
+    return 0;
+}
+
+
+uint32_t RADIXSORT_ISA_FN(counting_sort_u8)(uint8_t* restrict keys_in_out, uint8_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    return counting_sort_biased_u8(keys_in_out, keys_temp, values_in_out, values_temp, size, 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(counting_sort_i8)(int8_t* restrict keys_in_out, int8_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    return counting_sort_biased_u8((uint8_t*)keys_in_out, (uint8_t*)keys_temp, values_in_out, values_temp, size, 0x80);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(counting_sort_u16)(uint16_t* restrict keys_in_out, uint16_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    return counting_sort_biased_u16(keys_in_out, keys_temp, values_in_out, values_temp, size, false, 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(counting_sort_i16)(int16_t* restrict keys_in_out, int16_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    return counting_sort_biased_u16((uint16_t*)keys_in_out, (uint16_t*)keys_temp, values_in_out, values_temp, size,
+        false, 0x8000);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(counting_sort_f16)(uint16_t* restrict keys_in_out, uint16_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    return counting_sort_biased_u16(keys_in_out, keys_temp, values_in_out, values_temp, size, true, 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(counting_sort_bf16)(uint16_t* restrict keys_in_out, uint16_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    return counting_sort_biased_u16(keys_in_out, keys_temp, values_in_out, values_temp, size, true, 0);
+}
+
+
+/**
+ * Sort keys and values in buffer a using buffer b as temporary storage with a
+ * most significant digit first radix sort, only considering 8 bit digits up
+ * to and including the given bucket. Keys are partitioned on their highest
+ * varying digit until partitions fit in cache, where they are finished with
+ * the LSD radix sort. Returns the buffer holding the sorted data, 0 for a and
+ * 1 for b.
+ */
+static uint32_t msd_sort_u64(uint64_t* restrict keys_a, uint64_t* restrict keys_b,
+    uint32_t* restrict values_a, uint32_t* restrict values_b, const uint32_t size, const uint32_t max_bucket)
+{
+    if (size <= MSD_LSD_THRESHOLD_64)
+    {
+        return RADIXSORT_ISA_FN(radix8sort_u64)(keys_a, keys_b, values_a, values_b, size);
+    }
+
+    // count every digit at once so digits where all keys are the same can be
+    // skipped without reading the keys again
+    const uint32_t kHistMask = HIST_SIZE_8 - 1;
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    memset(hist, 0, sizeof(uint32_t) * (max_bucket + 1) * HIST_SIZE_8);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint64_t key = keys_a[i];
+        for (uint32_t bucket = 0; bucket <= max_bucket; ++bucket)
+        {
+            const uint32_t shift = bucket * RADIX_BITS_8;
+            const uint32_t pos = (key >> shift) & kHistMask;
+            ++hist[(bucket * HIST_SIZE_8) + pos];
+        }
+    }
+
+    // find the most significant digit which varies
+    uint32_t bucket = max_bucket + 1;
+    while (bucket-- > 0)
+    {
+        if (hist[(bucket * HIST_SIZE_8) + ((keys_a[0] >> (bucket * RADIX_BITS_8)) & kHistMask)] != size)
+        {
+            break;
+        }
+    }
+    if (bucket > max_bucket)
+    {
+        // all keys are the same
+        return 0;
+    }
+
+    // partition into buffer b on the digit
+    const uint32_t shift = bucket * RADIX_BITS_8;
+    uint32_t offsets[HIST_SIZE_8 + 1];
+    offsets[0] = 0;
+    for (uint32_t i = 0; i < HIST_SIZE_8; ++i)
+    {
+        offsets[i + 1] = offsets[i] + hist[(bucket * HIST_SIZE_8) + i];
+    }
+    uint32_t* restrict next = hist + (bucket * HIST_SIZE_8);
+    memcpy(next, offsets, sizeof(uint32_t) * HIST_SIZE_8);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint64_t key = keys_a[i];
+        const uint32_t pos = (key >> shift) & kHistMask;
+        const uint32_t index = next[pos]++;
+        keys_b[index] = key;
+        values_b[index] = values_a[i];
+    }
+
+    // sort each partition, recording which buffer it ends up in
+    uint8_t partition_out[HIST_SIZE_8];
+    uint32_t size_in_b = 0;
+    for (uint32_t i = 0; i < HIST_SIZE_8; ++i)
+    {
+        const uint32_t begin = offsets[i];
+        const uint32_t count = offsets[i + 1] - begin;
+        uint32_t out = 0;
+        if (count > 1 && bucket > 0)
+        {
+            out = msd_sort_u64(keys_b + begin, keys_a + begin, values_b + begin, values_a + begin, count,
+                bucket - 1);
+        }
+        partition_out[i] = (uint8_t)out;
+        size_in_b += out == 0 ? count : 0;
+    }
+
+    // gather the partitions into whichever buffer holds most of the keys
+    const uint32_t out = size_in_b >= size - size_in_b ? 1 : 0;
+    uint64_t* restrict keys[2] = {keys_b, keys_a};
+    uint32_t* restrict values[2] = {values_b, values_a};
+    for (uint32_t i = 0; i < HIST_SIZE_8; ++i)
+    {
+        const uint32_t in = partition_out[i];
+        if (in != !out)
+        {
+            const uint32_t begin = offsets[i];
+            const uint32_t count = offsets[i + 1] - begin;
+            memcpy(keys[!in] + begin, keys[in] + begin, sizeof(uint64_t) * count);
+            memcpy(values[!in] + begin, values[in] + begin, sizeof(uint32_t) * count);
+        }
+    }
+    return out;
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radixsort_msd_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return msd_sort_u64(keys_in_out, keys_temp, values_in_out, values_temp, size, HIST_BUCKETS_64_8 - 1);
+}
+
+
+static inline uint32_t radixsort_f32(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize, uint32_t* restrict hist, uint32_t* restrict sum, float* keys_in_f32,
+    float* restrict keys_temp_f32, void* restrict values_in, void* values_temp, const size_t value_size,
+    const uint32_t size, const bool descending, const bool argsort, const bool sort_keys)
+{
+    // create uint32_t pointers to inputs to avoid float to int casting
+    uint32_t* restrict keys_in = (uint32_t*)keys_in_f32;
+    uint32_t* restrict keys_temp = (uint32_t*)keys_temp_f32;
+
+    if (size <= 1)
+    {
+        if (argsort)
+        {
+            fill_indices(values_in, size);
+        }
+        return 0;
+    }
+
+    if (size <= (kRadixBits > RADIX_BITS_8 ? SMALL_SORT_THRESHOLD_11 : SMALL_SORT_THRESHOLD_8))
+    {
+        return small_sort_u32(keys_in, keys_temp, argsort ? NULL : values_in, values_temp, value_size, size, true, 0, descending);
+    }
+
+    // already sorted keys are left where they are and strictly descending keys
+    // only need reversing
+    const enum key_order order = find_order_u32(keys_in, size, true, 0, descending);
+    if (order == KEY_ORDER_ASCENDING)
+    {
+        if (argsort)
+        {
+            fill_indices(values_in, size);
+        }
+        return 0;
+    }
+    if (order == KEY_ORDER_DESCENDING)
+    {
+        reverse_copy_u32(keys_in, keys_temp, argsort ? NULL : values_in, values_temp, value_size, size);
+        return 1;
+    }
+
+    uint32_t min_key, max_key;
+    init_histograms_u32(kRadixBits, kHistBuckets, kHistSize, hist, keys_in, size, 0, true, &min_key, &max_key);
+
+    // skip passes where all keys have the same digit
+    uint32_t passes[HIST_BUCKETS_64_8];
+    uint32_t num_passes = plan_passes(passes, kRadixBits, kHistBuckets, kHistSize, hist, float_flip(keys_in[0]), size);
+
+    // if the keys span a narrow range which straddles digit boundaries it
+    // takes fewer passes to sort on the key relative to the minimum key, in
+    // which case build the histograms again for the rebased digits
+    uint32_t base = 0;
+    const uint32_t num_rebased = rebased_buckets(kRadixBits, max_key - min_key);
+    if (num_rebased < num_passes)
+    {
+        base = min_key;
+        init_histograms_u32(kRadixBits, num_rebased, kHistSize, hist, keys_in, size, base, true, &min_key,
+            &max_key);
+        num_passes = plan_passes(passes, kRadixBits, num_rebased, kHistSize, hist, float_flip(keys_in[0]) - base, size);
+    }
+
+    sum_histograms(sum, kHistBuckets, kHistSize, hist, descending);
+
+    // alternate input and output buffers on each radix pass
+    uint32_t* restrict keys[2] = {keys_in, keys_temp};
+    void* restrict values[2] = {values_in, values_temp};
+    const uint32_t kHistMask = kHistSize - 1;
+    struct scatter_buffers buffers;
+    scatter_buffers_init(&buffers, resolve_scatter_mode(size, sizeof(uint32_t), value_size), kHistSize,
+        sizeof(uint32_t), value_size);
+
+    // flip the key on the first pass and flip it back on the last
+    uint32_t out = 0;
+    for (uint32_t pass = 0; pass < num_passes; ++pass)
+    {
+        const uint32_t in = out;
+        out = !in;
+        uint32_t* restrict offset = hist + (passes[pass] * kHistSize);
+        // argsorts make indices on the first pass, and may leave the keys of
+        // the last pass unwritten
+        const void* restrict pass_values_in = argsort && pass == 0 ? NULL : values[in];
+        uint32_t* restrict pass_keys_out = sort_keys || pass != num_passes - 1 ? keys[out] : NULL;
+        scatter_pass_u32(&buffers, offset, base, passes[pass] * kRadixBits, kHistMask, keys[in], pass_keys_out,
+            pass_values_in, values[out], value_size, size, pass == 0, pass == num_passes - 1);
+    }
+
+    scatter_buffers_free(&buffers);
+    return out;
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_f32)(float* restrict keys_in_out_f32, float* restrict keys_temp_f32,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_f32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out_f32, keys_temp_f32, values_in_out, values_temp, sizeof(uint32_t), size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_f32)(float* restrict keys_in_f32, float* restrict keys_out_f32,
+    uint32_t* restrict values_in, uint32_t* restrict values_out, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_f32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_f32, keys_out_f32, values_in, values_out, sizeof(uint32_t), size, false, false, true);
+}
+
+
+static inline uint32_t radixsort_f64(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize, uint32_t* restrict hist, uint32_t* restrict sum, double* keys_in_f64,
+    double* restrict keys_temp_f64, void* restrict values_in, void* values_temp, const size_t value_size,
+    const uint32_t size, const bool descending, const bool argsort, const bool sort_keys)
+{
+    // create uint64_t pointers to inputs to avoid double to int casting
+    uint64_t* restrict keys_in = (uint64_t*)keys_in_f64;
+    uint64_t* restrict keys_temp = (uint64_t*)keys_temp_f64;
+
+    if (size <= 1)
+    {
+        if (argsort)
+        {
+            fill_indices(values_in, size);
+        }
+        return 0;
+    }
+
+    if (size <= (kRadixBits > RADIX_BITS_8 ? SMALL_SORT_THRESHOLD_11 : SMALL_SORT_THRESHOLD_8))
+    {
+        return small_sort_u64(keys_in, keys_temp, argsort ? NULL : values_in, values_temp, value_size, size, true, 0, descending);
+    }
+
+    // already sorted keys are left where they are and strictly descending keys
+    // only need reversing
+    const enum key_order order = find_order_u64(keys_in, size, true, 0, descending);
+    if (order == KEY_ORDER_ASCENDING)
+    {
+        if (argsort)
+        {
+            fill_indices(values_in, size);
+        }
+        return 0;
+    }
+    if (order == KEY_ORDER_DESCENDING)
+    {
+        reverse_copy_u64(keys_in, keys_temp, argsort ? NULL : values_in, values_temp, value_size, size);
+        return 1;
+    }
+
+    uint64_t min_key, max_key;
+    init_histograms_u64(kRadixBits, kHistBuckets, kHistSize, hist, keys_in, size, 0, true, &min_key, &max_key);
+
+    // skip passes where all keys have the same digit
+    uint32_t passes[HIST_BUCKETS_64_8];
+    uint32_t num_passes = plan_passes(passes, kRadixBits, kHistBuckets, kHistSize, hist, double_flip(keys_in[0]), size);
+
+    // if the keys span a narrow range which straddles digit boundaries it
+    // takes fewer passes to sort on the key relative to the minimum key, in
+    // which case build the histograms again for the rebased digits
+    uint64_t base = 0;
+    const uint32_t num_rebased = rebased_buckets(kRadixBits, max_key - min_key);
+    if (num_rebased < num_passes)
+    {
+        base = min_key;
+        init_histograms_u64(kRadixBits, num_rebased, kHistSize, hist, keys_in, size, base, true, &min_key,
+            &max_key);
+        num_passes = plan_passes(passes, kRadixBits, num_rebased, kHistSize, hist, double_flip(keys_in[0]) - base, size);
+    }
+
+    sum_histograms(sum, kHistBuckets, kHistSize, hist, descending);
+
+    // alternate input and output buffers on each radix pass
+    uint64_t* restrict keys[2] = {keys_in, keys_temp};
+    void* restrict values[2] = {values_in, values_temp};
+    const uint32_t kHistMask = kHistSize - 1;
+    struct scatter_buffers buffers;
+    scatter_buffers_init(&buffers, resolve_scatter_mode(size, sizeof(uint64_t), value_size), kHistSize,
+        sizeof(uint64_t), value_size);
+
+    // flip the key on the first pass and flip it back on the last
+    uint32_t out = 0;
+    for (uint32_t pass = 0; pass < num_passes; ++pass)
+    {
+        const uint32_t in = out;
+        out = !in;
+        uint32_t* restrict offset = hist + (passes[pass] * kHistSize);
+        // argsorts make indices on the first pass, and may leave the keys of
+        // the last pass unwritten
+        const void* restrict pass_values_in = argsort && pass == 0 ? NULL : values[in];
+        uint64_t* restrict pass_keys_out = sort_keys || pass != num_passes - 1 ? keys[out] : NULL;
+        scatter_pass_u64(&buffers, offset, base, passes[pass] * kRadixBits, kHistMask, keys[in], pass_keys_out,
+            pass_values_in, values[out], value_size, size, pass == 0, pass == num_passes - 1);
+    }
+
+    scatter_buffers_free(&buffers);
+    return out;
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_f64)(double* restrict keys_in_out_f64, double* restrict keys_temp_f64,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_f64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out_f64, keys_temp_f64, values_in_out, values_temp, sizeof(uint32_t), size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_f64)(double* restrict keys_in_out_f64, double* restrict keys_temp_f64,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_f64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out_f64, keys_temp_f64, values_in_out, values_temp, sizeof(uint32_t), size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_desc_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, 0, true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_desc_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, 0, true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_desc_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_f32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_desc_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_f64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_desc_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, UINT32_C(0x80000000), true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_desc_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, UINT64_C(0x8000000000000000), true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_desc_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, 0, true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_desc_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, 0, true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_desc_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_f32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_desc_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_f64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_desc_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, UINT32_C(0x80000000), true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_desc_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, sizeof(uint32_t), size, UINT64_C(0x8000000000000000), true, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_keys_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, NULL, NULL, 0, size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_keys_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, NULL, NULL, 0, size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_keys_f32)(float* restrict keys_in_out, float* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_f32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, NULL, NULL, 0, size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_keys_f64)(double* restrict keys_in_out, double* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_f64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, NULL, NULL, 0, size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_keys_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, NULL, NULL, 0, size, UINT32_C(0x80000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_keys_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, NULL, NULL, 0, size, UINT64_C(0x8000000000000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_keys_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, NULL, NULL, 0, size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_keys_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, NULL, NULL, 0, size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_keys_f32)(float* restrict keys_in_out, float* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_f32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, NULL, NULL, 0, size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_keys_f64)(double* restrict keys_in_out, double* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_f64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, NULL, NULL, 0, size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_keys_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, NULL, NULL, 0, size, UINT32_C(0x80000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_keys_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, NULL, NULL, 0, size, UINT64_C(0x8000000000000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8argsort_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, 0, false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8argsort_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, 0, false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8argsort_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_f32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8argsort_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_f64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8argsort_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, UINT32_C(0x80000000), false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8argsort_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, UINT64_C(0x8000000000000000), false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11argsort_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, 0, false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11argsort_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, 0, false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11argsort_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_f32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11argsort_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_f64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11argsort_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, UINT32_C(0x80000000), false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11argsort_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, indices_out, indices_temp, sizeof(uint32_t), size, UINT64_C(0x8000000000000000), false, true, sort_keys != 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values64_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values64_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values64_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_f32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values64_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_f64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values64_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, UINT32_C(0x80000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values64_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, UINT64_C(0x8000000000000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values64_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values64_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values64_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_f32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values64_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_f64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values64_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, UINT32_C(0x80000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values64_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, sizeof(uint64_t), size, UINT64_C(0x8000000000000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, value_size, size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, value_size, size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_f32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, value_size, size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_f64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, value_size, size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_32_8];
+    return radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, value_size, size, UINT32_C(0x80000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_values_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    uint32_t sum[HIST_BUCKETS_64_8];
+    return radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, value_size, size, UINT64_C(0x8000000000000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, value_size, size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, value_size, size, 0, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_f32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, value_size, size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_f64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, keys_in_out, keys_temp, values_in_out, values_temp, value_size, size, false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_32_11];
+    return radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, value_size, size, UINT32_C(0x80000000), false, false, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_values_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size)
+{
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    uint32_t sum[HIST_BUCKETS_64_11];
+    return radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, sum, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, value_size, size, UINT64_C(0x8000000000000000), false, false, true);
+}
+
+
+/**
+ * Perform a radix pass over an array of more than UINT32_MAX keys, with 64 bit
+ * histogram counts, flipping float keys on the first pass and back on the
+ * last like radixpass_f32.
+ */
+static FORCE_INLINE void radixpass_size64_u32(uint64_t* restrict hist, const uint32_t bias, const uint32_t shift,
+    const uint32_t mask, const uint32_t* restrict keys_in, uint32_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const size_t size,
+    const bool flip, const bool unflip)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        const uint32_t key = flip ? float_flip(keys_in[i]) : keys_in[i];
+        const uint32_t pos = ((key - bias) >> shift) & mask;
+        const uint64_t index = hist[pos]++;
+        keys_out[index] = unflip ? inv_float_flip(key) : key;
+        if (values_out)
+        {
+            memcpy((char*)values_out + index * value_size, (const char*)values_in + i * value_size, value_size);
+        }
+    }
+}
+
+
+static FORCE_INLINE void radixpass_size64_u64(uint64_t* restrict hist, const uint64_t bias, const uint32_t shift,
+    const uint32_t mask, const uint64_t* restrict keys_in, uint64_t* restrict keys_out,
+    const void* restrict values_in, void* restrict values_out, const size_t value_size, const size_t size,
+    const bool flip, const bool unflip)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        const uint64_t key = flip ? double_flip(keys_in[i]) : keys_in[i];
+        const uint32_t pos = ((key - bias) >> shift) & mask;
+        const uint64_t index = hist[pos]++;
+        keys_out[index] = unflip ? inv_double_flip(key) : key;
+        if (values_out)
+        {
+            memcpy((char*)values_out + index * value_size, (const char*)values_in + i * value_size, value_size);
+        }
+    }
+}
+
+
+/**
+ * Update 64 bit histograms so each entry sums the previous entries, as
+ * sum_histograms.
+ */
+static void sum_histograms_size64(uint64_t* restrict hist, const uint32_t kHistBuckets, const uint32_t kHistSize)
+{
+    for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+    {
+        uint64_t* restrict offset = hist + ((size_t)bucket * kHistSize);
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            const uint64_t count = offset[i];
+            offset[i] = sum;
+            sum += count;
+        }
+    }
+}
+
+
+/**
+ * Radix sort more than UINT32_MAX keys relative to bias, as radixsort_u32
+ * and radixsort_f32 when flip is set, counting digits in 64 bit histograms.
+ * Passes where every key shares a digit are skipped, but arrays this large
+ * are assumed to be unsorted and span most of the key range, so unlike the
+ * 32 bit sorts they are not checked for order or rebased on the minimum key,
+ * and every pass scatters directly.
+ */
+static uint32_t radixsort_size64_u32(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize,
+    uint64_t* restrict hist, uint32_t* restrict keys_in, uint32_t* restrict keys_temp, void* restrict values_in,
+    void* restrict values_temp, const size_t value_size, const size_t size, const bool flip, const uint32_t bias)
+{
+    memset(hist, 0, sizeof(uint64_t) * kHistBuckets * kHistSize);
+
+    const uint32_t kHistMask = kHistSize - 1;
+    for (size_t i = 0; i < size; ++i)
+    {
+        const uint32_t key = (flip ? float_flip(keys_in[i]) : keys_in[i]) - bias;
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        {
+            ++hist[(bucket * kHistSize) + ((key >> (bucket * kRadixBits)) & kHistMask)];
+        }
+    }
+
+    // skip passes where all keys have the same digit
+    uint32_t passes[HIST_BUCKETS_64_8];
+    uint32_t num_passes = 0;
+    const uint32_t first_key = (flip ? float_flip(keys_in[0]) : keys_in[0]) - bias;
+    for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+    {
+        if (hist[(bucket * kHistSize) + ((first_key >> (bucket * kRadixBits)) & kHistMask)] != size)
+        {
+            passes[num_passes++] = bucket;
+        }
+    }
+
+    sum_histograms_size64(hist, kHistBuckets, kHistSize);
+
+    // alternate input and output buffers on each radix pass
+    uint32_t* restrict keys[2] = {keys_in, keys_temp};
+    void* restrict values[2] = {values_in, values_temp};
+
+    uint32_t out = 0;
+    for (uint32_t pass = 0; pass < num_passes; ++pass)
+    {
+        const uint32_t in = out;
+        out = !in;
+        uint64_t* restrict offset = hist + (passes[pass] * kHistSize);
+        const bool pass_flip = flip && pass == 0;
+        const bool pass_unflip = flip && pass == num_passes - 1;
+        DISPATCH_VALUE_SIZE(values_in ? value_size : 0, radixpass_size64_u32(offset, bias, passes[pass] * kRadixBits, kHistMask,
+            keys[in], keys[out], values[in], kValueSize ? values[out] : NULL, kValueSize, size, pass_flip,
+            pass_unflip));
+    }
+
+    return out;
+}
+
+
+static uint32_t radixsort_size64_u64(const uint32_t kRadixBits, const uint32_t kHistBuckets, const uint32_t kHistSize,
+    uint64_t* restrict hist, uint64_t* restrict keys_in, uint64_t* restrict keys_temp, void* restrict values_in,
+    void* restrict values_temp, const size_t value_size, const size_t size, const bool flip, const uint64_t bias)
+{
+    memset(hist, 0, sizeof(uint64_t) * kHistBuckets * kHistSize);
+
+    const uint32_t kHistMask = kHistSize - 1;
+    for (size_t i = 0; i < size; ++i)
+    {
+        const uint64_t key = (flip ? double_flip(keys_in[i]) : keys_in[i]) - bias;
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        {
+            ++hist[(bucket * kHistSize) + ((key >> (bucket * kRadixBits)) & kHistMask)];
+        }
+    }
+
+    // skip passes where all keys have the same digit
+    uint32_t passes[HIST_BUCKETS_64_8];
+    uint32_t num_passes = 0;
+    const uint64_t first_key = (flip ? double_flip(keys_in[0]) : keys_in[0]) - bias;
+    for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+    {
+        if (hist[(bucket * kHistSize) + ((first_key >> (bucket * kRadixBits)) & kHistMask)] != size)
+        {
+            passes[num_passes++] = bucket;
+        }
+    }
+
+    sum_histograms_size64(hist, kHistBuckets, kHistSize);
+
+    // alternate input and output buffers on each radix pass
+    uint64_t* restrict keys[2] = {keys_in, keys_temp};
+    void* restrict values[2] = {values_in, values_temp};
+
+    uint32_t out = 0;
+    for (uint32_t pass = 0; pass < num_passes; ++pass)
+    {
+        const uint32_t in = out;
+        out = !in;
+        uint64_t* restrict offset = hist + (passes[pass] * kHistSize);
+        const bool pass_flip = flip && pass == 0;
+        const bool pass_unflip = flip && pass == num_passes - 1;
+        DISPATCH_VALUE_SIZE(values_in ? value_size : 0, radixpass_size64_u64(offset, bias, passes[pass] * kRadixBits, kHistMask,
+            keys[in], keys[out], values[in], kValueSize ? values[out] : NULL, kValueSize, size, pass_flip,
+            pass_unflip));
+    }
+
+    return out;
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix8sort_values_u32)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix8sort_size64_counts_u32)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_counts_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    return radixsort_size64_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, value_size, size, false, 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix8sort_values_u64)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix8sort_size64_counts_u64)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_counts_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    return radixsort_size64_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, value_size, size, false, 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix8sort_values_f32)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix8sort_size64_counts_f32)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_counts_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    return radixsort_size64_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, value_size, size, true, 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix8sort_values_f64)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix8sort_size64_counts_f64)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_counts_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    return radixsort_size64_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, value_size, size, true, 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix8sort_values_i32)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix8sort_size64_counts_i32)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_counts_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    return radixsort_size64_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, hist, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, value_size, size, false, UINT32_C(0x80000000));
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix8sort_values_i64)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix8sort_size64_counts_i64)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_size64_counts_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    return radixsort_size64_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, hist, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, value_size, size, false, UINT64_C(0x8000000000000000));
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix11sort_values_u32)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix11sort_size64_counts_u32)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_counts_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    return radixsort_size64_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, value_size, size, false, 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix11sort_values_u64)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix11sort_size64_counts_u64)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_counts_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    return radixsort_size64_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, value_size, size, false, 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix11sort_values_f32)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix11sort_size64_counts_f32)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_counts_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    return radixsort_size64_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, value_size, size, true, 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix11sort_values_f64)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix11sort_size64_counts_f64)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_counts_f64)(double* restrict keys_in_out, double* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    return radixsort_size64_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, value_size, size, true, 0);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix11sort_values_i32)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix11sort_size64_counts_i32)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_counts_i32)(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
+    return radixsort_size64_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, (uint32_t*)keys_in_out, (uint32_t*)keys_temp, values_in_out, values_temp, value_size, size, false, UINT32_C(0x80000000));
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    if (size <= UINT32_MAX)
+    {
+        return RADIXSORT_ISA_FN(radix11sort_values_i64)(keys_in_out, keys_temp, values_in_out, values_temp,
+            (uint32_t)size, value_size);
+    }
+    return RADIXSORT_ISA_FN(radix11sort_size64_counts_i64)(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        value_size);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_size64_counts_i64)(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size)
+{
+    uint64_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    return radixsort_size64_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, hist, (uint64_t*)keys_in_out, (uint64_t*)keys_temp, values_in_out, values_temp, value_size, size, false, UINT64_C(0x8000000000000000));
+}
+
+
+/**
+ * Insertion sort keys and values in place, flipping float keys for the
+ * comparison if flip is set.
+ */
+static void insertion_sort_inplace_u32(uint32_t* restrict keys, uint32_t* restrict values, const uint32_t size,
+    const bool flip)
+{
+    for (uint32_t i = 1; i < size; ++i)
+    {
+        const uint32_t key = keys[i];
+        const uint32_t decoded_key = flip ? float_flip(key) : key;
+        const uint32_t value = values[i];
+        uint32_t j = i;
+        for (; j > 0 && (flip ? float_flip(keys[j - 1]) : keys[j - 1]) > decoded_key; --j)
+        {
+            keys[j] = keys[j - 1];
+            values[j] = values[j - 1];
+        }
+        keys[j] = key;
+        values[j] = value;
+    }
+}
+
+
+static void insertion_sort_inplace_u64(uint64_t* restrict keys, uint32_t* restrict values, const uint32_t size)
+{
+    for (uint32_t i = 1; i < size; ++i)
+    {
+        const uint64_t key = keys[i];
+        const uint32_t value = values[i];
+        uint32_t j = i;
+        for (; j > 0 && keys[j - 1] > key; --j)
+        {
+            keys[j] = keys[j - 1];
+            values[j] = values[j - 1];
+        }
+        keys[j] = key;
+        values[j] = value;
+    }
+}
+
+
+/**
+ * Sort keys and values in place with an American flag sort, only considering
+ * 8 bit digits up to and including the given bucket. Keys are permuted into
+ * partitions on their highest varying digit using only the histogram, then
+ * each partition is sorted recursively. Float keys are flipped on the fly
+ * when extracting digits if flip is set.
+ */
+static void inplace_sort_u32(uint32_t* restrict keys, uint32_t* restrict values, const uint32_t size,
+    const uint32_t max_bucket, const bool flip)
+{
+    if (size <= INSERTION_SORT_THRESHOLD)
+    {
+        insertion_sort_inplace_u32(keys, values, size, flip);
+        return;
+    }
+
+    // count every digit at once so digits where all keys are the same can be
+    // skipped without reading the keys again
+    const uint32_t kHistMask = HIST_SIZE_8 - 1;
+    uint32_t hist[HIST_BUCKETS_32_8 * HIST_SIZE_8];
+    memset(hist, 0, sizeof(uint32_t) * (max_bucket + 1) * HIST_SIZE_8);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint32_t key = flip ? float_flip(keys[i]) : keys[i];
+        for (uint32_t bucket = 0; bucket <= max_bucket; ++bucket)
+        {
+            const uint32_t shift = bucket * RADIX_BITS_8;
+            const uint32_t pos = (key >> shift) & kHistMask;
+            ++hist[(bucket * HIST_SIZE_8) + pos];
+        }
+    }
+
+    // find the most significant digit which varies
+    const uint32_t first_key = flip ? float_flip(keys[0]) : keys[0];
+    uint32_t bucket = max_bucket + 1;
+    while (bucket-- > 0)
+    {
+        if (hist[(bucket * HIST_SIZE_8) + ((first_key >> (bucket * RADIX_BITS_8)) & kHistMask)] != size)
+        {
+            break;
+        }
+    }
+    if (bucket > max_bucket)
+    {
+        // all keys are the same
+        return;
+    }
+
+    uint32_t offsets[HIST_SIZE_8 + 1];
+    offsets[0] = 0;
+    for (uint32_t i = 0; i < HIST_SIZE_8; ++i)
+    {
+        offsets[i + 1] = offsets[i] + hist[(bucket * HIST_SIZE_8) + i];
+    }
+
+    // fill each partition in turn, swapping every misplaced key and value into
+    // the next free slot of its own partition until a key belonging to the
+    // partition being filled turns up
+    const uint32_t shift = bucket * RADIX_BITS_8;
+    uint32_t* restrict next = hist + (bucket * HIST_SIZE_8);
+    memcpy(next, offsets, sizeof(uint32_t) * HIST_SIZE_8);
+    for (uint32_t pos = 0; pos < HIST_SIZE_8; ++pos)
+    {
+        const uint32_t end = offsets[pos + 1];
+        while (next[pos] < end)
+        {
+            uint32_t key = keys[next[pos]];
+            uint32_t value = values[next[pos]];
+            uint32_t key_pos = ((flip ? float_flip(key) : key) >> shift) & kHistMask;
+            while (key_pos != pos)
+            {
+                const uint32_t index = next[key_pos]++;
+                const uint32_t swap_key = keys[index];
+                const uint32_t swap_value = values[index];
+                keys[index] = key;
+                values[index] = value;
+                key = swap_key;
+                value = swap_value;
+                key_pos = ((flip ? float_flip(key) : key) >> shift) & kHistMask;
+            }
+            keys[next[pos]] = key;
+            values[next[pos]] = value;
+            ++next[pos];
+        }
+    }
+
+    if (bucket == 0)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < HIST_SIZE_8; ++i)
+    {
+        const uint32_t begin = offsets[i];
+        const uint32_t count = offsets[i + 1] - begin;
+        if (count > 1)
+        {
+            inplace_sort_u32(keys + begin, values + begin, count, bucket - 1, flip);
+        }
+    }
+}
+
+
+static void inplace_sort_u64(uint64_t* restrict keys, uint32_t* restrict values, const uint32_t size,
+    const uint32_t max_bucket)
+{
+    if (size <= INSERTION_SORT_THRESHOLD)
+    {
+        insertion_sort_inplace_u64(keys, values, size);
+        return;
+    }
+
+    // count every digit at once so digits where all keys are the same can be
+    // skipped without reading the keys again
+    const uint32_t kHistMask = HIST_SIZE_8 - 1;
+    uint32_t hist[HIST_BUCKETS_64_8 * HIST_SIZE_8];
+    memset(hist, 0, sizeof(uint32_t) * (max_bucket + 1) * HIST_SIZE_8);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const uint64_t key = keys[i];
+        for (uint32_t bucket = 0; bucket <= max_bucket; ++bucket)
+        {
+            const uint32_t shift = bucket * RADIX_BITS_8;
+            const uint32_t pos = (key >> shift) & kHistMask;
+            ++hist[(bucket * HIST_SIZE_8) + pos];
+        }
+    }
+
+    // find the most significant digit which varies
+    uint32_t bucket = max_bucket + 1;
+    while (bucket-- > 0)
+    {
+        if (hist[(bucket * HIST_SIZE_8) + ((keys[0] >> (bucket * RADIX_BITS_8)) & kHistMask)] != size)
+        {
+            break;
+        }
+    }
+    if (bucket > max_bucket)
+    {
+        // all keys are the same
+        return;
+    }
+
+    uint32_t offsets[HIST_SIZE_8 + 1];
+    offsets[0] = 0;
+    for (uint32_t i = 0; i < HIST_SIZE_8; ++i)
+    {
+        offsets[i + 1] = offsets[i] + hist[(bucket * HIST_SIZE_8) + i];
+    }
+
+    // fill each partition in turn, swapping every misplaced key and value into
+    // the next free slot of its own partition until a key belonging to the
+    // partition being filled turns up
+    const uint32_t shift = bucket * RADIX_BITS_8;
+    uint32_t* restrict next = hist + (bucket * HIST_SIZE_8);
+    memcpy(next, offsets, sizeof(uint32_t) * HIST_SIZE_8);
+    for (uint32_t pos = 0; pos < HIST_SIZE_8; ++pos)
+    {
+        const uint32_t end = offsets[pos + 1];
+        while (next[pos] < end)
+        {
+            uint64_t key = keys[next[pos]];
+            uint32_t value = values[next[pos]];
+            uint32_t key_pos = (key >> shift) & kHistMask;
+            while (key_pos != pos)
+            {
+                const uint32_t index = next[key_pos]++;
+                const uint64_t swap_key = keys[index];
+                const uint32_t swap_value = values[index];
+                keys[index] = key;
+                values[index] = value;
+                key = swap_key;
+                value = swap_value;
+                key_pos = (key >> shift) & kHistMask;
+            }
+            keys[next[pos]] = key;
+            values[next[pos]] = value;
+            ++next[pos];
+        }
+    }
+
+    if (bucket == 0)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < HIST_SIZE_8; ++i)
+    {
+        const uint32_t begin = offsets[i];
+        const uint32_t count = offsets[i + 1] - begin;
+        if (count > 1)
+        {
+            inplace_sort_u64(keys + begin, values + begin, count, bucket - 1);
+        }
+    }
+}
+
+
+void RADIXSORT_ISA_FN(radixsort_inplace_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict values_in_out, uint32_t size)
+{
+    inplace_sort_u32(keys_in_out, values_in_out, size, HIST_BUCKETS_32_8 - 1, false);
+}
+
+
+void RADIXSORT_ISA_FN(radixsort_inplace_u64)(uint64_t* restrict keys_in_out, uint32_t* restrict values_in_out, uint32_t size)
+{
+    inplace_sort_u64(keys_in_out, values_in_out, size, HIST_BUCKETS_64_8 - 1);
+}
+
+
+void RADIXSORT_ISA_FN(radixsort_inplace_f32)(float* restrict keys_in_out_f32, uint32_t* restrict values_in_out, uint32_t size)
+{
+    // create uint32_t pointers to inputs to avoid float to int casting
+    uint32_t* restrict keys_in_out = (uint32_t*)keys_in_out_f32;
+    inplace_sort_u32(keys_in_out, values_in_out, size, HIST_BUCKETS_32_8 - 1, true);
+}
+
+
+typedef void (*parallel_fn)(void* context, const uint32_t thread_index);
+
+struct parallel_thread
+{
+    parallel_fn fn;
+    void* context;
+    uint32_t thread_index;
+    bool started;
+#if defined(_WIN32)
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+};
+
+
+#if defined(_WIN32)
+static DWORD WINAPI parallel_thread_main(LPVOID arg)
+#else
+static void* parallel_thread_main(void* arg)
+#endif
+{
+    struct parallel_thread* thread = (struct parallel_thread*)arg;
+    thread->fn(thread->context, thread->thread_index);
+#if defined(_WIN32)
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+
+/**
+ * Run fn for each of the given number of threads, the calling thread being
+ * thread 0, and wait for them all to finish. Work for threads which can't be
+ * started is run on the calling thread.
+ */
+static void parallel_for(struct parallel_thread* restrict threads, const uint32_t num_threads, parallel_fn fn,
+    void* context)
+{
+    for (uint32_t i = 1; i < num_threads; ++i)
+    {
+        struct parallel_thread* thread = threads + i;
+        thread->fn = fn;
+        thread->context = context;
+        thread->thread_index = i;
+#if defined(_WIN32)
+        thread->handle = CreateThread(NULL, 0, parallel_thread_main, thread, 0, NULL);
+        thread->started = thread->handle != NULL;
+#else
+        thread->started = pthread_create(&thread->handle, NULL, parallel_thread_main, thread) == 0;
+#endif
+    }
+
+    fn(context, 0);
+
+    for (uint32_t i = 1; i < num_threads; ++i)
+    {
+        struct parallel_thread* thread = threads + i;
+        if (!thread->started)
+        {
+            fn(context, i);
+            continue;
+        }
+#if defined(_WIN32)
+        WaitForSingleObject(thread->handle, INFINITE);
+        CloseHandle(thread->handle);
+#else
+        pthread_join(thread->handle, NULL);
+#endif
+    }
+}
+
+
+/**
+ * Number of threads to sort the given number of keys with, a num_threads of 0
+ * using one thread per hardware thread.
+ */
+static uint32_t parallel_num_threads(uint32_t num_threads, const uint32_t size)
+{
+    if (num_threads == 0)
+    {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        num_threads = info.dwNumberOfProcessors;
+#else
+        const long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = num_cpus > 0 ? (uint32_t)num_cpus : 1;
+#endif
+    }
+    const uint32_t max_threads = size / PARALLEL_MIN_KEYS_PER_THREAD;
+    return num_threads < max_threads ? num_threads : max_threads;
+}
+
+
+static inline uint32_t chunk_begin(const uint32_t size, const uint32_t num_threads, const uint32_t thread_index)
+{
+    return (uint32_t)(((uint64_t)size * thread_index) / num_threads);
+}
+
+
+enum parallel_phase
+{
+    PARALLEL_PHASE_HISTOGRAM,
+    PARALLEL_PHASE_COUNT,
+    PARALLEL_PHASE_SCATTER,
+    PARALLEL_PHASE_REVERSE,
+};
+
+
+/**
+ * Count the digit at the given shift of keys relative to the given base.
+ */
+static void count_digit_u32(uint32_t* restrict hist, const uint32_t kHistSize, const uint32_t base,
+    const uint32_t shift, const uint32_t* restrict keys_in, const uint32_t size)
+{
+    memset(hist, 0, sizeof(uint32_t) * kHistSize);
+    const uint32_t kHistMask = kHistSize - 1;
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        ++hist[((keys_in[i] - base) >> shift) & kHistMask];
+    }
+}
+
+
+static void count_digit_u64(uint32_t* restrict hist, const uint32_t kHistSize, const uint64_t base,
+    const uint32_t shift, const uint64_t* restrict keys_in, const uint32_t size)
+{
+    memset(hist, 0, sizeof(uint32_t) * kHistSize);
+    const uint32_t kHistMask = kHistSize - 1;
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        ++hist[((keys_in[i] - base) >> shift) & kHistMask];
+    }
+}
+
+
+/**
+ * Turn each thread's digit counts for the given bucket into the offsets it
+ * scatters its chunk to. Keys with the same digit are written in chunk order,
+ * so the sort stays stable.
+ */
+static void parallel_offsets(uint32_t* restrict hist, const uint32_t num_threads, const uint32_t kHistBuckets,
+    const uint32_t kHistSize, const uint32_t bucket)
+{
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < kHistSize; ++i)
+    {
+        for (uint32_t thread_index = 0; thread_index < num_threads; ++thread_index)
+        {
+            uint32_t* restrict entry = hist + (((thread_index * kHistBuckets) + bucket) * kHistSize) + i;
+            const uint32_t count = *entry;
+            *entry = offset;
+            offset += count;
+        }
+    }
+}
+
+
+/**
+ * Sum each thread's histograms for the given number of buckets.
+ */
+static void parallel_sum_histograms(uint32_t* restrict sum_hist, const uint32_t* restrict hist,
+    const uint32_t num_threads, const uint32_t kHistBuckets, const uint32_t kHistSize, const uint32_t num_buckets)
+{
+    memset(sum_hist, 0, sizeof(uint32_t) * num_buckets * kHistSize);
+    for (uint32_t thread_index = 0; thread_index < num_threads; ++thread_index)
+    {
+        const uint32_t* restrict thread_hist = hist + (thread_index * kHistBuckets * kHistSize);
+        for (uint32_t i = 0; i < num_buckets * kHistSize; ++i)
+        {
+            sum_hist[i] += thread_hist[i];
+        }
+    }
+}
+
+
+/**
+ * State shared by the threads of a parallel sort of 32 bit or float keys,
+ * along with the arguments for the phase being run.
+ */
+struct parallel_sort_u32
+{
+    uint32_t kRadixBits;
+    uint32_t kHistBuckets;
+    uint32_t kHistSize;
+    uint32_t* keys[2];
+    uint32_t* values[2];
+    uint32_t size;
+    uint32_t num_threads;
+    bool is_float;
+    // per thread histograms, key ranges and orders
+    uint32_t* hist;
+    uint32_t* min_key;
+    uint32_t* max_key;
+    enum key_order* order;
+
+    enum parallel_phase phase;
+    uint32_t base;
+    uint32_t num_buckets;
+    uint32_t bucket;
+    uint32_t in;
+    bool flip;
+    bool unflip;
+    // per thread staging buffers
+    struct scatter_buffers* buffers;
+};
+
+
+static void parallel_sort_u32_thread(void* context, const uint32_t thread_index)
+{
+    struct parallel_sort_u32* sort = (struct parallel_sort_u32*)context;
+    const uint32_t begin = chunk_begin(sort->size, sort->num_threads, thread_index);
+    const uint32_t end = chunk_begin(sort->size, sort->num_threads, thread_index + 1);
+    uint32_t* restrict hist = sort->hist + (thread_index * sort->kHistBuckets * sort->kHistSize);
+    uint32_t* restrict offset = hist + (sort->bucket * sort->kHistSize);
+    const uint32_t in = sort->in;
+    const uint32_t out = !in;
+
+    switch (sort->phase)
+    {
+    case PARALLEL_PHASE_HISTOGRAM:
+        sort->order[thread_index] = find_order_u32(sort->keys[0] + begin, end - begin, sort->is_float, 0, false);
+        init_histograms_u32(sort->kRadixBits, sort->num_buckets, sort->kHistSize, hist, sort->keys[0] + begin,
+            end - begin, sort->base, sort->is_float, sort->min_key + thread_index, sort->max_key + thread_index);
+        break;
+    case PARALLEL_PHASE_COUNT:
+        count_digit_u32(offset, sort->kHistSize, sort->base, sort->bucket * sort->kRadixBits,
+            sort->keys[in] + begin, end - begin);
+        break;
+    case PARALLEL_PHASE_SCATTER:
+        scatter_pass_u32(sort->buffers + thread_index, offset, sort->base, sort->bucket * sort->kRadixBits,
+            sort->kHistSize - 1, sort->keys[in] + begin, sort->keys[out], sort->values[in] + begin,
+            sort->values[out], sizeof(uint32_t), end - begin, sort->is_float && sort->flip, sort->is_float && sort->unflip);
+        break;
+    case PARALLEL_PHASE_REVERSE:
+        reverse_copy_u32(sort->keys[0] + sort->size - end, sort->keys[1] + begin,
+            sort->values[0] + sort->size - end, sort->values[1] + begin, sizeof(uint32_t), end - begin);
+        break;
+    }
+}
+
+
+static uint32_t serial_radixsort_u32(const uint32_t kRadixBits, uint32_t* restrict keys_in,
+    uint32_t* restrict keys_temp, uint32_t* restrict values_in, uint32_t* restrict values_temp,
+    const uint32_t size, const bool is_float)
+{
+    if (is_float)
+    {
+        return kRadixBits == RADIX_BITS_8 ?
+            RADIXSORT_ISA_FN(radix8sort_f32)((float*)keys_in, (float*)keys_temp, values_in, values_temp, size) :
+            RADIXSORT_ISA_FN(radix11sort_f32)((float*)keys_in, (float*)keys_temp, values_in, values_temp, size);
+    }
+    return kRadixBits == RADIX_BITS_8 ?
+        RADIXSORT_ISA_FN(radix8sort_u32)(keys_in, keys_temp, values_in, values_temp, size) :
+        RADIXSORT_ISA_FN(radix11sort_u32)(keys_in, keys_temp, values_in, values_temp, size);
+}
+
+
+/**
+ * Radix sort 32 bit or float keys on multiple threads. Each thread counts the
+ * digits in its own chunk of the keys and scatters it to offsets following
+ * the same digit in earlier chunks, so the result is stable and identical to
+ * the single threaded sort. Falls back to the single threaded sort when the
+ * array is too small to split or memory for the threads can't be allocated.
+ */
+static uint32_t parallel_radixsort_u32(const uint32_t kRadixBits, const uint32_t kHistBuckets,
+    const uint32_t kHistSize, uint32_t* restrict keys_in, uint32_t* restrict keys_temp,
+    uint32_t* restrict values_in, uint32_t* restrict values_temp, const uint32_t size, uint32_t num_threads,
+    const bool is_float)
+{
+    num_threads = parallel_num_threads(num_threads, size);
+    if (num_threads <= 1)
+    {
+        return serial_radixsort_u32(kRadixBits, keys_in, keys_temp, values_in, values_temp, size, is_float);
+    }
+
+    struct parallel_sort_u32 sort;
+    sort.hist = (uint32_t*)malloc(sizeof(uint32_t) * num_threads * kHistBuckets * kHistSize);
+    sort.min_key = (uint32_t*)malloc(sizeof(uint32_t) * num_threads * 2);
+    sort.order = (enum key_order*)malloc(sizeof(enum key_order) * num_threads);
+    sort.buffers = (struct scatter_buffers*)malloc(sizeof(struct scatter_buffers) * num_threads);
+    struct parallel_thread* threads = (struct parallel_thread*)malloc(sizeof(struct parallel_thread) * num_threads);
+    if (!sort.hist || !sort.min_key || !sort.order || !sort.buffers || !threads)
+    {
+        free(sort.hist);
+        free(sort.min_key);
+        free(sort.order);
+        free(sort.buffers);
+        free(threads);
+        return serial_radixsort_u32(kRadixBits, keys_in, keys_temp, values_in, values_temp, size, is_float);
+    }
+    sort.max_key = sort.min_key + num_threads;
+    sort.kRadixBits = kRadixBits;
+    sort.kHistBuckets = kHistBuckets;
+    sort.kHistSize = kHistSize;
+    sort.keys[0] = keys_in;
+    sort.keys[1] = keys_temp;
+    sort.values[0] = values_in;
+    sort.values[1] = values_temp;
+    sort.size = size;
+    sort.num_threads = num_threads;
+    sort.is_float = is_float;
+    sort.bucket = 0;
+    sort.in = 0;
+
+    sort.phase = PARALLEL_PHASE_HISTOGRAM;
+    sort.base = 0;
+    sort.num_buckets = kHistBuckets;
+    parallel_for(threads, num_threads, parallel_sort_u32_thread, &sort);
+
     uint32_t hist[HIST_BUCKETS_32_11 * HIST_SIZE_11];
-    uint32_t sum[HIST_BUCKETS_32_11];
-    return radixsort_f32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, hist, sum, keys_in_f32, keys_out_f32, values_in, values_out, size);
+    parallel_sum_histograms(hist, sort.hist, num_threads, kHistBuckets, kHistSize, kHistBuckets);
+
+    // combine the key ranges, and the key orders including the keys either
+    // side of each chunk boundary
+    uint32_t min_key = sort.min_key[0];
+    uint32_t max_key = sort.max_key[0];
+    bool ascending = sort.order[0] == KEY_ORDER_ASCENDING;
+    bool descending = sort.order[0] == KEY_ORDER_DESCENDING;
+    for (uint32_t i = 1; i < num_threads; ++i)
+    {
+        min_key = sort.min_key[i] < min_key ? sort.min_key[i] : min_key;
+        max_key = sort.max_key[i] > max_key ? sort.max_key[i] : max_key;
+        const uint32_t begin = chunk_begin(size, num_threads, i);
+        const uint32_t prev_key = is_float ? float_flip(keys_in[begin - 1]) : keys_in[begin - 1];
+        const uint32_t key = is_float ? float_flip(keys_in[begin]) : keys_in[begin];
+        ascending = ascending && sort.order[i] == KEY_ORDER_ASCENDING && prev_key <= key;
+        descending = descending && sort.order[i] == KEY_ORDER_DESCENDING && prev_key > key;
+    }
+
+    // already sorted keys are left where they are and strictly descending keys
+    // only need reversing
+    uint32_t out = 0;
+    if (ascending)
+    {
+        out = 0;
+    }
+    else if (descending)
+    {
+        sort.phase = PARALLEL_PHASE_REVERSE;
+        parallel_for(threads, num_threads, parallel_sort_u32_thread, &sort);
+        out = 1;
+    }
+    else
+    {
+        // plan passes exactly as the single threaded sort does so the same
+        // buffer is returned
+        const uint32_t first_key = is_float ? float_flip(keys_in[0]) : keys_in[0];
+        uint32_t passes[HIST_BUCKETS_32_8];
+        uint32_t num_passes = plan_passes(passes, kRadixBits, kHistBuckets, kHistSize, hist, first_key, size);
+
+        const uint32_t num_rebased = rebased_buckets(kRadixBits, max_key - min_key);
+        if (num_rebased < num_passes)
+        {
+            sort.base = min_key;
+            sort.num_buckets = num_rebased;
+            parallel_for(threads, num_threads, parallel_sort_u32_thread, &sort);
+            parallel_sum_histograms(hist, sort.hist, num_threads, kHistBuckets, kHistSize, num_rebased);
+            num_passes = plan_passes(passes, kRadixBits, num_rebased, kHistSize, hist, first_key - sort.base, size);
+        }
+
+        // flip the key on the first pass and flip it back on the last, the
+        // first pass's digits were counted with the histograms
+        const enum radixsort_scatter_mode scatter_mode = resolve_scatter_mode(size, sizeof(uint32_t),
+            sizeof(uint32_t));
+        for (uint32_t i = 0; i < num_threads; ++i)
+        {
+            scatter_buffers_init(sort.buffers + i, scatter_mode, kHistSize, sizeof(uint32_t), sizeof(uint32_t));
+        }
+        for (uint32_t pass = 0; pass < num_passes; ++pass)
+        {
+            sort.in = out;
+            sort.bucket = passes[pass];
+            if (pass > 0)
+            {
+                sort.phase = PARALLEL_PHASE_COUNT;
+                parallel_for(threads, num_threads, parallel_sort_u32_thread, &sort);
+            }
+            parallel_offsets(sort.hist, num_threads, kHistBuckets, kHistSize, sort.bucket);
+            sort.phase = PARALLEL_PHASE_SCATTER;
+            sort.flip = pass == 0;
+            sort.unflip = pass == num_passes - 1;
+            parallel_for(threads, num_threads, parallel_sort_u32_thread, &sort);
+            out = !sort.in;
+        }
+        for (uint32_t i = 0; i < num_threads; ++i)
+        {
+            scatter_buffers_free(sort.buffers + i);
+        }
+    }
+
+    free(sort.hist);
+    free(sort.min_key);
+    free(sort.order);
+    free(sort.buffers);
+    free(threads);
+    return out;
+}
+
+
+/**
+ * State shared by the threads of a parallel sort of 64 bit keys, along with
+ * the arguments for the phase being run.
+ */
+struct parallel_sort_u64
+{
+    uint32_t kRadixBits;
+    uint32_t kHistBuckets;
+    uint32_t kHistSize;
+    uint64_t* keys[2];
+    uint32_t* values[2];
+    uint32_t size;
+    uint32_t num_threads;
+    // per thread histograms, key ranges and orders
+    uint32_t* hist;
+    uint64_t* min_key;
+    uint64_t* max_key;
+    enum key_order* order;
+
+    enum parallel_phase phase;
+    uint64_t base;
+    uint32_t num_buckets;
+    uint32_t bucket;
+    uint32_t in;
+    // per thread staging buffers
+    struct scatter_buffers* buffers;
+};
+
+
+static void parallel_sort_u64_thread(void* context, const uint32_t thread_index)
+{
+    struct parallel_sort_u64* sort = (struct parallel_sort_u64*)context;
+    const uint32_t begin = chunk_begin(sort->size, sort->num_threads, thread_index);
+    const uint32_t end = chunk_begin(sort->size, sort->num_threads, thread_index + 1);
+    uint32_t* restrict hist = sort->hist + (thread_index * sort->kHistBuckets * sort->kHistSize);
+    uint32_t* restrict offset = hist + (sort->bucket * sort->kHistSize);
+    const uint32_t in = sort->in;
+    const uint32_t out = !in;
+
+    switch (sort->phase)
+    {
+    case PARALLEL_PHASE_HISTOGRAM:
+        sort->order[thread_index] = find_order_u64(sort->keys[0] + begin, end - begin, false, 0, false);
+        init_histograms_u64(sort->kRadixBits, sort->num_buckets, sort->kHistSize, hist, sort->keys[0] + begin,
+            end - begin, sort->base, false, sort->min_key + thread_index, sort->max_key + thread_index);
+        break;
+    case PARALLEL_PHASE_COUNT:
+        count_digit_u64(offset, sort->kHistSize, sort->base, sort->bucket * sort->kRadixBits,
+            sort->keys[in] + begin, end - begin);
+        break;
+    case PARALLEL_PHASE_SCATTER:
+        scatter_pass_u64(sort->buffers + thread_index, offset, sort->base, sort->bucket * sort->kRadixBits,
+            sort->kHistSize - 1, sort->keys[in] + begin, sort->keys[out], sort->values[in] + begin,
+            sort->values[out], sizeof(uint32_t), end - begin, 0, 0);
+        break;
+    case PARALLEL_PHASE_REVERSE:
+        reverse_copy_u64(sort->keys[0] + sort->size - end, sort->keys[1] + begin,
+            sort->values[0] + sort->size - end, sort->values[1] + begin, sizeof(uint32_t), end - begin);
+        break;
+    }
+}
+
+
+/**
+ * Radix sort 64 bit keys on multiple threads, see parallel_radixsort_u32.
+ */
+static uint32_t parallel_radixsort_u64(const uint32_t kRadixBits, const uint32_t kHistBuckets,
+    const uint32_t kHistSize, uint64_t* restrict keys_in, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in, uint32_t* restrict values_temp, const uint32_t size, uint32_t num_threads)
+{
+    num_threads = parallel_num_threads(num_threads, size);
+    if (num_threads <= 1)
+    {
+        return kRadixBits == RADIX_BITS_8 ?
+            RADIXSORT_ISA_FN(radix8sort_u64)(keys_in, keys_temp, values_in, values_temp, size) :
+            RADIXSORT_ISA_FN(radix11sort_u64)(keys_in, keys_temp, values_in, values_temp, size);
+    }
+
+    struct parallel_sort_u64 sort;
+    sort.hist = (uint32_t*)malloc(sizeof(uint32_t) * num_threads * kHistBuckets * kHistSize);
+    sort.min_key = (uint64_t*)malloc(sizeof(uint64_t) * num_threads * 2);
+    sort.order = (enum key_order*)malloc(sizeof(enum key_order) * num_threads);
+    sort.buffers = (struct scatter_buffers*)malloc(sizeof(struct scatter_buffers) * num_threads);
+    struct parallel_thread* threads = (struct parallel_thread*)malloc(sizeof(struct parallel_thread) * num_threads);
+    if (!sort.hist || !sort.min_key || !sort.order || !sort.buffers || !threads)
+    {
+        free(sort.hist);
+        free(sort.min_key);
+        free(sort.order);
+        free(sort.buffers);
+        free(threads);
+        return kRadixBits == RADIX_BITS_8 ?
+            RADIXSORT_ISA_FN(radix8sort_u64)(keys_in, keys_temp, values_in, values_temp, size) :
+            RADIXSORT_ISA_FN(radix11sort_u64)(keys_in, keys_temp, values_in, values_temp, size);
+    }
+    sort.max_key = sort.min_key + num_threads;
+    sort.kRadixBits = kRadixBits;
+    sort.kHistBuckets = kHistBuckets;
+    sort.kHistSize = kHistSize;
+    sort.keys[0] = keys_in;
+    sort.keys[1] = keys_temp;
+    sort.values[0] = values_in;
+    sort.values[1] = values_temp;
+    sort.size = size;
+    sort.num_threads = num_threads;
+    sort.bucket = 0;
+    sort.in = 0;
+
+    sort.phase = PARALLEL_PHASE_HISTOGRAM;
+    sort.base = 0;
+    sort.num_buckets = kHistBuckets;
+    parallel_for(threads, num_threads, parallel_sort_u64_thread, &sort);
+
+    uint32_t hist[HIST_BUCKETS_64_11 * HIST_SIZE_11];
+    parallel_sum_histograms(hist, sort.hist, num_threads, kHistBuckets, kHistSize, kHistBuckets);
+
+    // combine the key ranges, and the key orders including the keys either
+    // side of each chunk boundary
+    uint64_t min_key = sort.min_key[0];
+    uint64_t max_key = sort.max_key[0];
+    bool ascending = sort.order[0] == KEY_ORDER_ASCENDING;
+    bool descending = sort.order[0] == KEY_ORDER_DESCENDING;
+    for (uint32_t i = 1; i < num_threads; ++i)
+    {
+        min_key = sort.min_key[i] < min_key ? sort.min_key[i] : min_key;
+        max_key = sort.max_key[i] > max_key ? sort.max_key[i] : max_key;
+        const uint32_t begin = chunk_begin(size, num_threads, i);
+        ascending = ascending && sort.order[i] == KEY_ORDER_ASCENDING && keys_in[begin - 1] <= keys_in[begin];
+        descending = descending && sort.order[i] == KEY_ORDER_DESCENDING && keys_in[begin - 1] > keys_in[begin];
+    }
+
+    // already sorted keys are left where they are and strictly descending keys
+    // only need reversing
+    uint32_t out = 0;
+    if (ascending)
+    {
+        out = 0;
+    }
+    else if (descending)
+    {
+        sort.phase = PARALLEL_PHASE_REVERSE;
+        parallel_for(threads, num_threads, parallel_sort_u64_thread, &sort);
+        out = 1;
+    }
+    else
+    {
+        // plan passes exactly as the single threaded sort does so the same
+        // buffer is returned
+        uint32_t passes[HIST_BUCKETS_64_8];
+        uint32_t num_passes = plan_passes(passes, kRadixBits, kHistBuckets, kHistSize, hist, keys_in[0], size);
+
+        const uint32_t num_rebased = rebased_buckets(kRadixBits, max_key - min_key);
+        if (num_rebased < num_passes)
+        {
+            sort.base = min_key;
+            sort.num_buckets = num_rebased;
+            parallel_for(threads, num_threads, parallel_sort_u64_thread, &sort);
+            parallel_sum_histograms(hist, sort.hist, num_threads, kHistBuckets, kHistSize, num_rebased);
+            num_passes = plan_passes(passes, kRadixBits, num_rebased, kHistSize, hist, keys_in[0] - sort.base,
+                size);
+        }
+
+        // the first pass's digits were counted with the histograms
+        const enum radixsort_scatter_mode scatter_mode = resolve_scatter_mode(size, sizeof(uint64_t),
+            sizeof(uint32_t));
+        for (uint32_t i = 0; i < num_threads; ++i)
+        {
+            scatter_buffers_init(sort.buffers + i, scatter_mode, kHistSize, sizeof(uint64_t), sizeof(uint32_t));
+        }
+        for (uint32_t pass = 0; pass < num_passes; ++pass)
+        {
+            sort.in = out;
+            sort.bucket = passes[pass];
+            if (pass > 0)
+            {
+                sort.phase = PARALLEL_PHASE_COUNT;
+                parallel_for(threads, num_threads, parallel_sort_u64_thread, &sort);
+            }
+            parallel_offsets(sort.hist, num_threads, kHistBuckets, kHistSize, sort.bucket);
+            sort.phase = PARALLEL_PHASE_SCATTER;
+            parallel_for(threads, num_threads, parallel_sort_u64_thread, &sort);
+            out = !sort.in;
+        }
+        for (uint32_t i = 0; i < num_threads; ++i)
+        {
+            scatter_buffers_free(sort.buffers + i);
+        }
+    }
+
+    free(sort.hist);
+    free(sort.min_key);
+    free(sort.order);
+    free(sort.buffers);
+    free(threads);
+    return out;
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_parallel_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads)
+{
+    return parallel_radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, keys_in_out, keys_temp,
+        values_in_out, values_temp, size, num_threads, false);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_parallel_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads)
+{
+    return parallel_radixsort_u64(RADIX_BITS_8, HIST_BUCKETS_64_8, HIST_SIZE_8, keys_in_out, keys_temp,
+        values_in_out, values_temp, size, num_threads);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix8sort_parallel_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads)
+{
+    return parallel_radixsort_u32(RADIX_BITS_8, HIST_BUCKETS_32_8, HIST_SIZE_8, (uint32_t*)keys_in_out,
+        (uint32_t*)keys_temp, values_in_out, values_temp, size, num_threads, true);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_parallel_u32)(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads)
+{
+    return parallel_radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, keys_in_out, keys_temp,
+        values_in_out, values_temp, size, num_threads, false);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_parallel_u64)(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads)
+{
+    return parallel_radixsort_u64(RADIX_BITS_11, HIST_BUCKETS_64_11, HIST_SIZE_11, keys_in_out, keys_temp,
+        values_in_out, values_temp, size, num_threads);
+}
+
+
+uint32_t RADIXSORT_ISA_FN(radix11sort_parallel_f32)(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads)
+{
+    return parallel_radixsort_u32(RADIX_BITS_11, HIST_BUCKETS_32_11, HIST_SIZE_11, (uint32_t*)keys_in_out,
+        (uint32_t*)keys_temp, values_in_out, values_temp, size, num_threads, true);
+}
+
+
+enum permute_phase
+{
+    PERMUTE_PHASE_COUNT,
+    PERMUTE_PHASE_PARTITION,
+    PERMUTE_PHASE_GATHER,
+    PERMUTE_PHASE_STAGE,
+    PERMUTE_PHASE_INTERLEAVE,
+};
+
+
+/**
+ * State shared by the threads applying a permutation, along with the column
+ * and phase being run. Columns too large for the cache are gathered through a
+ * partition of the indices by the block of the input they read: each block's
+ * values are gathered in partition order into the staging buffer while the
+ * block is in cache, then interleaved back into output order by reading the
+ * next value of each partition in turn.
+ */
+struct parallel_permute
+{
+    const uint32_t* indices;
+    uint32_t size;
+    uint32_t num_threads;
+    uint32_t shift;
+    uint32_t num_partitions;
+    // indices in partition order, and the offset of each thread's indices in
+    // each partition
+    uint32_t* sources;
+    uint32_t* offsets;
+    void* staging;
+
+    enum permute_phase phase;
+    const void* values_in;
+    void* values_out;
+    size_t value_size;
+};
+
+
+static FORCE_INLINE void permute_values(const struct parallel_permute* restrict permute,
+    const uint32_t thread_index, const size_t value_size)
+{
+    const uint32_t* restrict indices = permute->indices;
+    const uint32_t begin = chunk_begin(permute->size, permute->num_threads, thread_index);
+    const uint32_t end = chunk_begin(permute->size, permute->num_threads, thread_index + 1);
+    const void* restrict values_in = permute->values_in;
+    void* restrict values_out = permute->values_out;
+
+    switch (permute->phase)
+    {
+    case PERMUTE_PHASE_GATHER:
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            copy_value(values_out, i, values_in, indices[i], value_size);
+        }
+        break;
+    case PERMUTE_PHASE_STAGE:
+    {
+        const uint32_t* restrict sources = permute->sources;
+        void* restrict staging = permute->staging;
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            copy_value(staging, i, values_in, sources[i], value_size);
+        }
+        break;
+    }
+    default:
+    {
+        const void* restrict staging = permute->staging;
+        const uint32_t shift = permute->shift;
+        uint32_t cursors[PERMUTE_MAX_PARTITIONS];
+        memcpy(cursors, permute->offsets + (size_t)thread_index * permute->num_partitions,
+            sizeof(uint32_t) * permute->num_partitions);
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            copy_value(values_out, i, staging, cursors[indices[i] >> shift]++, value_size);
+        }
+        break;
+    }
+    }
+}
+
+
+static void parallel_permute_thread(void* context, const uint32_t thread_index)
+{
+    struct parallel_permute* permute = (struct parallel_permute*)context;
+    const uint32_t* restrict indices = permute->indices;
+    const uint32_t begin = chunk_begin(permute->size, permute->num_threads, thread_index);
+    const uint32_t end = chunk_begin(permute->size, permute->num_threads, thread_index + 1);
+    const uint32_t shift = permute->shift;
+    uint32_t* restrict offsets = permute->offsets + (size_t)thread_index * permute->num_partitions;
+
+    switch (permute->phase)
+    {
+    case PERMUTE_PHASE_COUNT:
+        memset(offsets, 0, sizeof(uint32_t) * permute->num_partitions);
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            ++offsets[indices[i] >> shift];
+        }
+        break;
+    case PERMUTE_PHASE_PARTITION:
+    {
+        uint32_t* restrict sources = permute->sources;
+        uint32_t cursors[PERMUTE_MAX_PARTITIONS];
+        memcpy(cursors, offsets, sizeof(uint32_t) * permute->num_partitions);
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const uint32_t index = indices[i];
+            sources[cursors[index >> shift]++] = index;
+        }
+        break;
+    }
+    default:
+        DISPATCH_VALUE_SIZE(permute->value_size, permute_values(permute, thread_index, kValueSize));
+        break;
+    }
+}
+
+
+void RADIXSORT_ISA_FN(radixsort_apply_permutation)(const uint32_t* restrict indices, uint32_t size,
+    const struct radixsort_permutation_column* columns, uint32_t num_columns, uint32_t num_threads)
+{
+    struct parallel_permute permute;
+    permute.indices = indices;
+    permute.size = size;
+    permute.num_threads = parallel_num_threads(num_threads, size);
+    if (permute.num_threads < 1)
+    {
+        permute.num_threads = 1;
+    }
+    permute.shift = 0;
+    permute.num_partitions = 0;
+    permute.sources = NULL;
+    permute.offsets = NULL;
+    permute.staging = NULL;
+
+    size_t max_value_size = 0;
+    for (uint32_t column = 0; column < num_columns; ++column)
+    {
+        const size_t value_size = columns[column].value_size;
+        if ((uint64_t)size * value_size >= PERMUTE_PARTITION_MIN_BYTES && value_size > max_value_size)
+        {
+            max_value_size = value_size;
+        }
+    }
+
+    struct parallel_thread* threads = NULL;
+    if (permute.num_threads > 1)
+    {
+        threads = (struct parallel_thread*)malloc(sizeof(struct parallel_thread) * permute.num_threads);
+        if (!threads)
+        {
+            permute.num_threads = 1;
+        }
+    }
+
+    if (max_value_size != 0)
+    {
+        while (((uint64_t)2 << permute.shift) * max_value_size <= PERMUTE_BLOCK_BYTES)
+        {
+            ++permute.shift;
+        }
+        while (((size - 1) >> permute.shift) + 1 > PERMUTE_MAX_PARTITIONS)
+        {
+            ++permute.shift;
+        }
+        permute.num_partitions = ((size - 1) >> permute.shift) + 1;
+        permute.sources = (uint32_t*)malloc(sizeof(uint32_t) * size);
+        permute.offsets = (uint32_t*)malloc(sizeof(uint32_t) * permute.num_threads * permute.num_partitions);
+        permute.staging = malloc((size_t)size * max_value_size);
+        if (permute.sources && permute.offsets && permute.staging)
+        {
+            permute.phase = PERMUTE_PHASE_COUNT;
+            parallel_for(threads, permute.num_threads, parallel_permute_thread, &permute);
+
+            // each thread's indices follow those of earlier threads in each
+            // partition, so partitions keep the order of the output
+            uint32_t offset = 0;
+            for (uint32_t partition = 0; partition < permute.num_partitions; ++partition)
+            {
+                for (uint32_t thread_index = 0; thread_index < permute.num_threads; ++thread_index)
+                {
+                    uint32_t* restrict entry = permute.offsets + (thread_index * permute.num_partitions) + partition;
+                    const uint32_t count = *entry;
+                    *entry = offset;
+                    offset += count;
+                }
+            }
+
+            permute.phase = PERMUTE_PHASE_PARTITION;
+            parallel_for(threads, permute.num_threads, parallel_permute_thread, &permute);
+        }
+        else
+        {
+            // gather every column directly if the buffers can't be allocated
+            free(permute.sources);
+            free(permute.offsets);
+            free(permute.staging);
+            permute.sources = NULL;
+            permute.offsets = NULL;
+            permute.staging = NULL;
+        }
+    }
+
+    for (uint32_t column = 0; column < num_columns; ++column)
+    {
+        permute.values_in = columns[column].values_in;
+        permute.values_out = columns[column].values_out;
+        permute.value_size = columns[column].value_size;
+        if (permute.staging && (uint64_t)size * permute.value_size >= PERMUTE_PARTITION_MIN_BYTES)
+        {
+            permute.phase = PERMUTE_PHASE_STAGE;
+            parallel_for(threads, permute.num_threads, parallel_permute_thread, &permute);
+            permute.phase = PERMUTE_PHASE_INTERLEAVE;
+        }
+        else
+        {
+            permute.phase = PERMUTE_PHASE_GATHER;
+        }
+        parallel_for(threads, permute.num_threads, parallel_permute_thread, &permute);
+    }
+
+    free(permute.sources);
+    free(permute.offsets);
+    free(permute.staging);
+    free(threads);
 }
+
+
+#define RADIXSORT_ISA_ENTRY_R(type, name, params, args) RADIXSORT_ISA_FN(name),
+#define RADIXSORT_ISA_ENTRY_V(name, params, args) RADIXSORT_ISA_FN(name),
+
+const struct radixsort_isa_table RADIXSORT_ISA_FN(radixsort_isa_table) =
+{
+    RADIXSORT_ISA_FUNCTIONS(RADIXSORT_ISA_ENTRY_R, RADIXSORT_ISA_ENTRY_V)
+    RADIXSORT_ISA_INTERNAL_FUNCTIONS(RADIXSORT_ISA_ENTRY_R, RADIXSORT_ISA_ENTRY_V)
+};
@@ -55,6 +55,60 @@
 extern "C" {
 #endif
 
+/* How each radix pass writes keys and values to their output positions.
+ * RADIXSORT_SCATTER_AUTO picks by array size, RADIXSORT_SCATTER_DIRECT writes
+ * each key straight to its position, RADIXSORT_SCATTER_BUFFERED stages a cache
+ * line of keys per digit and writes whole lines, and
+ * RADIXSORT_SCATTER_STREAMING also writes the whole lines with non-temporal
+ * stores which bypass the cache. RADIXSORT_SCATTER_BLOCK partitions blocks of
+ * keys by digit in a buffer which stays in cache and copies each digit's run
+ * of the block to its position. */
+enum radixsort_scatter_mode
+{
+    RADIXSORT_SCATTER_AUTO,
+    RADIXSORT_SCATTER_DIRECT,
+    RADIXSORT_SCATTER_BUFFERED,
+    RADIXSORT_SCATTER_STREAMING,
+    RADIXSORT_SCATTER_BLOCK
+};
+
+/* Set the scatter mode used by the LSD radix sorts. This is a process wide
+ * setting which should not be changed while sorts are running on other
+ * threads. */
+RADIXSORT_C_API void radixsort_set_scatter_mode(enum radixsort_scatter_mode scatter_mode);
+
+RADIXSORT_C_API enum radixsort_scatter_mode radixsort_get_scatter_mode(void);
+
+/* Instruction set levels the sorts are built for. The library picks the
+ * highest level the CPU supports when it is loaded. RADIXSORT_ISA_AVX512 needs
+ * the AVX-512 F, BW, DQ and VL extensions. */
+enum radixsort_isa
+{
+    RADIXSORT_ISA_AUTO,
+    RADIXSORT_ISA_BASELINE,
+    RADIXSORT_ISA_AVX2,
+    RADIXSORT_ISA_AVX512
+};
+
+/* Select the instruction set level used by every sort, for example to compare
+ * levels. Levels the CPU or the build don't support fall back to the highest
+ * one which is supported, as does RADIXSORT_ISA_AUTO, and the level selected
+ * is returned. This is a process wide setting which may be changed while sorts
+ * are running on other threads: sorts already running finish on the level
+ * they started with, and sorts called afterwards use the new level. */
+RADIXSORT_C_API enum radixsort_isa radixsort_set_isa(enum radixsort_isa isa);
+
+/* The instruction set level currently used, never RADIXSORT_ISA_AUTO. */
+RADIXSORT_C_API enum radixsort_isa radixsort_get_isa(void);
+
+/* The signed sorts take each digit from the key with its sign bit flipped,
+ * which costs nothing over the unsigned sorts as the flip is folded into the
+ * digit extraction rather than written out.
+ *
+ * The float and double sorts order keys by their bits with the sign bit
+ * flipped, or every bit for negative keys, which matches the IEEE 754 total
+ * order: -NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN, where NaNs of the
+ * same sign are ordered by their payload. */
 RADIXSORT_C_API uint32_t radix8sort_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
     uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size);
 
@@ -64,6 +118,15 @@ RADIXSORT_C_API uint32_t radix8sort_u64(uint64_t* restrict keys_in_out, uint64_t
 RADIXSORT_C_API uint32_t radix8sort_f32(float* restrict keys_in_out, float* restrict keys_temp,
     uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
 
+RADIXSORT_C_API uint32_t radix8sort_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
 RADIXSORT_C_API uint32_t radix11sort_u32(uint32_t* restrict keys_in, uint32_t* restrict keys_out,
     uint32_t* restrict values_in, uint32_t* restrict values_out, uint32_t size);
 
@@ -73,6 +136,330 @@ RADIXSORT_C_API uint32_t radix11sort_u64(uint64_t* restrict keys_in_out, uint64_
 RADIXSORT_C_API uint32_t radix11sort_f32(float* restrict keys_in, float* restrict keys_out,
     uint32_t* restrict values_in, uint32_t* restrict values_out, uint32_t size);
 
+RADIXSORT_C_API uint32_t radix11sort_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+/* Radix sort keys into descending order, in the same order as the ascending
+ * sorts reversed except that equal keys keep their order. The histogram
+ * offsets are reversed rather than the keys, so these cost the same as the
+ * ascending sorts. */
+RADIXSORT_C_API uint32_t radix8sort_desc_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_desc_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_desc_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_desc_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_desc_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_desc_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_desc_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_desc_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_desc_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_desc_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_desc_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_desc_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+/* Radix sort keys without values, returning the buffer holding the sorted
+ * keys like the radix sorts. Each pass only moves keys, so these read and
+ * write half the memory of sorting 32 bit keys with their values. */
+RADIXSORT_C_API uint32_t radix8sort_keys_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_keys_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_keys_f32(float* restrict keys_in_out, float* restrict keys_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_keys_f64(double* restrict keys_in_out, double* restrict keys_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_keys_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_keys_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_keys_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_keys_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_keys_f32(float* restrict keys_in_out, float* restrict keys_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_keys_f64(double* restrict keys_in_out, double* restrict keys_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_keys_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_keys_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp, uint32_t size);
+
+/* Radix sort keys and write the permutation which sorts them, the index in
+ * the input of each sorted key, to the index buffers, returning the buffer
+ * holding the sorted data like the radix sorts. Indices are made on the first
+ * pass rather than read from an array filled with 0 to size - 1, and if
+ * sort_keys is 0 the last pass doesn't write keys, leaving both key buffers in
+ * an unspecified order. */
+RADIXSORT_C_API uint32_t radix8argsort_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+RADIXSORT_C_API uint32_t radix8argsort_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+RADIXSORT_C_API uint32_t radix8argsort_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+RADIXSORT_C_API uint32_t radix8argsort_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+RADIXSORT_C_API uint32_t radix8argsort_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+RADIXSORT_C_API uint32_t radix8argsort_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+RADIXSORT_C_API uint32_t radix11argsort_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+RADIXSORT_C_API uint32_t radix11argsort_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+RADIXSORT_C_API uint32_t radix11argsort_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+RADIXSORT_C_API uint32_t radix11argsort_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+RADIXSORT_C_API uint32_t radix11argsort_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+RADIXSORT_C_API uint32_t radix11argsort_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys);
+
+/* Radix sort keys with 64 bit values, returning the buffer holding the sorted
+ * data like the radix sorts. */
+RADIXSORT_C_API uint32_t radix8sort_values64_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_values64_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_values64_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_values64_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_values64_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix8sort_values64_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_values64_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_values64_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_values64_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_values64_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_values64_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t radix11sort_values64_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size);
+
+/* Radix sort keys with values of value_size bytes, returning the buffer
+ * holding the sorted data like the radix sorts. Values of 1, 2, 4 and 8 bytes
+ * are moved as integers and other sizes with memcpy. Values larger than 8
+ * bytes are always scattered directly, as the staging buffers of the other
+ * scatter modes would no longer fit in cache. */
+RADIXSORT_C_API uint32_t radix8sort_values_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix8sort_values_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix8sort_values_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix8sort_values_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix8sort_values_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix8sort_values_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_values_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_values_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_values_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_values_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_values_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_values_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size);
+
+/* Radix sort keys with values of value_size bytes like radix8sort_values_u32
+ * and friends, or keys only when the value buffers are null, for arrays of
+ * any size. Arrays of up to UINT32_MAX keys are sorted by those sorts with
+ * their 32 bit histogram counts. Larger arrays are counted in 64 bit
+ * histograms, twice the size, and every pass scatters directly. */
+RADIXSORT_C_API uint32_t radix8sort_size64_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix8sort_size64_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix8sort_size64_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix8sort_size64_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix8sort_size64_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix8sort_size64_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_size64_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_size64_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_size64_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_size64_f64(double* restrict keys_in_out, double* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_size64_i32(int32_t* restrict keys_in_out, int32_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+RADIXSORT_C_API uint32_t radix11sort_size64_i64(int64_t* restrict keys_in_out, int64_t* restrict keys_temp,
+    void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size);
+
+/* Counting sort 8 and 16 bit keys, in a single pass over a histogram of every
+ * key value, returning the buffer holding the sorted data like the radix
+ * sorts. 16 bit keys are sorted in two passes of 8 bit digits below 65536
+ * keys, and in one pass above it with a 256KB histogram which is allocated;
+ * if that fails they are also sorted in two passes. */
+RADIXSORT_C_API uint32_t counting_sort_u8(uint8_t* restrict keys_in_out, uint8_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t counting_sort_i8(int8_t* restrict keys_in_out, int8_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t counting_sort_u16(uint16_t* restrict keys_in_out, uint16_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t counting_sort_i16(int16_t* restrict keys_in_out, int16_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+/* Counting sort IEEE 754 binary16 (half float) and bfloat16 keys, passed as
+ * their bit patterns, in the same total order as the float sorts and the same
+ * one or two passes as counting_sort_u16. */
+RADIXSORT_C_API uint32_t counting_sort_f16(uint16_t* restrict keys_in_out, uint16_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+RADIXSORT_C_API uint32_t counting_sort_bf16(uint16_t* restrict keys_in_out, uint16_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size);
+
+/* Radix sort on multiple threads, which returns the same result as the
+ * single threaded sort. A num_threads of 0 uses one thread per hardware
+ * thread; arrays too small to be worth splitting use fewer threads. Unlike the
+ * single threaded sorts this allocates memory for the threads and their
+ * histograms, falling back to the single threaded sort if that fails. */
+RADIXSORT_C_API uint32_t radix8sort_parallel_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads);
+
+RADIXSORT_C_API uint32_t radix8sort_parallel_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads);
+
+RADIXSORT_C_API uint32_t radix8sort_parallel_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads);
+
+RADIXSORT_C_API uint32_t radix11sort_parallel_u32(uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads);
+
+RADIXSORT_C_API uint32_t radix11sort_parallel_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads);
+
+RADIXSORT_C_API uint32_t radix11sort_parallel_f32(float* restrict keys_in_out, float* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads);
+
+/* Most significant digit first radix sort for large arrays, which partitions
+ * on the highest varying digit until partitions fit in cache then finishes
+ * them with the LSD radix sort. */
+RADIXSORT_C_API uint32_t radixsort_msd_u64(uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp,
+    uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size);
+
+/* In place radix sort, which sorts keys and values without temporary buffers.
+ * This sort is not stable: values with equal keys may be reordered. */
+RADIXSORT_C_API void radixsort_inplace_u32(uint32_t* restrict keys_in_out, uint32_t* restrict values_in_out,
+    uint32_t size);
+
+RADIXSORT_C_API void radixsort_inplace_u64(uint64_t* restrict keys_in_out, uint32_t* restrict values_in_out,
+    uint32_t size);
+
+RADIXSORT_C_API void radixsort_inplace_f32(float* restrict keys_in_out, uint32_t* restrict values_in_out,
+    uint32_t size);
+
+/* A column of values for radixsort_apply_permutation, value_size bytes each. */
+struct radixsort_permutation_column
+{
+    const void* values_in;
+    void* values_out;
+    size_t value_size;
+};
+
+/* Reorder columns of values by a permutation, such as the indices of an
+ * argsort, writing values_out[i] = values_in[indices[i]] for each column.
+ * Every index must be less than size, and each column's buffers must not
+ * overlap. Columns too large for the cache are gathered through a partition
+ * of the indices by the block of the input they read, made once for every
+ * column, so values are read and written in order rather than missing the
+ * cache on each value. A num_threads of 0 uses one thread per hardware
+ * thread. This allocates a buffer as large as the largest such column, and
+ * gathers directly if that fails. */
+RADIXSORT_C_API void radixsort_apply_permutation(const uint32_t* restrict indices, uint32_t size,
+    const struct radixsort_permutation_column* columns, uint32_t num_columns, uint32_t num_threads);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2014 Cameron Hart
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include "radixsort_isa.h"
+
+#if defined(RADIXSORT_HAVE_AVX2) || defined(RADIXSORT_HAVE_AVX512)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <stdatomic.h>
+#endif
+
+enum radixsort_scatter_mode radixsort_scatter_mode_setting = RADIXSORT_SCATTER_AUTO;
+
+/* An instruction set level and the table of its sorts. */
+struct isa_level
+{
+    enum radixsort_isa isa;
+    const struct radixsort_isa_table* table;
+};
+
+/* The level selected, null until the first selection. It is published with a
+ * release store and read with an acquire load, so a sort on another thread
+ * always reads a complete level, and a level changed while sorts are running
+ * only applies to the sorts called after it. */
+#if defined(_MSC_VER)
+static const struct isa_level* volatile isa_selected = NULL;
+#else
+static _Atomic(const struct isa_level*) isa_selected = NULL;
+#endif
+
+
+static inline const struct isa_level* load_isa_level(void)
+{
+#if defined(_MSC_VER)
+    return (const struct isa_level*)InterlockedCompareExchangePointer((PVOID volatile*)&isa_selected, NULL, NULL);
+#else
+    return atomic_load_explicit(&isa_selected, memory_order_acquire);
+#endif
+}
+
+
+static inline void store_isa_level(const struct isa_level* level)
+{
+#if defined(_MSC_VER)
+    InterlockedExchangePointer((PVOID volatile*)&isa_selected, (PVOID)level);
+#else
+    atomic_store_explicit(&isa_selected, level, memory_order_release);
+#endif
+}
+
+
+/**
+ * Store the level if none has been selected yet, returning the level which
+ * is then selected, so selecting the default on first use never replaces a
+ * level set on another thread.
+ */
+static inline const struct isa_level* store_isa_level_once(const struct isa_level* level)
+{
+#if defined(_MSC_VER)
+    const struct isa_level* prev = (const struct isa_level*)InterlockedCompareExchangePointer(
+        (PVOID volatile*)&isa_selected, (PVOID)level, NULL);
+#else
+    const struct isa_level* prev = NULL;
+    atomic_compare_exchange_strong_explicit(&isa_selected, &prev, level, memory_order_acq_rel,
+        memory_order_acquire);
+#endif
+    return prev != NULL ? prev : level;
+}
+
+#if defined(RADIXSORT_HAVE_AVX2) || defined(RADIXSORT_HAVE_AVX512)
+static void cpuid(const uint32_t leaf, uint32_t* restrict regs)
+{
+#if defined(_MSC_VER)
+    __cpuidex((int*)regs, (int)leaf, 0);
+#else
+    __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+
+/**
+ * Read the register state the OS saves on context switches, which must
+ * include the vector registers before they can be used.
+ */
+static uint64_t xgetbv(void)
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+#endif
+}
+#endif
+
+
+/**
+ * Find the highest instruction set level which is both built and supported
+ * by the CPU and OS.
+ */
+static enum radixsort_isa supported_isa(void)
+{
+#if defined(RADIXSORT_HAVE_AVX2) || defined(RADIXSORT_HAVE_AVX512)
+    uint32_t regs[4];
+    cpuid(0, regs);
+    if (regs[0] < 7)
+    {
+        return RADIXSORT_ISA_BASELINE;
+    }
+
+    /* AVX needs the OS to save the YMM registers, bits 1 and 2 of XCR0 */
+    cpuid(1, regs);
+    const uint32_t kOSXSave = 1u << 27, kAVX = 1u << 28;
+    if ((regs[2] & (kOSXSave | kAVX)) != (kOSXSave | kAVX) || (xgetbv() & 0x6) != 0x6)
+    {
+        return RADIXSORT_ISA_BASELINE;
+    }
+
+    cpuid(7, regs);
+    const uint32_t ebx = regs[1];
+    enum radixsort_isa isa = RADIXSORT_ISA_BASELINE;
+#if defined(RADIXSORT_HAVE_AVX2)
+    const uint32_t kAVX2 = 1u << 5;
+    if (ebx & kAVX2)
+    {
+        isa = RADIXSORT_ISA_AVX2;
+    }
+#endif
+#if defined(RADIXSORT_HAVE_AVX512)
+    /* AVX-512 also needs the opmask and ZMM registers saved, bits 5 to 7 */
+    const uint32_t kAVX512 = (1u << 16) | (1u << 17) | (1u << 30) | (1u << 31); /* F, DQ, BW, VL */
+    if ((ebx & kAVX512) == kAVX512 && (xgetbv() & 0xe6) == 0xe6)
+    {
+        isa = RADIXSORT_ISA_AVX512;
+    }
+#endif
+    return isa;
+#else
+    return RADIXSORT_ISA_BASELINE;
+#endif
+}
+
+
+/**
+ * Find the level to use for the requested one, falling back to the highest
+ * supported level for RADIXSORT_ISA_AUTO and levels which aren't supported.
+ */
+static const struct isa_level* find_isa_level(enum radixsort_isa isa)
+{
+    static const struct isa_level baseline = {RADIXSORT_ISA_BASELINE, &radixsort_isa_table_baseline};
+#if defined(RADIXSORT_HAVE_AVX2)
+    static const struct isa_level avx2 = {RADIXSORT_ISA_AVX2, &radixsort_isa_table_avx2};
+#endif
+#if defined(RADIXSORT_HAVE_AVX512)
+    static const struct isa_level avx512 = {RADIXSORT_ISA_AVX512, &radixsort_isa_table_avx512};
+#endif
+
+    const enum radixsort_isa supported = supported_isa();
+    if (isa == RADIXSORT_ISA_AUTO || isa > supported)
+    {
+        isa = supported;
+    }
+    switch (isa)
+    {
+#if defined(RADIXSORT_HAVE_AVX2)
+    case RADIXSORT_ISA_AVX2:
+        return &avx2;
+#endif
+#if defined(RADIXSORT_HAVE_AVX512)
+    case RADIXSORT_ISA_AVX512:
+        return &avx512;
+#endif
+    default:
+        return &baseline;
+    }
+}
+
+
+enum radixsort_isa radixsort_set_isa(enum radixsort_isa isa)
+{
+    const struct isa_level* level = find_isa_level(isa);
+    store_isa_level(level);
+    return level->isa;
+}
+
+
+/**
+ * Get the selected level, selecting the highest supported one if none has
+ * been selected yet.
+ */
+static inline const struct isa_level* current_isa_level(void)
+{
+    const struct isa_level* level = load_isa_level();
+    return level != NULL ? level : store_isa_level_once(find_isa_level(RADIXSORT_ISA_AUTO));
+}
+
+
+enum radixsort_isa radixsort_get_isa(void)
+{
+    return current_isa_level()->isa;
+}
+
+
+/**
+ * Select the level when the library is loaded where the compiler allows it,
+ * otherwise the first sort selects it.
+ */
+#if defined(__GNUC__)
+__attribute__((constructor)) static void init_isa(void)
+{
+    current_isa_level();
+}
+#endif
+
+
+static inline const struct radixsort_isa_table* current_isa_table(void)
+{
+    return current_isa_level()->table;
+}
+
+
+void radixsort_set_scatter_mode(enum radixsort_scatter_mode scatter_mode)
+{
+    radixsort_scatter_mode_setting = scatter_mode;
+}
+
+
+enum radixsort_scatter_mode radixsort_get_scatter_mode(void)
+{
+    return radixsort_scatter_mode_setting;
+}
+
+
+#define RADIXSORT_ISA_DISPATCH_R(type, name, params, args) \
+    type name params \
+    { \
+        return current_isa_table()->name args; \
+    }
+#define RADIXSORT_ISA_DISPATCH_V(name, params, args) \
+    void name params \
+    { \
+        current_isa_table()->name args; \
+    }
+
+RADIXSORT_ISA_FUNCTIONS(RADIXSORT_ISA_DISPATCH_R, RADIXSORT_ISA_DISPATCH_V)
+RADIXSORT_ISA_INTERNAL_FUNCTIONS(RADIXSORT_ISA_DISPATCH_R, RADIXSORT_ISA_DISPATCH_V)
@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2014 Cameron Hart
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef BITS_RADIXSORT_ISA_H
+#define BITS_RADIXSORT_ISA_H
+
+/* Private to the C library. radixsort.c is compiled once for each instruction
+ * set level, with RADIXSORT_ISA_SUFFIX naming the level, and
+ * radixsort_dispatch.c defines the public functions which call the level
+ * selected at runtime through a table of function pointers. */
+
+#include "radixsort.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RADIXSORT_ISA_CONCAT_(name, suffix) name##_##suffix
+#define RADIXSORT_ISA_CONCAT(name, suffix) RADIXSORT_ISA_CONCAT_(name, suffix)
+
+/* Every public sort function, as V(name, params, args) for those returning
+ * void and R(type, name, params, args) for the others. Adding a function here
+ * adds it to the table, which radixsort.c must then define as
+ * RADIXSORT_ISA_FN(name). */
+#define RADIXSORT_ISA_FUNCTIONS(R, V) \
+    R(uint32_t, radix8sort_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_u32, (uint32_t* restrict keys_in, uint32_t* restrict keys_out, \
+        uint32_t* restrict values_in, uint32_t* restrict values_out, uint32_t size), \
+        (keys_in, keys_out, values_in, values_out, size)) \
+    R(uint32_t, radix11sort_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_f32, (float* restrict keys_in, float* restrict keys_out, \
+        uint32_t* restrict values_in, uint32_t* restrict values_out, uint32_t size), \
+        (keys_in, keys_out, values_in, values_out, size)) \
+    R(uint32_t, radix11sort_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_desc_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_desc_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_desc_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_desc_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_desc_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_desc_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_desc_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_desc_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_desc_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_desc_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_desc_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_desc_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_keys_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix8sort_keys_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix8sort_keys_f32, (float* restrict keys_in_out, float* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix8sort_keys_f64, (double* restrict keys_in_out, double* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix8sort_keys_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix8sort_keys_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix11sort_keys_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix11sort_keys_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix11sort_keys_f32, (float* restrict keys_in_out, float* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix11sort_keys_f64, (double* restrict keys_in_out, double* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix11sort_keys_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix11sort_keys_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, uint32_t size), \
+        (keys_in_out, keys_temp, size)) \
+    R(uint32_t, radix8argsort_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix8argsort_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix8argsort_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix8argsort_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix8argsort_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix8argsort_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix11argsort_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix11argsort_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix11argsort_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix11argsort_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix11argsort_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix11argsort_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        uint32_t* restrict indices_out, uint32_t* restrict indices_temp, uint32_t size, int sort_keys), \
+        (keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys)) \
+    R(uint32_t, radix8sort_values64_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_values64_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_values64_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_values64_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_values64_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_values64_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_values64_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_values64_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_values64_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_values64_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_values64_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix11sort_values64_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        uint64_t* restrict values_in_out, uint64_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_values_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_values_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_values_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_values_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_values_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_values_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_values_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_values_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_values_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_values_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_values_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_values_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, uint32_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_size64_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_size64_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_size64_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_size64_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_size64_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_size64_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, counting_sort_u8, (uint8_t* restrict keys_in_out, uint8_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, counting_sort_i8, (int8_t* restrict keys_in_out, int8_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, counting_sort_u16, (uint16_t* restrict keys_in_out, uint16_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, counting_sort_i16, (int16_t* restrict keys_in_out, int16_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, counting_sort_f16, (uint16_t* restrict keys_in_out, uint16_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, counting_sort_bf16, (uint16_t* restrict keys_in_out, uint16_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    R(uint32_t, radix8sort_parallel_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads)) \
+    R(uint32_t, radix8sort_parallel_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads)) \
+    R(uint32_t, radix8sort_parallel_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads)) \
+    R(uint32_t, radix11sort_parallel_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads)) \
+    R(uint32_t, radix11sort_parallel_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads)) \
+    R(uint32_t, radix11sort_parallel_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* restrict values_temp, uint32_t size, uint32_t num_threads), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads)) \
+    R(uint32_t, radixsort_msd_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        uint32_t* restrict values_in_out, uint32_t* values_temp, uint32_t size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size)) \
+    V(radixsort_inplace_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict values_in_out, uint32_t size), \
+        (keys_in_out, values_in_out, size)) \
+    V(radixsort_inplace_u64, (uint64_t* restrict keys_in_out, uint32_t* restrict values_in_out, uint32_t size), \
+        (keys_in_out, values_in_out, size)) \
+    V(radixsort_inplace_f32, (float* restrict keys_in_out, uint32_t* restrict values_in_out, uint32_t size), \
+        (keys_in_out, values_in_out, size)) \
+    V(radixsort_apply_permutation, (const uint32_t* restrict indices, uint32_t size, \
+        const struct radixsort_permutation_column* columns, uint32_t num_columns, uint32_t num_threads), \
+        (indices, size, columns, num_columns, num_threads))
+
+/* Internal sorts in the table, as RADIXSORT_ISA_FUNCTIONS, which
+ * radixsort_dispatch.c defines for the tests but radixsort.h doesn't declare.
+ * The size64 counts sorts always count in 64 bit histograms, which the public
+ * size64 sorts only do for more than UINT32_MAX keys. */
+#define RADIXSORT_ISA_INTERNAL_FUNCTIONS(R, V) \
+    R(uint32_t, radix8sort_size64_counts_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_size64_counts_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_size64_counts_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_size64_counts_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_size64_counts_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix8sort_size64_counts_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_counts_u32, (uint32_t* restrict keys_in_out, uint32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_counts_u64, (uint64_t* restrict keys_in_out, uint64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_counts_f32, (float* restrict keys_in_out, float* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_counts_f64, (double* restrict keys_in_out, double* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_counts_i32, (int32_t* restrict keys_in_out, int32_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size)) \
+    R(uint32_t, radix11sort_size64_counts_i64, (int64_t* restrict keys_in_out, int64_t* restrict keys_temp, \
+        void* restrict values_in_out, void* restrict values_temp, size_t size, size_t value_size), \
+        (keys_in_out, keys_temp, values_in_out, values_temp, size, value_size))
+
+#define RADIXSORT_ISA_FIELD_R(type, name, params, args) type (*name) params;
+#define RADIXSORT_ISA_FIELD_V(name, params, args) void (*name) params;
+
+struct radixsort_isa_table
+{
+    RADIXSORT_ISA_FUNCTIONS(RADIXSORT_ISA_FIELD_R, RADIXSORT_ISA_FIELD_V)
+    RADIXSORT_ISA_INTERNAL_FUNCTIONS(RADIXSORT_ISA_FIELD_R, RADIXSORT_ISA_FIELD_V)
+};
+
+/* the table of each level built, defined by its copy of radixsort.c */
+extern const struct radixsort_isa_table radixsort_isa_table_baseline;
+#if defined(RADIXSORT_HAVE_AVX2)
+extern const struct radixsort_isa_table radixsort_isa_table_avx2;
+#endif
+#if defined(RADIXSORT_HAVE_AVX512)
+extern const struct radixsort_isa_table radixsort_isa_table_avx512;
+#endif
+
+/* settings shared by every level, defined in radixsort_dispatch.c */
+extern enum radixsort_scatter_mode radixsort_scatter_mode_setting;
+
+/* the internal sorts of the level selected, defined in radixsort_dispatch.c */
+#define RADIXSORT_ISA_INTERNAL_DECLARE_R(type, name, params, args) type name params;
+#define RADIXSORT_ISA_INTERNAL_DECLARE_V(name, params, args) void name params;
+RADIXSORT_ISA_INTERNAL_FUNCTIONS(RADIXSORT_ISA_INTERNAL_DECLARE_R, RADIXSORT_ISA_INTERNAL_DECLARE_V)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BITS_RADIXSORT_ISA_H
@@ -20,39 +20,609 @@
 #ifndef BITS_RADIXSORT_HPP
 #define BITS_RADIXSORT_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <utility>
 
 namespace bits
 {
 
+/**
+ * How radix passes scatter keys and values to their sorted positions. Values
+ * larger than 8 bytes are always scattered directly, as the buffers of the
+ * other modes would no longer fit in cache. The buffers are allocated on the
+ * heap once per sort, and a sort which can't allocate them scatters directly.
+ */
+enum ScatterMode
+{
+    // write directly for small arrays and streaming for large ones
+    kScatterAuto,
+    // write each key and value straight to its destination
+    kScatterDirect,
+    // stage keys and values in a cache line sized buffer per digit and write
+    // whole lines at once, which keeps far fewer lines and pages in use once
+    // arrays no longer fit in cache
+    kScatterBuffered,
+    // as buffered, but write whole lines with non-temporal stores which
+    // bypass the cache
+    kScatterStreaming,
+    // partition blocks of keys and values by digit in a buffer that stays in
+    // cache, then copy each digit's run of the block to its destination
+    kScatterBlock,
+};
+
+/**
+ * Radix sort keys and values, returning the buffer holding the sorted data, 0
+ * for the in_out buffers and 1 for the temp buffers. The scatter mode picks
+ * how each radix pass writes its output. Signed keys have their sign bit
+ * flipped as digits are taken from them, so they sort as fast as unsigned
+ * keys. Float and double keys follow the IEEE 754 total order, -NaN < -inf <
+ * -0 < +0 < +inf < +NaN, with NaNs of the same sign ordered by their payload.
+ */
 template <typename ValueType>
 uint32_t radix8sort(uint32_t* __restrict keys_in_out,
     uint32_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* values_temp,
-    uint32_t size);
+    uint32_t size, ScatterMode scatter_mode = kScatterAuto);
 
 template <typename ValueType>
 uint32_t radix8sort(uint64_t* __restrict keys_in_out,
     uint64_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* values_temp,
-    uint32_t size);
+    uint32_t size, ScatterMode scatter_mode = kScatterAuto);
 
 template <typename ValueType>
 uint32_t radix8sort(float* __restrict keys_in_out, float* __restrict keys_temp,
-    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size);
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort(double* __restrict keys_in_out, double* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
 
 template <typename ValueType>
 uint32_t radix11sort(uint32_t* __restrict keys_in_out,
     uint32_t* __restrict keys_temp, ValueType* __restrict values_in_out,
-    ValueType* __restrict values_temp, uint32_t size);
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode = kScatterAuto);
 
 template <typename ValueType>
 uint32_t radix11sort(uint64_t* __restrict keys_in,
     uint64_t* __restrict keys_out, ValueType* __restrict values_in,
-    ValueType* __restrict values_out, uint32_t size);
+    ValueType* __restrict values_out, uint32_t size, ScatterMode scatter_mode = kScatterAuto);
 
 template <typename ValueType>
 uint32_t radix11sort(float* __restrict keys_in_out, float* __restrict keys_temp,
-    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size);
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort(double* __restrict keys_in_out, double* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+/**
+ * Radix sort keys without values, returning the buffer holding the sorted keys
+ * like radix8sort. Each pass only reads and writes keys, so this moves half the
+ * memory of sorting 32 bit keys with 32 bit values.
+ */
+uint32_t radix8sort(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8sort(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8sort(float* __restrict keys_in_out, float* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8sort(double* __restrict keys_in_out, double* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8sort(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8sort(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort(float* __restrict keys_in_out, float* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort(double* __restrict keys_in_out, double* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+/**
+ * Radix sort keys and write the permutation which sorts them, the index in the
+ * input of each sorted key, to the index buffers, returning the buffer holding
+ * the sorted data like radix8sort. Indices are made on the first pass instead
+ * of being read from an array filled with 0 to size - 1, and when sort_keys is
+ * false the last pass doesn't write keys, leaving both key buffers in an
+ * unspecified order.
+ */
+uint32_t radix8argsort(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8argsort(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8argsort(float* __restrict keys_in_out, float* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8argsort(double* __restrict keys_in_out, double* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8argsort(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8argsort(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11argsort(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11argsort(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11argsort(float* __restrict keys_in_out, float* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11argsort(double* __restrict keys_in_out, double* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11argsort(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11argsort(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys = true,
+    ScatterMode scatter_mode = kScatterAuto);
+
+/**
+ * Radix sort keys and values into descending order, returning the buffer
+ * holding the sorted data like radix8sort. Keys are inverted as digits are
+ * taken from them, so this costs the same as the ascending sort and equal keys
+ * keep their order.
+ */
+template <typename ValueType>
+uint32_t radix8sort_desc(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_desc(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_desc(float* __restrict keys_in_out, float* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_desc(double* __restrict keys_in_out, double* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_desc(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_desc(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_desc(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_desc(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_desc(float* __restrict keys_in_out, float* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_desc(double* __restrict keys_in_out, double* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_desc(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_desc(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+/**
+ * Radix sort keys and values like radix8sort and radix11sort, or keys only,
+ * for arrays of any size. Arrays of up to UINT32_MAX keys are sorted exactly
+ * as those sort them, with 32 bit histogram counts; larger arrays count with
+ * 64 bit histograms, which are twice the size.
+ */
+template <typename ValueType>
+uint32_t radix8sort_size64(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_size64(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_size64(float* __restrict keys_in_out, float* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_size64(double* __restrict keys_in_out, double* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_size64(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_size64(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_size64(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_size64(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_size64(float* __restrict keys_in_out, float* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_size64(double* __restrict keys_in_out, double* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_size64(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_size64(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8sort_size64(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8sort_size64(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8sort_size64(float* __restrict keys_in_out, float* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8sort_size64(double* __restrict keys_in_out, double* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8sort_size64(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix8sort_size64(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort_size64(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort_size64(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort_size64(float* __restrict keys_in_out, float* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort_size64(double* __restrict keys_in_out, double* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort_size64(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+uint32_t radix11sort_size64(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+/**
+ * Widths in bits of the digit each radix pass sorts on, from the least
+ * significant digit, for radix_sort. Wider digits mean fewer passes but larger
+ * histograms. For example DigitPlan<11, 11, 10> sorts 32 bit keys in three
+ * passes and DigitPlan<16, 16> in two. Digits may be 1 to 16 bits wide, and
+ * must cover every bit of the key with each digit starting within it.
+ */
+template <uint32_t... kBits>
+struct DigitPlan
+{
+    static const uint32_t kNumDigits = sizeof...(kBits);
+    static constexpr uint32_t kDigitBits[sizeof...(kBits)] = {kBits...};
+};
+
+template <uint32_t... kBits>
+constexpr uint32_t DigitPlan<kBits...>::kDigitBits[sizeof...(kBits)];
+
+/**
+ * Radix sort keys and values with the digits of the given DigitPlan, for
+ * example radix_sort<DigitPlan<11, 11, 10>>(...), returning the buffer holding
+ * the sorted data like radix8sort. Plans with an even number of digits always
+ * leave the result in the in_out buffers. Histograms too large for the stack
+ * are allocated, and digits wider than 11 bits are always scattered directly.
+ */
+template <typename DigitPlan, typename ValueType>
+uint32_t radix_sort(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename DigitPlan, typename ValueType>
+uint32_t radix_sort(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename DigitPlan, typename ValueType>
+uint32_t radix_sort(float* __restrict keys_in_out, float* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename DigitPlan, typename ValueType>
+uint32_t radix_sort(double* __restrict keys_in_out, double* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename DigitPlan, typename ValueType>
+uint32_t radix_sort(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename DigitPlan, typename ValueType>
+uint32_t radix_sort(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+/**
+ * Radix sort an array of records by the key projection returns for each one,
+ * for example radix_sort(particles, temp, size, [](const Particle& p) { return
+ * p.depth; }), returning the buffer holding the sorted records like
+ * radix8sort. Keys may be integers, float or double. Each pass takes the key
+ * from the record and moves the whole record, rather than sorting keys with
+ * indices and gathering the records afterwards, which is faster for records
+ * of up to about 32 bytes; larger records are usually faster sorted with
+ * radix11argsort and gathered. Records with equal keys keep their order, and
+ * are always scattered directly.
+ */
+template <typename RecordType, typename Projection>
+uint32_t radix_sort(RecordType* __restrict records_in_out, RecordType* __restrict records_temp,
+    uint32_t size, Projection projection);
+
+/**
+ * IEEE 754 binary16 (half float) and bfloat16 keys for counting_sort, which
+ * hold the bits of the key as C++ has no 16 bit floating point type.
+ */
+struct Float16
+{
+    uint16_t bits;
+};
+
+struct BFloat16
+{
+    uint16_t bits;
+};
+
+/**
+ * Counting sort 8 and 16 bit keys and values in a single pass over a histogram
+ * of every key value, returning the buffer holding the sorted data like
+ * radix8sort. 16 bit keys are sorted in two passes of 8 bit digits below 65536
+ * keys, and in one pass above it with a 256KB histogram which is allocated.
+ * Float16 and BFloat16 keys are sorted on their bits in the same passes, in the
+ * same total order as float keys.
+ */
+template <typename ValueType>
+uint32_t counting_sort(uint8_t* __restrict keys_in_out, uint8_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t counting_sort(int8_t* __restrict keys_in_out, int8_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t counting_sort(uint16_t* __restrict keys_in_out, uint16_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t counting_sort(int16_t* __restrict keys_in_out, int16_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t counting_sort(Float16* __restrict keys_in_out, Float16* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t counting_sort(BFloat16* __restrict keys_in_out, BFloat16* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode = kScatterAuto);
+
+/**
+ * Radix sort on multiple threads, which returns the same result as the single
+ * threaded sort. A num_threads of 0 uses one thread per hardware thread;
+ * arrays too small to be worth splitting use fewer threads. Unlike the single
+ * threaded sorts this allocates memory for the threads and their histograms.
+ */
+template <typename ValueType>
+uint32_t radix8sort_parallel(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    uint32_t num_threads = 0, ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_parallel(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    uint32_t num_threads = 0, ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix8sort_parallel(float* __restrict keys_in_out, float* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    uint32_t num_threads = 0, ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_parallel(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    uint32_t num_threads = 0, ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_parallel(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    uint32_t num_threads = 0, ScatterMode scatter_mode = kScatterAuto);
+
+template <typename ValueType>
+uint32_t radix11sort_parallel(float* __restrict keys_in_out, float* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    uint32_t num_threads = 0, ScatterMode scatter_mode = kScatterAuto);
+
+/**
+ * Most significant digit first radix sort for large arrays, which partitions
+ * on the highest varying digit until partitions fit in cache then finishes
+ * them with the LSD radix sort.
+ */
+template <typename ValueType>
+uint32_t radix_sort_msd(uint64_t* __restrict keys_in_out,
+    uint64_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* values_temp,
+    uint32_t size);
+
+/**
+ * Most significant digit first radix sort on multiple threads. After the
+ * first partition, partitions are sorted as tasks which idle threads steal
+ * from busy ones, so skewed keys don't leave threads idle. A num_threads of 0
+ * uses one thread per hardware thread. Like the single threaded sorts it is
+ * stable, but it allocates memory for the threads and their tasks.
+ */
+template <typename ValueType>
+uint32_t radix_sort_msd_parallel(uint64_t* __restrict keys_in_out,
+    uint64_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* __restrict values_temp,
+    uint32_t size, uint32_t num_threads = 0);
+
+/**
+ * In place radix sort, which sorts keys and values without temporary buffers.
+ * This sort is not stable: values with equal keys may be reordered.
+ */
+template <typename ValueType>
+void radix_sort_inplace(uint32_t* __restrict keys_in_out,
+    ValueType* __restrict values_in_out, uint32_t size);
+
+template <typename ValueType>
+void radix_sort_inplace(uint64_t* __restrict keys_in_out,
+    ValueType* __restrict values_in_out, uint32_t size);
+
+template <typename ValueType>
+void radix_sort_inplace(float* __restrict keys_in_out,
+    ValueType* __restrict values_in_out, uint32_t size);
+
+/**
+ * In place radix sort on multiple threads, which like radix_sort_inplace needs
+ * no temporary key or value buffers and is not stable. A num_threads of 0 uses
+ * one thread per hardware thread. It allocates memory for the threads and
+ * their histograms, but nothing proportional to the size of the array.
+ */
+template <typename ValueType>
+void radix_sort_inplace_parallel(uint32_t* __restrict keys_in_out,
+    ValueType* __restrict values_in_out, uint32_t size, uint32_t num_threads = 0);
+
+template <typename ValueType>
+void radix_sort_inplace_parallel(uint64_t* __restrict keys_in_out,
+    ValueType* __restrict values_in_out, uint32_t size, uint32_t num_threads = 0);
+
+template <typename ValueType>
+void radix_sort_inplace_parallel(float* __restrict keys_in_out,
+    ValueType* __restrict values_in_out, uint32_t size, uint32_t num_threads = 0);
+
+/**
+ * A column of values for apply_permutation, value_size bytes each.
+ */
+struct PermutationColumn
+{
+    const void* values_in;
+    void* values_out;
+    size_t value_size;
+};
+
+/**
+ * Reorder columns of values by a permutation, such as the indices of an
+ * argsort, writing values_out[i] = values_in[indices[i]] for each column.
+ * Every index must be less than size, and each column's buffers must not
+ * overlap. Columns too large for the cache are gathered through a partition
+ * of the indices by the block of the input they read, made once for every
+ * column, so the values are read and written in order rather than missing
+ * the cache on each value. A num_threads of 0 uses one thread per hardware
+ * thread. This allocates a buffer as large as the largest such column.
+ */
+void apply_permutation(const uint32_t* __restrict indices, uint32_t size,
+    const PermutationColumn* columns, uint32_t num_columns, uint32_t num_threads = 0);
+
+template <typename ValueType>
+void apply_permutation(const uint32_t* __restrict indices, uint32_t size,
+    const ValueType* __restrict values_in, ValueType* __restrict values_out, uint32_t num_threads = 0);
 
 } // namespace bits
 
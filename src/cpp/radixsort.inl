@@ -1,4 +1,25 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace bits
 {
@@ -38,6 +59,73 @@ struct InvFloatFlip
 };
 
 
+/**
+ * Flip a double for sorting, as FloatFlip.
+ */
+struct DoubleFlip
+{
+    inline uint64_t operator()(uint64_t f) const
+    {
+        uint64_t mask = -((int64_t)(f >> 63)) | 0x8000000000000000ull;
+        return f ^ mask;
+    }
+};
+
+
+/**
+ * Flip a double back (invert DoubleFlip)
+ */
+struct InvDoubleFlip
+{
+    inline uint64_t operator()(uint64_t f) const
+    {
+        uint64_t mask = ((f >> 63) - 1) | 0x8000000000000000ull;
+        return f ^ mask;
+    }
+};
+
+
+/**
+ * Flip a half float or bfloat16 for sorting, as FloatFlip. Both formats keep
+ * the sign in the top bit above the exponent, so they share the flip.
+ */
+struct HalfFlip
+{
+    inline uint16_t operator()(uint16_t f) const
+    {
+        uint16_t mask = (uint16_t)(-((int16_t)(f >> 15)) | 0x8000);
+        return f ^ mask;
+    }
+};
+
+
+/**
+ * Flip a half float or bfloat16 back (invert HalfFlip)
+ */
+struct InvHalfFlip
+{
+    inline uint16_t operator()(uint16_t f) const
+    {
+        uint16_t mask = (uint16_t)(((f >> 15) - 1) | 0x8000);
+        return f ^ mask;
+    }
+};
+
+
+/**
+ * Flip the sign bit of a signed key, which orders signed keys as unsigned
+ * ones. This is its own inverse.
+ */
+struct SignFlip
+{
+    template <typename KeyType>
+    inline KeyType operator()(KeyType f) const
+    {
+        return f ^ (KeyType(1) << (sizeof(KeyType) * 8 - 1));
+    }
+};
+
+
 /**
  * Pass input through unmodified
  */
@@ -50,183 +138,4287 @@ struct PassThrough
     }
 };
 
+
 /**
- * Internal function object for performing radix sort.
- * Non integral key types like float should provide decode and encode
- * operators for conversion to the given KeyType.
+ * Invert every bit of a key after DecodeOp, which sorts keys in descending
+ * order. Equal keys stay equal, so the sort is still stable.
  */
-template <uint32_t kRadixBits, typename KeyType, typename ValueType,
-    typename DecodeOp = PassThrough, typename EncodeOp = PassThrough>
-struct RadixSort
+template <typename DecodeOp>
+struct DescendingDecode
 {
-private:
-    static const uint32_t kHistBuckets = 1 + (((sizeof(KeyType) * 8) - 1) / kRadixBits);
-    static const uint32_t kHistSize = (1 << kRadixBits);
-    static const uint32_t kHistMask = kHistSize - 1;
+    template <typename KeyType>
+    inline KeyType operator()(KeyType f) const
+    {
+        return KeyType(~DecodeOp()(f));
+    }
+};
 
-    /**
-     * Perform a radix sort pass for the given bit shift and mask.
-     */
-    template <typename PassDecodeOp, typename PassEncodeOp>
-    static inline void radix_pass(const KeyType* __restrict keys_in, KeyType* __restrict keys_out,
-        const ValueType* __restrict values_in, ValueType* __restrict values_out, uint32_t size,
-        uint32_t* __restrict hist, KeyType shift, PassDecodeOp decode_op, PassEncodeOp encode_op)
+
+/**
+ * Invert every bit of a key back before EncodeOp (invert DescendingDecode)
+ */
+template <typename EncodeOp>
+struct DescendingEncode
+{
+    template <typename KeyType>
+    inline KeyType operator()(KeyType f) const
     {
-        for (uint32_t i = 0; i < size; ++i)
-        {
-            const KeyType key = decode_op(keys_in[i]);
-            const KeyType pos = (key >> shift) & kHistMask;
-            const uint32_t index = hist[pos]++;
-            keys_out[index] = encode_op(key);
-            values_out[index] = values_in[i];
-        }
+        return EncodeOp()(KeyType(~f));
     }
+};
 
-public:
-    uint32_t operator()(KeyType* __restrict keys_in,
-        KeyType* __restrict keys_temp, ValueType* __restrict values_in,
-        ValueType* __restrict values_temp, uint32_t size) const
+/**
+ * Encode op for the last pass of an argsort which only wants the permutation.
+ * Radix passes given it leave their output keys unwritten.
+ */
+struct DiscardKey
+{
+    template <typename KeyType>
+    inline KeyType operator()(KeyType f) const
     {
-        DecodeOp decode_op;
-        EncodeOp encode_op;
-        PassThrough pass_through;
+        return f;
+    }
+};
 
-        // Initialise each histogram bucket with the key value
-        uint32_t hist[kHistBuckets][kHistSize] = {};
-        for (uint32_t i = 0; i < size; ++i)
+
+/**
+ * Read the value moved with each key from the input values.
+ */
+struct LoadValue
+{
+    template <typename ValueType>
+    inline ValueType operator()(const ValueType* __restrict values, size_t i) const
+    {
+        return values[i];
+    }
+};
+
+
+/**
+ * Give each key its index in the input as its value, so argsorts never read
+ * their input values.
+ */
+struct IndexValue
+{
+    template <typename ValueType>
+    inline ValueType operator()(const ValueType* __restrict, size_t i) const
+    {
+        return static_cast<ValueType>(i);
+    }
+};
+
+/**
+ * Value type of the key only sorts. Their value arrays are null and the sorts
+ * never read or write them, so only keys are moved.
+ */
+struct NoValue
+{
+};
+
+/**
+ * Arrays up to this size are insertion sorted instead of using a sorting
+ * network.
+ */
+static const uint32_t kInsertionSortThreshold = 32;
+
+/**
+ * Compare and exchange packed keys and indices so the lower item is stored
+ * first if ascending, or last if not.
+ */
+inline void compare_exchange(uint64_t* __restrict items_a, uint64_t* __restrict items_b,
+    uint32_t count, bool ascending)
+{
+    uint32_t i = 0;
+#if defined(__AVX2__)
+    const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i invert = ascending ? _mm256_setzero_si256() : _mm256_set1_epi64x(-1);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items_a + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items_b + i));
+        const __m256i swap = _mm256_xor_si256(
+            _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias)), invert);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(items_a + i), _mm256_blendv_epi8(a, b, swap));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(items_b + i), _mm256_blendv_epi8(b, a, swap));
+    }
+#elif defined(__SSE4_2__)
+    const __m128i bias = _mm_set1_epi64x(INT64_MIN);
+    const __m128i invert = ascending ? _mm_setzero_si128() : _mm_set1_epi64x(-1);
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items_a + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items_b + i));
+        const __m128i swap = _mm_xor_si128(
+            _mm_cmpgt_epi64(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)), invert);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(items_a + i), _mm_blendv_epi8(a, b, swap));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(items_b + i), _mm_blendv_epi8(b, a, swap));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const uint64_t a = items_a[i];
+        const uint64_t b = items_b[i];
+        const uint64_t lo = a < b ? a : b;
+        const uint64_t hi = a < b ? b : a;
+        items_a[i] = ascending ? lo : hi;
+        items_b[i] = ascending ? hi : lo;
+    }
+}
+
+/**
+ * Compare and exchange pairs of keys and indices so the lower pair is stored
+ * first if ascending, or last if not. Indices are unique so ties between keys
+ * are broken on the index, which keeps the sort stable. Indices are compared
+ * unsigned like the keys, so the UINT64_MAX index of the padding sorts after
+ * every real pair, even one whose key is UINT64_MAX.
+ */
+inline void compare_exchange(uint64_t* __restrict keys_a, uint64_t* __restrict keys_b,
+    uint64_t* __restrict indices_a, uint64_t* __restrict indices_b, uint32_t count, bool ascending)
+{
+    uint32_t i = 0;
+#if defined(__AVX2__)
+    const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i invert = ascending ? _mm256_setzero_si256() : _mm256_set1_epi64x(-1);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256i ka = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys_a + i));
+        const __m256i kb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys_b + i));
+        const __m256i ia = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices_a + i));
+        const __m256i ib = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices_b + i));
+        const __m256i key_gt = _mm256_cmpgt_epi64(
+            _mm256_xor_si256(ka, bias), _mm256_xor_si256(kb, bias));
+        const __m256i key_eq = _mm256_cmpeq_epi64(ka, kb);
+        const __m256i index_gt = _mm256_cmpgt_epi64(_mm256_xor_si256(ia, bias), _mm256_xor_si256(ib, bias));
+        const __m256i swap = _mm256_xor_si256(
+            _mm256_or_si256(key_gt, _mm256_and_si256(key_eq, index_gt)), invert);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys_a + i), _mm256_blendv_epi8(ka, kb, swap));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys_b + i), _mm256_blendv_epi8(kb, ka, swap));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices_a + i), _mm256_blendv_epi8(ia, ib, swap));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices_b + i), _mm256_blendv_epi8(ib, ia, swap));
+    }
+#elif defined(__SSE4_2__)
+    const __m128i bias = _mm_set1_epi64x(INT64_MIN);
+    const __m128i invert = ascending ? _mm_setzero_si128() : _mm_set1_epi64x(-1);
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128i ka = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys_a + i));
+        const __m128i kb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys_b + i));
+        const __m128i ia = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices_a + i));
+        const __m128i ib = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices_b + i));
+        const __m128i key_gt = _mm_cmpgt_epi64(_mm_xor_si128(ka, bias), _mm_xor_si128(kb, bias));
+        const __m128i key_eq = _mm_cmpeq_epi64(ka, kb);
+        const __m128i index_gt = _mm_cmpgt_epi64(_mm_xor_si128(ia, bias), _mm_xor_si128(ib, bias));
+        const __m128i swap = _mm_xor_si128(
+            _mm_or_si128(key_gt, _mm_and_si128(key_eq, index_gt)), invert);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(keys_a + i), _mm_blendv_epi8(ka, kb, swap));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(keys_b + i), _mm_blendv_epi8(kb, ka, swap));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices_a + i), _mm_blendv_epi8(ia, ib, swap));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices_b + i), _mm_blendv_epi8(ib, ia, swap));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const uint64_t ka = keys_a[i];
+        const uint64_t kb = keys_b[i];
+        const uint64_t ia = indices_a[i];
+        const uint64_t ib = indices_b[i];
+        const uint64_t swap = 0 - static_cast<uint64_t>(((ka > kb) | ((ka == kb) & (ia > ib))) ^ !ascending);
+        const uint64_t key_diff = (ka ^ kb) & swap;
+        const uint64_t index_diff = (ia ^ ib) & swap;
+        keys_a[i] = ka ^ key_diff;
+        keys_b[i] = kb ^ key_diff;
+        indices_a[i] = ia ^ index_diff;
+        indices_b[i] = ib ^ index_diff;
+    }
+}
+
+/**
+ * Sort packed keys and indices with a bitonic sorting network, the size must
+ * be a power of two.
+ */
+inline void bitonic_sort(uint64_t* __restrict items, uint32_t size)
+{
+    for (uint32_t k = 2; k <= size; k <<= 1)
+    {
+        for (uint32_t j = k >> 1; j > 0; j >>= 1)
         {
-            const KeyType key = decode_op(keys_in[i]);
-            for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+            // every item in a run of j items is sorted in the same direction
+            for (uint32_t base = 0; base < size; base += j << 1)
             {
-                const uint32_t shift = bucket * kRadixBits;
-                const uint32_t pos = (key >> shift) & kHistMask;
-                ++hist[bucket][pos];
+                compare_exchange(items + base, items + base + j, j, (base & k) == 0);
             }
         }
+    }
+}
 
-        // Update the histogram data so each entry sums the previous entries
-        uint32_t sum[kHistBuckets];
-        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+/**
+ * Sort pairs of keys and indices with a bitonic sorting network, the size
+ * must be a power of two.
+ */
+inline void bitonic_sort(uint64_t* __restrict keys, uint64_t* __restrict indices, uint32_t size)
+{
+    for (uint32_t k = 2; k <= size; k <<= 1)
+    {
+        for (uint32_t j = k >> 1; j > 0; j >>= 1)
         {
-            sum[bucket] = hist[bucket][0];
-            hist[bucket][0] = 0;
+            // every pair in a run of j pairs is sorted in the same direction
+            for (uint32_t base = 0; base < size; base += j << 1)
+            {
+                compare_exchange(keys + base, keys + base + j, indices + base, indices + base + j, j,
+                    (base & k) == 0);
+            }
         }
+    }
+}
 
-        uint32_t tsum;
-        for (uint32_t i = 1; i < kHistSize; ++i)
+/**
+ * Insertion sort of packed keys and indices.
+ */
+inline void insertion_sort(uint64_t* __restrict items, uint32_t size)
+{
+    for (uint32_t i = 1; i < size; ++i)
+    {
+        const uint64_t item = items[i];
+        uint32_t j = i;
+        for (; j > 0 && items[j - 1] > item; --j)
         {
-            for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
-            {
-                tsum = hist[bucket][i] + sum[bucket];
-                hist[bucket][i] = sum[bucket];
-                sum[bucket] = tsum;
-            }
+            items[j] = items[j - 1];
         }
+        items[j] = item;
+    }
+}
 
-        // alternate input and output buffers on each radix pass
-        KeyType* __restrict keys[2] = {keys_in, keys_temp};
-        ValueType* __restrict values[2] = {values_in, values_temp};
+/**
+ * Stable insertion sort of pairs of keys and indices.
+ */
+inline void insertion_sort(uint64_t* __restrict keys, uint64_t* __restrict indices, uint32_t size)
+{
+    for (uint32_t i = 1; i < size; ++i)
+    {
+        const uint64_t key = keys[i];
+        const uint64_t index = indices[i];
+        uint32_t j = i;
+        for (; j > 0 && keys[j - 1] > key; --j)
+        {
+            keys[j] = keys[j - 1];
+            indices[j] = indices[j - 1];
+        }
+        keys[j] = key;
+        indices[j] = index;
+    }
+}
 
-        uint32_t out = 0;
+/**
+ * Round a small array size up to the power of two sorted by the network.
+ */
+inline uint32_t bitonic_size(uint32_t size)
+{
+    uint32_t padded_size = kInsertionSortThreshold;
+    while (padded_size < size)
+    {
+        padded_size <<= 1;
+    }
+    return padded_size;
+}
 
+/**
+ * Sort small arrays of keys and values into the temporary buffers using a
+ * sorting network or insertion sort on the decoded keys and their indices.
+ * Keys of up to 32 bits are packed above their index so the network only
+ * moves one array. Values are given by value_op. Returns the index of the
+ * buffer holding the sorted data, like the radix sort.
+ */
+template <uint32_t kMaxSize, typename KeyType, typename ValueType, typename DecodeOp,
+    typename EncodeOp, typename ValueOp = LoadValue>
+inline uint32_t small_sort(const KeyType* __restrict keys_in, KeyType* __restrict keys_temp,
+    const ValueType* __restrict values_in, ValueType* __restrict values_temp, uint32_t size,
+    DecodeOp decode_op, EncodeOp encode_op, ValueOp value_op = ValueOp())
+{
+    const bool kHasValues = !std::is_same<ValueType, NoValue>::value;
+    uint64_t keys[kMaxSize];
+    if (sizeof(KeyType) <= sizeof(uint32_t))
+    {
+        for (uint32_t i = 0; i < size; ++i)
         {
-            // decode key on first radix pass
-            const uint32_t bucket = 0;
-            const uint32_t in = bucket & 1;
-            out = !in;
-            radix_pass(keys[in], keys[out], values[in], values[out], size, hist[bucket],
-                bucket * kRadixBits, decode_op, pass_through);
+            keys[i] = (static_cast<uint64_t>(decode_op(keys_in[i])) << 32) | i;
         }
 
-        for (uint32_t bucket = 1; bucket < kHistBuckets - 1; ++bucket)
+        if (size <= kInsertionSortThreshold)
         {
-            const uint32_t in = bucket & 1;
-            out = !in;
-            radix_pass(keys[in], keys[out], values[in], values[out], size, hist[bucket],
-                bucket * kRadixBits, pass_through, pass_through);
+            insertion_sort(keys, size);
+        }
+        else
+        {
+            // pad with items that sort after every input item
+            const uint32_t padded_size = bitonic_size(size);
+            for (uint32_t i = size; i < padded_size; ++i)
+            {
+                keys[i] = UINT64_MAX;
+            }
+            bitonic_sort(keys, padded_size);
         }
 
+        for (uint32_t i = 0; i < size; ++i)
         {
-            // encode key on last radix pass
-            const uint32_t bucket = kHistBuckets - 1;
-            const uint32_t in = bucket & 1;
-            out = !in;
-            radix_pass(keys[in], keys[out], values[in], values[out], size, hist[bucket],
-                bucket * kRadixBits, pass_through, encode_op);
+            keys_temp[i] = encode_op(static_cast<KeyType>(keys[i] >> 32));
+            if (kHasValues)
+            {
+                values_temp[i] = value_op(values_in, static_cast<uint32_t>(keys[i]));
+            }
         }
+        return 1;
+    }
 
-        return out;
+    uint64_t indices[kMaxSize];
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys[i] = decode_op(keys_in[i]);
+        indices[i] = i;
     }
-};
 
-} // namespace detail
+    if (size <= kInsertionSortThreshold)
+    {
+        insertion_sort(keys, indices, size);
+    }
+    else
+    {
+        // pad with pairs that sort after every input pair
+        const uint32_t padded_size = bitonic_size(size);
+        for (uint32_t i = size; i < padded_size; ++i)
+        {
+            keys[i] = UINT64_MAX;
+            indices[i] = UINT64_MAX;
+        }
+        bitonic_sort(keys, indices, padded_size);
+    }
 
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys_temp[i] = encode_op(static_cast<KeyType>(keys[i]));
+        if (kHasValues)
+        {
+            values_temp[i] = value_op(values_in, static_cast<uint32_t>(indices[i]));
+        }
+    }
+    return 1;
+}
 
-template <typename ValueType>
-inline uint32_t radix8sort(uint32_t* __restrict keys_in_out,
-    uint32_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* values_temp,
-    uint32_t size)
+/**
+ * Copy bytes using non-temporal stores, which bypass the cache, when the
+ * destination is suitably aligned, otherwise copy them normally.
+ */
+inline void stream_copy(void* __restrict dst, const void* __restrict src, size_t bytes)
 {
-    detail::RadixSort<8, uint32_t, ValueType> sort;
-    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+#if defined(__SSE2__)
+    if ((reinterpret_cast<uintptr_t>(dst) & 15) == 0 && (bytes & 15) == 0)
+    {
+        char* __restrict dst_bytes = static_cast<char*>(dst);
+        const char* __restrict src_bytes = static_cast<const char*>(src);
+        for (size_t i = 0; i < bytes; i += 16)
+        {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dst_bytes + i),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_bytes + i)));
+        }
+        return;
+    }
+#endif
+    std::memcpy(dst, src, bytes);
 }
 
-
-template <typename ValueType>
-inline uint32_t radix8sort(uint64_t* __restrict keys_in_out,
-    uint64_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* values_temp,
-    uint32_t size)
+/**
+ * Order non-temporal stores before any following stores, so the data they
+ * wrote is visible once the sort returns.
+ */
+inline void stream_fence()
 {
-    detail::RadixSort<8, uint64_t, ValueType> sort;
-    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
 }
 
-
-template <typename ValueType>
-inline uint32_t radix11sort(uint32_t* __restrict keys_in,
-    uint32_t* __restrict keys_out, ValueType* __restrict values_in,
-    ValueType* __restrict values_out, uint32_t size)
+/**
+ * Order of the keys, found before building the histograms.
+ */
+enum KeyOrder
 {
-    detail::RadixSort<11, uint32_t, ValueType> sort;
-    return sort(keys_in, keys_out, values_in, values_out, size);
-}
+    kKeysUnsorted,
+    kKeysAscending,
+    kKeysDescending, // strictly descending
+};
+
+/**
+ * Buffers staging keys and values for the scatters, either the lines of the
+ * buffered and streaming scatters, a cache line of keys per digit for
+ * hist_size digits, or the block of keys and digits of the block scatter,
+ * which holds as many keys. They take hundreds of KB, too much for the stack
+ * of a sort or of the threads of the parallel sorts, so they are allocated
+ * once per sort, or per thread by the parallel sorts. If they can't be
+ * allocated the sort scatters directly.
+ */
+template <typename KeyType, typename ValueType>
+struct ScatterBuffers
+{
+    static const uint32_t kLineBytes = 64;
+    static const uint32_t kLineKeys = kLineBytes / sizeof(KeyType);
+
+    // values larger than this are scattered directly whatever the scatter
+    // mode, as lines of them would no longer fit in cache, like the C sorts
+    static const uint32_t kMaxStagedValueBytes = 8;
+
+    struct Free
+    {
+        void operator()(void* buffer) const { std::free(buffer); }
+    };
+
+    ScatterMode mode;
+    KeyType* keys;
+    ValueType* values;
+    uint16_t* digits;
+    std::unique_ptr<void, Free> buffer;
+
+    ScatterBuffers(ScatterMode scatter_mode, uint32_t hist_size)
+        : mode(scatter_mode)
+        , keys(nullptr)
+        , values(nullptr)
+        , digits(nullptr)
+    {
+        static const bool kHasValues = !std::is_same<ValueType, NoValue>::value;
+        if (mode == kScatterDirect)
+        {
+            return;
+        }
+        if (kHasValues && sizeof(ValueType) > kMaxStagedValueBytes)
+        {
+            mode = kScatterDirect;
+            return;
+        }
+        // the keys take whole cache lines, so the values and digits which
+        // follow them are aligned, and only the block scatter stages digits
+        const size_t num_keys = size_t(hist_size) * kLineKeys;
+        const size_t key_bytes = sizeof(KeyType) * num_keys;
+        const size_t value_bytes = kHasValues ? sizeof(ValueType) * num_keys : 0;
+        const size_t digit_bytes = mode == kScatterBlock ? sizeof(uint16_t) * num_keys : 0;
+        buffer.reset(std::malloc(key_bytes + value_bytes + digit_bytes));
+        if (!buffer)
+        {
+            mode = kScatterDirect;
+            return;
+        }
+        char* bytes = static_cast<char*>(buffer.get());
+        keys = reinterpret_cast<KeyType*>(bytes);
+        values = reinterpret_cast<ValueType*>(bytes + key_bytes);
+        digits = mode == kScatterBlock ? reinterpret_cast<uint16_t*>(bytes + key_bytes + value_bytes) : nullptr;
+    }
+};
+
+template <uint32_t kRadixBits, typename KeyType, typename ValueType,
+    typename DecodeOp, typename EncodeOp>
+struct RadixSortParallel;
+
+template <typename Plan, typename KeyType, typename ValueType, typename DecodeOp, typename EncodeOp>
+struct RadixSortPlan;
+
+template <uint32_t kRadixBits, typename RecordType, typename Projection>
+struct RadixSortRecords;
+
+/**
+ * Internal function object for performing radix sort.
+ * Non integral key types like float should provide decode and encode
+ * operators for conversion to the given KeyType. SizeType holds the array
+ * size and the histogram counts, uint64_t for arrays of more than
+ * UINT32_MAX keys, which doubles the size of the histograms.
+ */
+template <uint32_t kRadixBits, typename KeyType, typename ValueType,
+    typename DecodeOp = PassThrough, typename EncodeOp = PassThrough, typename SizeType = uint32_t>
+struct RadixSort
+{
+private:
+    friend struct RadixSortParallel<kRadixBits, KeyType, ValueType, DecodeOp, EncodeOp>;
+    template <typename Plan, typename PlanKeyType, typename PlanValueType, typename PlanDecodeOp,
+        typename PlanEncodeOp>
+    friend struct RadixSortPlan;
+    template <uint32_t kRecordRadixBits, typename RecordType, typename Projection>
+    friend struct RadixSortRecords;
+
+    static const uint32_t kHistBuckets = 1 + (((sizeof(KeyType) * 8) - 1) / kRadixBits);
+    static const uint32_t kHistSize = (1 << kRadixBits);
+    static const uint32_t kHistMask = kHistSize - 1;
+
+    // key only sorts skip every read and write of values
+    static const bool kHasValues = !std::is_same<ValueType, NoValue>::value;
+
+    // arrays up to this size are sorted with a sorting network, as clearing
+    // and summing the histograms costs more than sorting them
+    static const uint32_t kSmallSortThreshold = kRadixBits > 8 ? 128 : 32;
+
+    typedef ScatterBuffers<KeyType, ValueType> Buffers;
+
+    // the buffered scatter stages this many keys, a cache line, per digit
+    static const uint32_t kLineKeys = Buffers::kLineKeys;
+
+    // the block scatter partitions this many keys at a time, enough for a
+    // cache line of keys per digit on average
+    static const uint32_t kBlockKeys = kHistSize * kLineKeys;
+
+    // arrays whose keys and values take at least this many bytes are scattered
+    // through line buffers with streaming stores when the scatter mode is
+    // automatic, below it writing directly is faster
+    static const uint32_t kStreamingScatterBytes = 1 << 23;
+
+    // arrays of at least this many keys are counted into two sets of
+    // histograms when at least kSplitCountRepeats of kSplitCountSamples pairs
+    // of neighbouring keys share a digit, so runs of equal digits don't wait
+    // on the previous increment of the same counter. On random keys the
+    // second set only costs time, and on small arrays clearing and merging it
+    // costs more than it saves.
+    static const uint32_t kSplitCountMinKeys = 1 << 16;
+    static const uint32_t kSplitCountSamples = 64;
+    static const uint32_t kSplitCountRepeats = 16;
+
+    ScatterMode scatter_mode_;
+
+    static inline ScatterMode resolve_scatter_mode(ScatterMode scatter_mode, SizeType size)
+    {
+        if (scatter_mode != kScatterAuto)
+        {
+            return scatter_mode;
+        }
+        const uint64_t bytes = uint64_t(size) * (sizeof(KeyType) + sizeof(ValueType));
+        return bytes >= kStreamingScatterBytes ? kScatterStreaming : kScatterDirect;
+    }
+
+    /**
+     * Perform a radix sort pass for the given bit shift and mask. Digits are
+     * taken from the key relative to the given base, and values are given by
+     * value_op. Passes given DiscardKey don't write keys.
+     */
+    template <typename PassDecodeOp, typename PassEncodeOp, typename ValueOp = LoadValue>
+    static inline void radix_pass(const KeyType* __restrict keys_in, KeyType* __restrict keys_out,
+        const ValueType* __restrict values_in, ValueType* __restrict values_out, SizeType size,
+        SizeType* __restrict hist, KeyType base, KeyType shift, PassDecodeOp decode_op,
+        PassEncodeOp encode_op, ValueOp value_op = ValueOp())
+    {
+        const bool kWriteKeys = !std::is_same<PassEncodeOp, DiscardKey>::value;
+        for (SizeType i = 0; i < size; ++i)
+        {
+            const KeyType key = decode_op(keys_in[i]);
+            const KeyType pos = (KeyType(key - base) >> shift) & kHistMask;
+            const SizeType index = hist[pos]++;
+            if (kWriteKeys)
+            {
+                keys_out[index] = encode_op(key);
+            }
+            if (kHasValues)
+            {
+                values_out[index] = value_op(values_in, i);
+            }
+        }
+    }
+
+    /**
+     * Write the given number of staged keys and values ending at the line
+     * slot for index, streaming whole lines if requested.
+     */
+    template <bool kStreaming, bool kWriteKeys>
+    static inline void flush_line(KeyType* __restrict keys_out, ValueType* __restrict values_out,
+        const KeyType* __restrict key_line, const ValueType* __restrict value_line, SizeType index,
+        uint32_t slot, uint32_t count)
+    {
+        const SizeType first = index + 1 - count;
+        const uint32_t first_slot = slot + 1 - count;
+        if (kStreaming && count == kLineKeys)
+        {
+            if (kWriteKeys)
+            {
+                stream_copy(keys_out + first, key_line + first_slot, sizeof(KeyType) * count);
+            }
+            if (kHasValues)
+            {
+                stream_copy(values_out + first, value_line + first_slot, sizeof(ValueType) * count);
+            }
+        }
+        else
+        {
+            if (kWriteKeys)
+            {
+                std::memcpy(keys_out + first, key_line + first_slot, sizeof(KeyType) * count);
+            }
+            if (kHasValues)
+            {
+                std::memcpy(values_out + first, value_line + first_slot, sizeof(ValueType) * count);
+            }
+        }
+    }
+
+    /**
+     * Perform a radix sort pass like radix_pass, but stage keys and values in
+     * a line of the buffers per digit and write them a cache line of keys at
+     * a time.
+     */
+    template <bool kStreaming, typename PassDecodeOp, typename PassEncodeOp, typename ValueOp = LoadValue>
+    static void radix_pass_buffered(const KeyType* __restrict keys_in, KeyType* __restrict keys_out,
+        const ValueType* __restrict values_in, ValueType* __restrict values_out, SizeType size,
+        SizeType* __restrict hist, KeyType base, KeyType shift, PassDecodeOp decode_op,
+        PassEncodeOp encode_op, const Buffers& buffers, ValueOp value_op = ValueOp())
+    {
+        static const uint32_t kSlotMask = kLineKeys - 1;
+        static const bool kWriteKeys = !std::is_same<PassEncodeOp, DiscardKey>::value;
+        KeyType (*__restrict key_lines)[kLineKeys] = reinterpret_cast<KeyType (*)[kLineKeys]>(buffers.keys);
+        ValueType (*__restrict value_lines)[kLineKeys] = reinterpret_cast<ValueType (*)[kLineKeys]>(buffers.values);
+
+        // Slots line up with cache lines of the output keys, and lines are
+        // never written before the first index of their digit in this pass
+        SizeType begin[kHistSize];
+        std::memcpy(begin, hist, sizeof(begin));
+        const uint32_t align = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(keys_out) / sizeof(KeyType));
+
+        for (SizeType i = 0; i < size; ++i)
+        {
+            const KeyType key = decode_op(keys_in[i]);
+            const KeyType pos = (KeyType(key - base) >> shift) & kHistMask;
+            const SizeType index = hist[pos]++;
+            const uint32_t slot = static_cast<uint32_t>(index + align) & kSlotMask;
+            if (kWriteKeys)
+            {
+                key_lines[pos][slot] = encode_op(key);
+            }
+            if (kHasValues)
+            {
+                value_lines[pos][slot] = value_op(values_in, i);
+            }
+            if (slot == kSlotMask)
+            {
+                const uint32_t count = static_cast<uint32_t>(std::min<SizeType>(slot + 1, index - begin[pos] + 1));
+                flush_line<kStreaming, kWriteKeys>(keys_out, values_out, key_lines[pos], value_lines[pos], index, slot,
+                    count);
+            }
+        }
+
+        // Write the lines which weren't filled
+        for (uint32_t pos = 0; pos < kHistSize; ++pos)
+        {
+            if (hist[pos] == begin[pos])
+            {
+                continue;
+            }
+            const SizeType index = hist[pos] - 1;
+            const uint32_t slot = static_cast<uint32_t>(index + align) & kSlotMask;
+            if (slot != kSlotMask)
+            {
+                const uint32_t count = static_cast<uint32_t>(std::min<SizeType>(slot + 1, index - begin[pos] + 1));
+                flush_line<false, kWriteKeys>(keys_out, values_out, key_lines[pos], value_lines[pos], index, slot,
+                    count);
+            }
+        }
+
+        if (kStreaming)
+        {
+            stream_fence();
+        }
+    }
+
+    /**
+     * Perform a radix sort pass like radix_pass, but partition each block of
+     * keys and values by digit in the buffers first, so every digit of the
+     * block is written to the output as one contiguous run.
+     */
+    template <typename PassDecodeOp, typename PassEncodeOp, typename ValueOp = LoadValue>
+    static void radix_pass_block(const KeyType* __restrict keys_in, KeyType* __restrict keys_out,
+        const ValueType* __restrict values_in, ValueType* __restrict values_out, SizeType size,
+        SizeType* __restrict hist, KeyType base, KeyType shift, PassDecodeOp decode_op,
+        PassEncodeOp encode_op, const Buffers& buffers, ValueOp value_op = ValueOp())
+    {
+        const bool kWriteKeys = !std::is_same<PassEncodeOp, DiscardKey>::value;
+        KeyType* __restrict block_keys = buffers.keys;
+        ValueType* __restrict block_values = buffers.values;
+        uint16_t* __restrict block_digits = buffers.digits;
+        uint32_t block_hist[kHistSize];
+
+        for (SizeType begin = 0; begin < size; begin += kBlockKeys)
+        {
+            const uint32_t block_size = static_cast<uint32_t>(std::min<SizeType>(SizeType(kBlockKeys), size - begin));
+            const KeyType* __restrict block_keys_in = keys_in + begin;
+
+            std::memset(block_hist, 0, sizeof(block_hist));
+            for (uint32_t i = 0; i < block_size; ++i)
+            {
+                const KeyType key = decode_op(block_keys_in[i]);
+                const uint16_t pos = static_cast<uint16_t>((KeyType(key - base) >> shift) & kHistMask);
+                block_digits[i] = pos;
+                ++block_hist[pos];
+            }
+
+            uint32_t sum = 0;
+            for (uint32_t pos = 0; pos < kHistSize; ++pos)
+            {
+                const uint32_t count = block_hist[pos];
+                block_hist[pos] = sum;
+                sum += count;
+            }
+
+            for (uint32_t i = 0; i < block_size; ++i)
+            {
+                const uint32_t index = block_hist[block_digits[i]]++;
+                if (kWriteKeys)
+                {
+                    block_keys[index] = encode_op(decode_op(block_keys_in[i]));
+                }
+                if (kHasValues)
+                {
+                    block_values[index] = value_op(values_in, begin + i);
+                }
+            }
+
+            // block_hist now holds the end of each digit's run in the block
+            uint32_t first = 0;
+            for (uint32_t pos = 0; pos < kHistSize; ++pos)
+            {
+                const uint32_t count = block_hist[pos] - first;
+                if (count != 0)
+                {
+                    const SizeType index = hist[pos];
+                    if (kWriteKeys)
+                    {
+                        std::memcpy(keys_out + index, block_keys + first, sizeof(KeyType) * count);
+                    }
+                    if (kHasValues)
+                    {
+                        std::memcpy(values_out + index, block_values + first, sizeof(ValueType) * count);
+                    }
+                    hist[pos] = index + count;
+                }
+                first = block_hist[pos];
+            }
+        }
+    }
+
+    /**
+     * Perform a radix sort pass with the scatter mode of the buffers, which
+     * were allocated for at least kHistSize digits.
+     */
+    template <typename PassDecodeOp, typename PassEncodeOp, typename ValueOp = LoadValue>
+    static inline void scatter_pass(const Buffers& buffers, const KeyType* __restrict keys_in,
+        KeyType* __restrict keys_out, const ValueType* __restrict values_in, ValueType* __restrict values_out,
+        SizeType size, SizeType* __restrict hist, KeyType base, KeyType shift, PassDecodeOp decode_op,
+        PassEncodeOp encode_op, ValueOp value_op = ValueOp())
+    {
+        switch (buffers.mode)
+        {
+        case kScatterBuffered:
+            radix_pass_buffered<false>(keys_in, keys_out, values_in, values_out, size, hist, base, shift,
+                decode_op, encode_op, buffers, value_op);
+            break;
+        case kScatterStreaming:
+            radix_pass_buffered<true>(keys_in, keys_out, values_in, values_out, size, hist, base, shift,
+                decode_op, encode_op, buffers, value_op);
+            break;
+        case kScatterBlock:
+            radix_pass_block(keys_in, keys_out, values_in, values_out, size, hist, base, shift, decode_op,
+                encode_op, buffers, value_op);
+            break;
+        default:
+            radix_pass(keys_in, keys_out, values_in, values_out, size, hist, base, shift, decode_op,
+                encode_op, value_op);
+            break;
+        }
+    }
+
+    /**
+     * Find whether keys are in ascending or strictly descending order, the
+     * first key being compared with prev_key. This stops at the first key
+     * which is in neither order, which for unsorted keys is usually one of the
+     * first few, and is kept out of the histogram loop where tracking the
+     * order of every key costs more than this scan.
+     */
+    static inline KeyOrder find_order(const KeyType* __restrict keys_in, SizeType size, KeyType prev_key)
+    {
+        DecodeOp decode_op;
+        SizeType i = 0;
+        for (; i < size; ++i)
+        {
+            const KeyType key = decode_op(keys_in[i]);
+            if (key < prev_key)
+            {
+                break;
+            }
+            prev_key = key;
+        }
+        if (i == size)
+        {
+            return kKeysAscending;
+        }
+        if (i > 0)
+        {
+            return kKeysUnsorted;
+        }
+        for (; i < size; ++i)
+        {
+            const KeyType key = decode_op(keys_in[i]);
+            if (key >= prev_key)
+            {
+                return kKeysUnsorted;
+            }
+            prev_key = key;
+        }
+        return kKeysDescending;
+    }
+
+    /**
+     * Find whether neighbouring keys relative to base often share a digit in
+     * the first num_buckets digits, sampling pairs spread over the keys.
+     */
+    static inline bool repeats_digits(const KeyType* __restrict keys_in, SizeType size, uint32_t num_buckets,
+        KeyType base)
+    {
+        DecodeOp decode_op;
+        uint32_t repeats = 0;
+        for (uint32_t sample = 0; sample < kSplitCountSamples; ++sample)
+        {
+            const SizeType i = static_cast<SizeType>((uint64_t(size - 1) * sample) / kSplitCountSamples);
+            const KeyType diff = KeyType(decode_op(keys_in[i]) - base) ^ KeyType(decode_op(keys_in[i + 1]) - base);
+            bool repeat = false;
+            for (uint32_t bucket = 0; bucket < num_buckets; ++bucket)
+            {
+                repeat = repeat || ((diff >> (bucket * kRadixBits)) & kHistMask) == 0;
+            }
+            repeats += repeat;
+        }
+        return repeats >= kSplitCountRepeats;
+    }
+
+    /**
+     * Count the digits of each key relative to base into the first
+     * num_buckets histograms and find the range of the keys.
+     */
+    static inline void count_keys_single(SizeType (&hist)[kHistBuckets][kHistSize], uint32_t num_buckets,
+        const KeyType* __restrict keys_in, SizeType size, KeyType base, KeyType& min_key, KeyType& max_key)
+    {
+        DecodeOp decode_op;
+        KeyType key_min = KeyType(~KeyType(0));
+        KeyType key_max = 0;
+        for (SizeType i = 0; i < size; ++i)
+        {
+            const KeyType key = KeyType(decode_op(keys_in[i]) - base);
+            key_min = key < key_min ? key : key_min;
+            key_max = key > key_max ? key : key_max;
+            for (uint32_t bucket = 0; bucket < num_buckets; ++bucket)
+            {
+                const uint32_t shift = bucket * kRadixBits;
+                const uint32_t pos = (key >> shift) & kHistMask;
+                ++hist[bucket][pos];
+            }
+        }
+        min_key = key_min;
+        max_key = key_max;
+    }
+
+    /**
+     * Count the digits of each key relative to base into the first
+     * num_buckets histograms, even keys into hist_even and odd keys into
+     * hist_odd, and find the range of the keys.
+     */
+    static inline void count_keys_split(SizeType (&hist_even)[kHistBuckets][kHistSize],
+        SizeType (*__restrict hist_odd)[kHistSize], uint32_t num_buckets, const KeyType* __restrict keys_in,
+        SizeType size, KeyType base, KeyType& min_key, KeyType& max_key)
+    {
+        DecodeOp decode_op;
+        KeyType key_min = KeyType(~KeyType(0));
+        KeyType key_max = 0;
+        SizeType i = 0;
+        for (; i + 1 < size; i += 2)
+        {
+            const KeyType key_even = KeyType(decode_op(keys_in[i]) - base);
+            const KeyType key_odd = KeyType(decode_op(keys_in[i + 1]) - base);
+            key_min = std::min(key_min, std::min(key_even, key_odd));
+            key_max = std::max(key_max, std::max(key_even, key_odd));
+            for (uint32_t bucket = 0; bucket < num_buckets; ++bucket)
+            {
+                const uint32_t shift = bucket * kRadixBits;
+                ++hist_even[bucket][(key_even >> shift) & kHistMask];
+                ++hist_odd[bucket][(key_odd >> shift) & kHistMask];
+            }
+        }
+        if (i < size)
+        {
+            const KeyType key = KeyType(decode_op(keys_in[i]) - base);
+            key_min = std::min(key_min, key);
+            key_max = std::max(key_max, key);
+            for (uint32_t bucket = 0; bucket < num_buckets; ++bucket)
+            {
+                ++hist_even[bucket][(key >> (bucket * kRadixBits)) & kHistMask];
+            }
+        }
+        min_key = key_min;
+        max_key = key_max;
+    }
+
+    /**
+     * Count the digits of each key relative to base into the first
+     * num_buckets histograms, which must be zeroed, and find the range of the
+     * keys. Keys with runs of equal digits are counted into a second set of
+     * histograms for the odd keys, which is then merged.
+     */
+    static inline void count_keys(SizeType (&hist)[kHistBuckets][kHistSize], uint32_t num_buckets,
+        const KeyType* __restrict keys_in, SizeType size, KeyType base, KeyType& min_key, KeyType& max_key)
+    {
+        if (size >= kSplitCountMinKeys && repeats_digits(keys_in, size, num_buckets, base))
+        {
+            std::unique_ptr<SizeType[][kHistSize]> hist_odd(new (std::nothrow) SizeType[num_buckets][kHistSize]());
+            if (hist_odd)
+            {
+                count_keys_split(hist, hist_odd.get(), num_buckets, keys_in, size, base, min_key, max_key);
+                for (uint32_t bucket = 0; bucket < num_buckets; ++bucket)
+                {
+                    for (uint32_t pos = 0; pos < kHistSize; ++pos)
+                    {
+                        hist[bucket][pos] += hist_odd[bucket][pos];
+                    }
+                }
+                return;
+            }
+        }
+        count_keys_single(hist, num_buckets, keys_in, size, base, min_key, max_key);
+    }
+
+    /**
+     * Find the radix passes which need to be performed. A pass can be skipped
+     * when every key shares the same digit, which is the case when the
+     * histogram entry for the first key's digit counts every key.
+     */
+    static inline uint32_t plan_passes(uint32_t* __restrict passes,
+        const SizeType (&hist)[kHistBuckets][kHistSize], uint32_t num_buckets, KeyType first_key,
+        SizeType size)
+    {
+        uint32_t num_passes = 0;
+        for (uint32_t bucket = 0; bucket < num_buckets; ++bucket)
+        {
+            const uint32_t shift = bucket * kRadixBits;
+            const uint32_t pos = (first_key >> shift) & kHistMask;
+            if (hist[bucket][pos] != size)
+            {
+                passes[num_passes++] = bucket;
+            }
+        }
+        return num_passes;
+    }
+
+    /**
+     * Copy keys and values in reverse order.
+     */
+    template <typename ValueOp = LoadValue>
+    static inline void reverse_copy(const KeyType* __restrict keys_in, KeyType* __restrict keys_out,
+        const ValueType* __restrict values_in, ValueType* __restrict values_out, SizeType size,
+        ValueOp value_op = ValueOp())
+    {
+        for (SizeType i = 0; i < size; ++i)
+        {
+            keys_out[i] = keys_in[size - 1 - i];
+            if (kHasValues)
+            {
+                values_out[i] = value_op(values_in, size - 1 - i);
+            }
+        }
+    }
+
+    /**
+     * Number of radix passes needed to sort keys relative to the minimum key,
+     * given the range between the minimum and maximum key.
+     */
+    static inline uint32_t rebased_buckets(KeyType range)
+    {
+        uint32_t range_bits = 0;
+        while (range != 0)
+        {
+            range >>= 1;
+            ++range_bits;
+        }
+        return (range_bits + kRadixBits - 1) / kRadixBits;
+    }
+
+    /**
+     * Replace each histogram entry with the sum of the entries before it,
+     * which is the first index of its digit in the sorted output.
+     */
+    static inline void sum_histograms(SizeType (&hist)[kHistBuckets][kHistSize])
+    {
+        SizeType sum[kHistBuckets];
+        for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+        {
+            sum[bucket] = hist[bucket][0];
+            hist[bucket][0] = 0;
+        }
+
+        SizeType tsum;
+        for (uint32_t i = 1; i < kHistSize; ++i)
+        {
+            for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+            {
+                tsum = hist[bucket][i] + sum[bucket];
+                hist[bucket][i] = sum[bucket];
+                sum[bucket] = tsum;
+            }
+        }
+    }
+
+    /**
+     * Write the values of keys which are already in order. Values read from
+     * the input are already in place, and argsorts write each key's index.
+     */
+    static inline void fill_values(ValueType* __restrict, SizeType, LoadValue)
+    {
+    }
+
+    static inline void fill_values(ValueType* __restrict values, SizeType size, IndexValue value_op)
+    {
+        for (SizeType i = 0; i < size; ++i)
+        {
+            values[i] = value_op(values, i);
+        }
+    }
+
+    /**
+     * Sort with the values of the first pass given by value_op, and the keys
+     * of the last pass encoded by last_encode_op, which is EncodeOp or
+     * DiscardKey when the sorted keys aren't wanted.
+     */
+    template <typename ValueOp, typename LastEncodeOp>
+    uint32_t sort(KeyType* __restrict keys_in, KeyType* __restrict keys_temp,
+        ValueType* __restrict values_in, ValueType* __restrict values_temp, SizeType size,
+        ValueOp value_op, LastEncodeOp last_encode_op) const
+    {
+        DecodeOp decode_op;
+        EncodeOp encode_op;
+        PassThrough pass_through;
+
+        if (size <= 1)
+        {
+            fill_values(values_in, size, value_op);
+            return 0;
+        }
+
+        if (size <= kSmallSortThreshold)
+        {
+            return small_sort<kSmallSortThreshold>(keys_in, keys_temp, values_in, values_temp,
+                static_cast<uint32_t>(size), decode_op, encode_op, value_op);
+        }
+
+        // Already sorted keys are left where they are and strictly descending
+        // keys only need reversing
+        const KeyOrder order = find_order(keys_in + 1, size - 1, decode_op(keys_in[0]));
+        if (order == kKeysAscending)
+        {
+            fill_values(values_in, size, value_op);
+            return 0;
+        }
+        if (order == kKeysDescending)
+        {
+            reverse_copy(keys_in, keys_temp, values_in, values_temp, size, value_op);
+            return 1;
+        }
+
+        // Initialise each histogram bucket with the key value and find the
+        // key range
+        SizeType hist[kHistBuckets][kHistSize] = {};
+        KeyType min_key, max_key;
+        count_keys(hist, kHistBuckets, keys_in, size, 0, min_key, max_key);
+
+        // Skip passes where all keys have the same digit, if every pass is
+        // skipped the keys are already sorted
+        uint32_t passes[kHistBuckets];
+        uint32_t num_passes = plan_passes(passes, hist, kHistBuckets, decode_op(keys_in[0]), size);
+        if (num_passes == 0)
+        {
+            fill_values(values_in, size, value_op);
+            return 0;
+        }
+
+        // If the keys span a narrow range which straddles digit boundaries it
+        // takes fewer passes to sort on the key relative to the minimum key,
+        // in which case build the histograms again for the rebased digits
+        KeyType base = 0;
+        const uint32_t num_rebased = rebased_buckets(KeyType(max_key - min_key));
+        if (num_rebased < num_passes)
+        {
+            base = min_key;
+            std::memset(hist, 0, sizeof(hist[0]) * num_rebased);
+            count_keys(hist, num_rebased, keys_in, size, base, min_key, max_key);
+            num_passes = plan_passes(passes, hist, num_rebased, KeyType(decode_op(keys_in[0]) - base), size);
+        }
+
+        // Update the histogram data so each entry sums the previous entries
+        sum_histograms(hist);
+
+        // alternate input and output buffers on each radix pass
+        KeyType* __restrict keys[2] = {keys_in, keys_temp};
+        ValueType* __restrict values[2] = {values_in, values_temp};
+
+        uint32_t in = 0;
+        uint32_t out = 1;
+
+        const Buffers buffers(resolve_scatter_mode(scatter_mode_, size), kHistSize);
+
+        if (num_passes == 1)
+        {
+            // decode and encode key on the only radix pass
+            const uint32_t bucket = passes[0];
+            scatter_pass(buffers, keys[in], keys[out], values[in], values[out], size, hist[bucket],
+                base, bucket * kRadixBits, decode_op, last_encode_op, value_op);
+            return out;
+        }
+
+        {
+            // decode key on first radix pass
+            const uint32_t bucket = passes[0];
+            scatter_pass(buffers, keys[in], keys[out], values[in], values[out], size, hist[bucket],
+                base, bucket * kRadixBits, decode_op, pass_through, value_op);
+        }
+
+        for (uint32_t pass = 1; pass < num_passes - 1; ++pass)
+        {
+            const uint32_t bucket = passes[pass];
+            in = out;
+            out = !in;
+            scatter_pass(buffers, keys[in], keys[out], values[in], values[out], size, hist[bucket],
+                base, bucket * kRadixBits, pass_through, pass_through);
+        }
+
+        {
+            // encode key on last radix pass
+            const uint32_t bucket = passes[num_passes - 1];
+            in = out;
+            out = !in;
+            scatter_pass(buffers, keys[in], keys[out], values[in], values[out], size, hist[bucket],
+                base, bucket * kRadixBits, pass_through, last_encode_op);
+        }
+
+        return out;
+    }
+
+public:
+    explicit RadixSort(ScatterMode scatter_mode = kScatterAuto)
+        : scatter_mode_(scatter_mode)
+    {
+    }
+
+    uint32_t operator()(KeyType* __restrict keys_in,
+        KeyType* __restrict keys_temp, ValueType* __restrict values_in,
+        ValueType* __restrict values_temp, SizeType size) const
+    {
+        return sort(keys_in, keys_temp, values_in, values_temp, size, LoadValue(), EncodeOp());
+    }
+
+    /**
+     * Sort keys and give each its index in the input as its value, without
+     * reading the input values. When sort_keys is false the last pass doesn't
+     * write keys, and the key buffers are left in an unspecified order.
+     */
+    uint32_t argsort(KeyType* __restrict keys_in, KeyType* __restrict keys_temp,
+        ValueType* __restrict indices_in, ValueType* __restrict indices_temp, SizeType size,
+        bool sort_keys) const
+    {
+        if (sort_keys)
+        {
+            return sort(keys_in, keys_temp, indices_in, indices_temp, size, IndexValue(), EncodeOp());
+        }
+        return sort(keys_in, keys_temp, indices_in, indices_temp, size, IndexValue(), DiscardKey());
+    }
+};
+
+/**
+ * Sort keys and values with 32 bit histogram counts when the size fits in
+ * them, otherwise with 64 bit counts.
+ */
+template <uint32_t kRadixBits, typename DecodeOp, typename EncodeOp, typename KeyType, typename ValueType>
+inline uint32_t radix_sort_size64(KeyType* __restrict keys_in, KeyType* __restrict keys_temp,
+    ValueType* __restrict values_in, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    if (size <= UINT32_MAX)
+    {
+        RadixSort<kRadixBits, KeyType, ValueType, DecodeOp, EncodeOp> sort(scatter_mode);
+        return sort(keys_in, keys_temp, values_in, values_temp, static_cast<uint32_t>(size));
+    }
+    RadixSort<kRadixBits, KeyType, ValueType, DecodeOp, EncodeOp, uint64_t> sort(scatter_mode);
+    return sort(keys_in, keys_temp, values_in, values_temp, static_cast<uint64_t>(size));
+}
+
+/**
+ * The unsigned key type sorted for keys of the given type returned by a record
+ * projection, and the decode op ordering its bits. Integer keys narrower than
+ * 32 bits are widened, keeping their sign.
+ */
+template <typename ProjectedType, typename Enable = void>
+struct RecordKey;
+
+template <typename ProjectedType>
+struct RecordKey<ProjectedType, typename std::enable_if<std::is_integral<ProjectedType>::value>::type>
+{
+    typedef typename std::conditional<(sizeof(ProjectedType) > sizeof(uint32_t)), uint64_t, uint32_t>::type KeyType;
+    typedef typename std::conditional<std::is_signed<ProjectedType>::value, SignFlip, PassThrough>::type DecodeOp;
+
+    static inline KeyType bits(ProjectedType key)
+    {
+        return static_cast<KeyType>(key);
+    }
+};
+
+template <>
+struct RecordKey<float>
+{
+    typedef uint32_t KeyType;
+    typedef FloatFlip DecodeOp;
+
+    static inline KeyType bits(float key)
+    {
+        KeyType bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        return bits;
+    }
+};
+
+template <>
+struct RecordKey<double>
+{
+    typedef uint64_t KeyType;
+    typedef DoubleFlip DecodeOp;
+
+    static inline KeyType bits(double key)
+    {
+        KeyType bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        return bits;
+    }
+};
+
+/**
+ * Internal function object for radix sorting an array of records by the key
+ * a projection returns for each record. The key is taken from the record on
+ * every pass and whole records are scattered, so no key or index buffers are
+ * needed. Passes are planned and skipped as by RadixSort.
+ */
+template <uint32_t kRadixBits, typename RecordType, typename Projection>
+struct RadixSortRecords
+{
+private:
+    typedef typename std::decay<decltype(
+        std::declval<const Projection&>()(std::declval<const RecordType&>()))>::type ProjectedType;
+    static_assert(std::is_integral<ProjectedType>::value || std::is_same<ProjectedType, float>::value ||
+            std::is_same<ProjectedType, double>::value,
+        "record keys must be integers, float or double");
+
+    typedef RecordKey<ProjectedType> Key;
+    typedef typename Key::KeyType KeyType;
+    typedef typename Key::DecodeOp DecodeOp;
+    typedef RadixSort<kRadixBits, KeyType, RecordType, DecodeOp> KeySort;
+
+    static const uint32_t kHistBuckets = KeySort::kHistBuckets;
+    static const uint32_t kHistSize = KeySort::kHistSize;
+    static const uint32_t kHistMask = KeySort::kHistMask;
+    static const uint32_t kSmallSortThreshold = KeySort::kSmallSortThreshold;
+
+    Projection projection_;
+
+    inline KeyType key(const RecordType& record) const
+    {
+        return DecodeOp()(Key::bits(projection_(record)));
+    }
+
+    /**
+     * Find whether records are in ascending or strictly descending order of
+     * their keys, as RadixSort::find_order.
+     */
+    KeyOrder find_order(const RecordType* __restrict records, uint32_t size) const
+    {
+        KeyType prev_key = key(records[0]);
+        uint32_t i = 1;
+        for (; i < size; ++i)
+        {
+            const KeyType record_key = key(records[i]);
+            if (record_key < prev_key)
+            {
+                break;
+            }
+            prev_key = record_key;
+        }
+        if (i == size)
+        {
+            return kKeysAscending;
+        }
+        if (i > 1)
+        {
+            return kKeysUnsorted;
+        }
+        for (; i < size; ++i)
+        {
+            const KeyType record_key = key(records[i]);
+            if (record_key >= prev_key)
+            {
+                return kKeysUnsorted;
+            }
+            prev_key = record_key;
+        }
+        return kKeysDescending;
+    }
+
+    /**
+     * Count the digits of each record's key relative to base into the first
+     * num_buckets histograms, which must be zeroed, and find the range of the
+     * keys.
+     */
+    void count_keys(uint32_t (&hist)[kHistBuckets][kHistSize], uint32_t num_buckets,
+        const RecordType* __restrict records, uint32_t size, KeyType base, KeyType& min_key,
+        KeyType& max_key) const
+    {
+        KeyType key_min = KeyType(~KeyType(0));
+        KeyType key_max = 0;
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            const KeyType record_key = KeyType(key(records[i]) - base);
+            key_min = record_key < key_min ? record_key : key_min;
+            key_max = record_key > key_max ? record_key : key_max;
+            for (uint32_t bucket = 0; bucket < num_buckets; ++bucket)
+            {
+                const uint32_t shift = bucket * kRadixBits;
+                const uint32_t pos = (record_key >> shift) & kHistMask;
+                ++hist[bucket][pos];
+            }
+        }
+        min_key = key_min;
+        max_key = key_max;
+    }
+
+    /**
+     * Perform a radix sort pass of whole records for the given bit shift,
+     * with digits taken from each record's key relative to base.
+     */
+    void radix_pass(const RecordType* __restrict records_in, RecordType* __restrict records_out,
+        uint32_t size, uint32_t* __restrict hist, KeyType base, KeyType shift) const
+    {
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            const KeyType pos = (KeyType(key(records_in[i]) - base) >> shift) & kHistMask;
+            records_out[hist[pos]++] = records_in[i];
+        }
+    }
+
+public:
+    explicit RadixSortRecords(Projection projection)
+        : projection_(projection)
+    {
+    }
+
+    uint32_t operator()(RecordType* __restrict records_in, RecordType* __restrict records_temp,
+        uint32_t size) const
+    {
+        if (size <= 1)
+        {
+            return 0;
+        }
+
+        // small arrays sort their keys and indices with the sorting network,
+        // then gather the records
+        if (size <= kSmallSortThreshold)
+        {
+            KeyType keys[kSmallSortThreshold];
+            KeyType keys_temp[kSmallSortThreshold];
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                keys[i] = key(records_in[i]);
+            }
+            return small_sort<kSmallSortThreshold>(keys, keys_temp, records_in, records_temp, size,
+                PassThrough(), PassThrough());
+        }
+
+        const KeyOrder order = find_order(records_in, size);
+        if (order == kKeysAscending)
+        {
+            return 0;
+        }
+        if (order == kKeysDescending)
+        {
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                records_temp[i] = records_in[size - 1 - i];
+            }
+            return 1;
+        }
+
+        uint32_t hist[kHistBuckets][kHistSize] = {};
+        KeyType min_key, max_key;
+        count_keys(hist, kHistBuckets, records_in, size, 0, min_key, max_key);
+
+        const KeyType first_key = key(records_in[0]);
+        uint32_t passes[kHistBuckets];
+        uint32_t num_passes = KeySort::plan_passes(passes, hist, kHistBuckets, first_key, size);
+        if (num_passes == 0)
+        {
+            return 0;
+        }
+
+        KeyType base = 0;
+        const uint32_t num_rebased = KeySort::rebased_buckets(KeyType(max_key - min_key));
+        if (num_rebased < num_passes)
+        {
+            base = min_key;
+            std::memset(hist, 0, sizeof(hist[0]) * num_rebased);
+            count_keys(hist, num_rebased, records_in, size, base, min_key, max_key);
+            num_passes = KeySort::plan_passes(passes, hist, num_rebased, KeyType(first_key - base), size);
+        }
+
+        KeySort::sum_histograms(hist);
+
+        RecordType* __restrict records[2] = {records_in, records_temp};
+        uint32_t out = 0;
+        for (uint32_t pass = 0; pass < num_passes; ++pass)
+        {
+            const uint32_t bucket = passes[pass];
+            radix_pass(records[out], records[!out], size, hist[bucket], base, bucket * kRadixBits);
+            out = !out;
+        }
+        return out;
+    }
+};
+
+/**
+ * Width of the given digit of a DigitPlan.
+ */
+template <typename Plan>
+constexpr uint32_t digit_bits(uint32_t digit)
+{
+    return Plan::kDigitBits[digit];
+}
+
+/**
+ * Position of the lowest bit of the given digit of a DigitPlan, which for
+ * the number of digits is the number of bits the plan covers.
+ */
+template <typename Plan>
+constexpr uint32_t digit_shift(uint32_t digit)
+{
+    uint32_t shift = 0;
+    for (uint32_t i = 0; i < digit; ++i)
+    {
+        shift += Plan::kDigitBits[i];
+    }
+    return shift;
+}
+
+/**
+ * Offset of the given digit's histogram when the histograms of all the digits
+ * of a DigitPlan are stored one after another.
+ */
+template <typename Plan>
+constexpr uint32_t digit_hist_offset(uint32_t digit)
+{
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < digit; ++i)
+    {
+        offset += 1 << Plan::kDigitBits[i];
+    }
+    return offset;
+}
+
+template <typename Plan>
+constexpr uint32_t min_digit_bits()
+{
+    uint32_t bits = Plan::kDigitBits[0];
+    for (uint32_t i = 1; i < Plan::kNumDigits; ++i)
+    {
+        bits = Plan::kDigitBits[i] < bits ? Plan::kDigitBits[i] : bits;
+    }
+    return bits;
+}
+
+template <typename Plan>
+constexpr uint32_t max_digit_bits()
+{
+    uint32_t bits = Plan::kDigitBits[0];
+    for (uint32_t i = 1; i < Plan::kNumDigits; ++i)
+    {
+        bits = Plan::kDigitBits[i] > bits ? Plan::kDigitBits[i] : bits;
+    }
+    return bits;
+}
+
+/**
+ * Internal function object for performing radix sort with the digit widths of
+ * a DigitPlan. Each pass uses the scatter of the RadixSort with its digit's
+ * width.
+ */
+template <typename Plan, typename KeyType, typename ValueType,
+    typename DecodeOp = PassThrough, typename EncodeOp = PassThrough>
+struct RadixSortPlan
+{
+private:
+    static const uint32_t kNumDigits = Plan::kNumDigits;
+    static const uint32_t kKeyBits = sizeof(KeyType) * 8;
+    static const uint32_t kMaxBits = max_digit_bits<Plan>();
+    static const uint32_t kHistEntries = digit_hist_offset<Plan>(kNumDigits);
+
+    static_assert(kNumDigits > 0, "a digit plan needs at least one digit");
+    static_assert(min_digit_bits<Plan>() >= 1 && kMaxBits <= 16, "digits must be 1 to 16 bits wide");
+    static_assert(digit_shift<Plan>(kNumDigits) >= kKeyBits, "the digits must cover every bit of the key");
+    static_assert(digit_shift<Plan>(kNumDigits - 1) < kKeyBits, "every digit must start within the key");
+
+    // histograms taking more than this many bytes are allocated rather than
+    // put on the stack, which allows for six 11 bit digits
+    static const uint32_t kMaxStackHistBytes = 1 << 16;
+    static const bool kHeapHist = kHistEntries * sizeof(uint32_t) > kMaxStackHistBytes;
+
+    // digits wider than this are scattered directly, as the line buffers and
+    // blocks of the other scatters would no longer fit in cache
+    static const uint32_t kMaxStagedBits = 11;
+    static const uint32_t kMaxStagedHistSize = 1 << (kMaxBits < kMaxStagedBits ? kMaxBits : kMaxStagedBits);
+
+    typedef ScatterBuffers<KeyType, ValueType> Buffers;
+
+    template <uint32_t kBits>
+    using DigitSort = RadixSort<kBits, KeyType, ValueType, DecodeOp, EncodeOp>;
+
+    // the sort with the widest digit, whose helpers don't depend on the width
+    typedef DigitSort<kMaxBits> WideSort;
+
+    ScatterMode scatter_mode_;
+
+    /**
+     * Count the digits of each key relative to base into the histograms of the
+     * first num_digits digits, which must be zeroed, and find the range of the
+     * keys.
+     */
+    static inline void count_keys(uint32_t* __restrict hist, uint32_t num_digits,
+        const KeyType* __restrict keys_in, uint32_t size, KeyType base, KeyType& min_key, KeyType& max_key)
+    {
+        DecodeOp decode_op;
+        uint32_t shifts[kNumDigits];
+        uint32_t masks[kNumDigits];
+        uint32_t* __restrict digit_hist[kNumDigits];
+        for (uint32_t digit = 0; digit < kNumDigits; ++digit)
+        {
+            shifts[digit] = digit_shift<Plan>(digit);
+            masks[digit] = (1 << digit_bits<Plan>(digit)) - 1;
+            digit_hist[digit] = hist + digit_hist_offset<Plan>(digit);
+        }
+
+        KeyType key_min = KeyType(~KeyType(0));
+        KeyType key_max = 0;
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            const KeyType key = KeyType(decode_op(keys_in[i]) - base);
+            key_min = key < key_min ? key : key_min;
+            key_max = key > key_max ? key : key_max;
+            for (uint32_t digit = 0; digit < num_digits; ++digit)
+            {
+                ++digit_hist[digit][(key >> shifts[digit]) & masks[digit]];
+            }
+        }
+        min_key = key_min;
+        max_key = key_max;
+    }
+
+    /**
+     * Find the digits which need a radix pass, skipping those where every key
+     * shares the first key's digit.
+     */
+    static inline uint32_t plan_passes(uint32_t* __restrict passes, const uint32_t* __restrict hist,
+        uint32_t num_digits, KeyType first_key, uint32_t size)
+    {
+        uint32_t num_passes = 0;
+        for (uint32_t digit = 0; digit < num_digits; ++digit)
+        {
+            const uint32_t pos = (first_key >> digit_shift<Plan>(digit)) & ((1 << digit_bits<Plan>(digit)) - 1);
+            if (hist[digit_hist_offset<Plan>(digit) + pos] != size)
+            {
+                passes[num_passes++] = digit;
+            }
+        }
+        return num_passes;
+    }
+
+    /**
+     * Number of digits needed to sort keys relative to the minimum key, given
+     * the range between the minimum and maximum key.
+     */
+    static inline uint32_t rebased_digits(KeyType range)
+    {
+        uint32_t range_bits = 0;
+        while (range != 0)
+        {
+            range >>= 1;
+            ++range_bits;
+        }
+        uint32_t num_digits = 0;
+        while (digit_shift<Plan>(num_digits) < range_bits)
+        {
+            ++num_digits;
+        }
+        return num_digits;
+    }
+
+    /**
+     * Perform the radix pass for the given digit, finding the width of the
+     * digit from kDigit onwards.
+     */
+    template <uint32_t kDigit, typename PassDecodeOp, typename PassEncodeOp>
+    static inline void scatter_digit(std::integral_constant<uint32_t, kDigit>, uint32_t digit,
+        const Buffers& buffers, const KeyType* __restrict keys_in, KeyType* __restrict keys_out,
+        const ValueType* __restrict values_in, ValueType* __restrict values_out, uint32_t size,
+        uint32_t* __restrict hist, KeyType base, PassDecodeOp decode_op, PassEncodeOp encode_op)
+    {
+        static const uint32_t kBits = digit_bits<Plan>(kDigit);
+        if (digit == kDigit)
+        {
+            const Buffers direct(kScatterDirect, 0);
+            DigitSort<kBits>::scatter_pass(kBits > kMaxStagedBits ? direct : buffers, keys_in,
+                keys_out, values_in, values_out, size, hist + digit_hist_offset<Plan>(kDigit), base,
+                digit_shift<Plan>(kDigit), decode_op, encode_op);
+            return;
+        }
+        scatter_digit(std::integral_constant<uint32_t, kDigit + 1>(), digit, buffers, keys_in, keys_out,
+            values_in, values_out, size, hist, base, decode_op, encode_op);
+    }
+
+    template <typename PassDecodeOp, typename PassEncodeOp>
+    static inline void scatter_digit(std::integral_constant<uint32_t, kNumDigits>, uint32_t, const Buffers&,
+        const KeyType* __restrict, KeyType* __restrict, const ValueType* __restrict, ValueType* __restrict,
+        uint32_t, uint32_t* __restrict, KeyType, PassDecodeOp, PassEncodeOp)
+    {
+    }
+
+    uint32_t sort(KeyType* __restrict keys_in, KeyType* __restrict keys_temp, ValueType* __restrict values_in,
+        ValueType* __restrict values_temp, uint32_t size, uint32_t* __restrict hist) const
+    {
+        DecodeOp decode_op;
+        EncodeOp encode_op;
+        PassThrough pass_through;
+
+        if (size <= 1)
+        {
+            return 0;
+        }
+
+        if (size <= WideSort::kSmallSortThreshold)
+        {
+            return small_sort<WideSort::kSmallSortThreshold>(keys_in, keys_temp, values_in, values_temp, size,
+                decode_op, encode_op);
+        }
+
+        const KeyOrder order = WideSort::find_order(keys_in + 1, size - 1, decode_op(keys_in[0]));
+        if (order == kKeysAscending)
+        {
+            return 0;
+        }
+        if (order == kKeysDescending)
+        {
+            WideSort::reverse_copy(keys_in, keys_temp, values_in, values_temp, size);
+            return 1;
+        }
+
+        std::memset(hist, 0, sizeof(uint32_t) * kHistEntries);
+        KeyType min_key, max_key;
+        count_keys(hist, kNumDigits, keys_in, size, 0, min_key, max_key);
+
+        uint32_t passes[kNumDigits];
+        uint32_t num_passes = plan_passes(passes, hist, kNumDigits, decode_op(keys_in[0]), size);
+        if (num_passes == 0)
+        {
+            return 0;
+        }
+
+        // Sort relative to the minimum key when that needs fewer passes
+        KeyType base = 0;
+        const uint32_t num_rebased = rebased_digits(KeyType(max_key - min_key));
+        if (num_rebased < num_passes)
+        {
+            base = min_key;
+            std::memset(hist, 0, sizeof(uint32_t) * digit_hist_offset<Plan>(num_rebased));
+            count_keys(hist, num_rebased, keys_in, size, base, min_key, max_key);
+            num_passes = plan_passes(passes, hist, num_rebased, KeyType(decode_op(keys_in[0]) - base), size);
+        }
+
+        // Update the histogram data so each entry sums the previous entries
+        for (uint32_t digit = 0; digit < kNumDigits; ++digit)
+        {
+            uint32_t* __restrict digit_hist = hist + digit_hist_offset<Plan>(digit);
+            const uint32_t hist_size = 1 << digit_bits<Plan>(digit);
+            uint32_t sum = 0;
+            for (uint32_t i = 0; i < hist_size; ++i)
+            {
+                const uint32_t count = digit_hist[i];
+                digit_hist[i] = sum;
+                sum += count;
+            }
+        }
+
+        KeyType* __restrict keys[2] = {keys_in, keys_temp};
+        ValueType* __restrict values[2] = {values_in, values_temp};
+
+        uint32_t in = 0;
+        uint32_t out = 1;
+
+        // the buffers fit the widest digit which is staged
+        const Buffers buffers(WideSort::resolve_scatter_mode(scatter_mode_, size), kMaxStagedHistSize);
+        const std::integral_constant<uint32_t, 0> first_digit;
+
+        // single digit plans always take this branch
+        if (kNumDigits == 1 || num_passes == 1)
+        {
+            scatter_digit(first_digit, passes[0], buffers, keys[in], keys[out], values[in], values[out],
+                size, hist, base, decode_op, encode_op);
+            return out;
+        }
+
+        scatter_digit(first_digit, passes[0], buffers, keys[in], keys[out], values[in], values[out], size,
+            hist, base, decode_op, pass_through);
+
+        for (uint32_t pass = 1; pass < num_passes - 1; ++pass)
+        {
+            in = out;
+            out = !in;
+            scatter_digit(first_digit, passes[pass], buffers, keys[in], keys[out], values[in], values[out],
+                size, hist, base, pass_through, pass_through);
+        }
+
+        in = out;
+        out = !in;
+        scatter_digit(first_digit, passes[num_passes - 1], buffers, keys[in], keys[out], values[in],
+            values[out], size, hist, base, pass_through, encode_op);
+
+        return out;
+    }
+
+public:
+    explicit RadixSortPlan(ScatterMode scatter_mode = kScatterAuto)
+        : scatter_mode_(scatter_mode)
+    {
+    }
+
+    uint32_t operator()(KeyType* __restrict keys_in, KeyType* __restrict keys_temp,
+        ValueType* __restrict values_in, ValueType* __restrict values_temp, uint32_t size) const
+    {
+        // only plans with large histograms allocate them
+        uint32_t stack_hist[kHeapHist ? 1 : kHistEntries];
+        std::vector<uint32_t> heap_hist(kHeapHist ? kHistEntries : 0);
+        uint32_t* __restrict hist = kHeapHist ? heap_hist.data() : stack_hist;
+
+        const uint32_t out = sort(keys_in, keys_temp, values_in, values_temp, size, hist);
+
+        // Plans with an even number of digits always leave the result in the
+        // input buffers, which only needs a copy when passes were skipped
+        if (kNumDigits % 2 == 0 && out == 1)
+        {
+            std::memcpy(keys_in, keys_temp, sizeof(KeyType) * size);
+            if (!std::is_same<ValueType, NoValue>::value)
+            {
+                std::memcpy(values_in, values_temp, sizeof(ValueType) * size);
+            }
+            return 0;
+        }
+        return out;
+    }
+};
+
+/**
+ * Run fn(thread_index) for each of the given number of threads, the calling
+ * thread being thread 0, and wait for them all to finish. Work for threads
+ * which can't be started is run on the calling thread.
+ */
+template <typename Fn>
+inline void parallel_for(uint32_t num_threads, const Fn& fn)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    uint32_t thread_index = 1;
+    try
+    {
+        for (; thread_index < num_threads; ++thread_index)
+        {
+            threads.emplace_back(fn, thread_index);
+        }
+    }
+    catch (const std::system_error&)
+    {
+    }
+    fn(0);
+    for (; thread_index < num_threads; ++thread_index)
+    {
+        fn(thread_index);
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+/**
+ * Internal function object for performing radix sort on multiple threads.
+ * The keys are split into a contiguous chunk per thread. Each thread counts
+ * the digits in its chunk, then each thread's offsets start after the same
+ * digit in all earlier chunks, so every thread can scatter its chunk at once
+ * and the result is stable and identical to RadixSort.
+ */
+template <uint32_t kRadixBits, typename KeyType, typename ValueType,
+    typename DecodeOp = PassThrough, typename EncodeOp = PassThrough>
+struct RadixSortParallel
+{
+private:
+    static const uint32_t kHistBuckets = 1 + (((sizeof(KeyType) * 8) - 1) / kRadixBits);
+    static const uint32_t kHistSize = (1 << kRadixBits);
+    static const uint32_t kHistMask = kHistSize - 1;
+
+    // each thread is given at least this many keys, smaller arrays use fewer
+    // threads and arrays too small for two threads use RadixSort
+    static const uint32_t kMinKeysPerThread = 1 << 16;
+
+    typedef RadixSort<kRadixBits, KeyType, ValueType, DecodeOp, EncodeOp> SerialSort;
+    typedef ScatterBuffers<KeyType, ValueType> Buffers;
+
+    ScatterMode scatter_mode_;
+
+    struct ThreadState
+    {
+        uint32_t hist[kHistBuckets][kHistSize];
+        KeyType min_key;
+        KeyType max_key;
+        KeyOrder order;
+    };
+
+    static inline uint32_t chunk_begin(uint32_t size, uint32_t num_threads, uint32_t thread_index)
+    {
+        return static_cast<uint32_t>((uint64_t(size) * thread_index) / num_threads);
+    }
+
+    /**
+     * Build each thread's histograms for the key relative to the given base,
+     * also finding the key range and the order of its chunk, then sum them
+     * into hist.
+     */
+    static void init_histograms(std::vector<ThreadState>& state, uint32_t (&hist)[kHistBuckets][kHistSize],
+        uint32_t num_buckets, const KeyType* __restrict keys_in, uint32_t size, KeyType base)
+    {
+        DecodeOp decode_op;
+        const uint32_t num_threads = static_cast<uint32_t>(state.size());
+        parallel_for(num_threads, [&](uint32_t thread_index) {
+            const uint32_t begin = chunk_begin(size, num_threads, thread_index);
+            const uint32_t end = chunk_begin(size, num_threads, thread_index + 1);
+
+            // The first key of each chunk is compared with the last key of the
+            // previous chunk, the first chunk starting from its first key
+            const uint32_t first = begin > 0 ? begin : 1;
+            ThreadState& thread_state = state[thread_index];
+            thread_state.order = SerialSort::find_order(keys_in + first, end - first, decode_op(keys_in[first - 1]));
+
+            uint32_t chunk_hist[kHistBuckets][kHistSize];
+            std::memset(chunk_hist, 0, sizeof(chunk_hist[0]) * num_buckets);
+            SerialSort::count_keys(chunk_hist, num_buckets, keys_in + begin, end - begin, base,
+                thread_state.min_key, thread_state.max_key);
+            std::memcpy(thread_state.hist, chunk_hist, sizeof(chunk_hist[0]) * num_buckets);
+        });
+
+        std::memset(hist, 0, sizeof(hist[0]) * num_buckets);
+        for (const ThreadState& thread_state : state)
+        {
+            for (uint32_t bucket = 0; bucket < num_buckets; ++bucket)
+            {
+                for (uint32_t i = 0; i < kHistSize; ++i)
+                {
+                    hist[bucket][i] += thread_state.hist[bucket][i];
+                }
+            }
+        }
+    }
+
+    /**
+     * Perform a radix pass on every thread. Unless this is the first pass,
+     * whose digits were counted by init_histograms, each thread first counts
+     * the digits of its chunk of the input, and scatters it with its own
+     * buffers.
+     */
+    template <typename PassDecodeOp, typename PassEncodeOp>
+    static void radix_pass(std::vector<ThreadState>& state, const std::vector<Buffers>& buffers, bool count,
+        const KeyType* __restrict keys_in, KeyType* __restrict keys_out, const ValueType* __restrict values_in,
+        ValueType* __restrict values_out, uint32_t size, uint32_t bucket, KeyType base, PassDecodeOp decode_op,
+        PassEncodeOp encode_op)
+    {
+        const uint32_t num_threads = static_cast<uint32_t>(state.size());
+        const uint32_t shift = bucket * kRadixBits;
+
+        if (count)
+        {
+            parallel_for(num_threads, [&](uint32_t thread_index) {
+                const uint32_t begin = chunk_begin(size, num_threads, thread_index);
+                const uint32_t end = chunk_begin(size, num_threads, thread_index + 1);
+                uint32_t chunk_hist[kHistSize] = {};
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    const KeyType key = decode_op(keys_in[i]);
+                    ++chunk_hist[(KeyType(key - base) >> shift) & kHistMask];
+                }
+                std::memcpy(state[thread_index].hist[bucket], chunk_hist, sizeof(chunk_hist));
+            });
+        }
+
+        // Keys with the same digit are written in chunk order
+        uint32_t offset = 0;
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            for (ThreadState& thread_state : state)
+            {
+                const uint32_t digit_count = thread_state.hist[bucket][i];
+                thread_state.hist[bucket][i] = offset;
+                offset += digit_count;
+            }
+        }
+
+        parallel_for(num_threads, [&](uint32_t thread_index) {
+            const uint32_t begin = chunk_begin(size, num_threads, thread_index);
+            const uint32_t end = chunk_begin(size, num_threads, thread_index + 1);
+            SerialSort::scatter_pass(buffers[thread_index], keys_in + begin, keys_out, values_in + begin, values_out,
+                end - begin, state[thread_index].hist[bucket], base, shift, decode_op, encode_op);
+        });
+    }
+
+public:
+    explicit RadixSortParallel(ScatterMode scatter_mode = kScatterAuto)
+        : scatter_mode_(scatter_mode)
+    {
+    }
+
+    uint32_t operator()(KeyType* __restrict keys_in,
+        KeyType* __restrict keys_temp, ValueType* __restrict values_in,
+        ValueType* __restrict values_temp, uint32_t size, uint32_t num_threads) const
+    {
+        DecodeOp decode_op;
+        EncodeOp encode_op;
+        PassThrough pass_through;
+
+        if (num_threads == 0)
+        {
+            num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        num_threads = std::min(num_threads, size / kMinKeysPerThread);
+        if (num_threads <= 1)
+        {
+            return SerialSort(scatter_mode_)(keys_in, keys_temp, values_in, values_temp, size);
+        }
+
+        std::vector<ThreadState> state(num_threads);
+        uint32_t hist[kHistBuckets][kHistSize];
+        init_histograms(state, hist, kHistBuckets, keys_in, size, 0);
+
+        KeyType min_key = state[0].min_key;
+        KeyType max_key = state[0].max_key;
+        bool ascending = true;
+        bool descending = true;
+        for (const ThreadState& thread_state : state)
+        {
+            min_key = std::min(min_key, thread_state.min_key);
+            max_key = std::max(max_key, thread_state.max_key);
+            ascending = ascending && thread_state.order == kKeysAscending;
+            descending = descending && thread_state.order == kKeysDescending;
+        }
+
+        // Already sorted keys are left where they are and strictly descending
+        // keys only need reversing
+        if (ascending)
+        {
+            return 0;
+        }
+        if (descending)
+        {
+            parallel_for(num_threads, [&](uint32_t thread_index) {
+                const uint32_t begin = chunk_begin(size, num_threads, thread_index);
+                const uint32_t end = chunk_begin(size, num_threads, thread_index + 1);
+                SerialSort::reverse_copy(keys_in + size - end, keys_temp + begin, values_in + size - end,
+                    values_temp + begin, end - begin);
+            });
+            return 1;
+        }
+
+        // Plan passes exactly as RadixSort does so the same buffer is returned
+        uint32_t passes[kHistBuckets];
+        uint32_t num_passes = SerialSort::plan_passes(passes, hist, kHistBuckets, decode_op(keys_in[0]), size);
+        if (num_passes == 0)
+        {
+            return 0;
+        }
+
+        KeyType base = 0;
+        const uint32_t num_rebased = SerialSort::rebased_buckets(KeyType(max_key - min_key));
+        if (num_rebased < num_passes)
+        {
+            base = min_key;
+            init_histograms(state, hist, num_rebased, keys_in, size, base);
+            num_passes = SerialSort::plan_passes(passes, hist, num_rebased,
+                KeyType(decode_op(keys_in[0]) - base), size);
+        }
+
+        // alternate input and output buffers on each radix pass
+        KeyType* __restrict keys[2] = {keys_in, keys_temp};
+        ValueType* __restrict values[2] = {values_in, values_temp};
+
+        uint32_t in = 0;
+        uint32_t out = 1;
+
+        const ScatterMode scatter_mode = SerialSort::resolve_scatter_mode(scatter_mode_, size);
+        std::vector<Buffers> buffers;
+        buffers.reserve(num_threads);
+        for (uint32_t thread_index = 0; thread_index < num_threads; ++thread_index)
+        {
+            buffers.emplace_back(scatter_mode, uint32_t(kHistSize));
+        }
+
+        if (num_passes == 1)
+        {
+            // decode and encode key on the only radix pass
+            radix_pass(state, buffers, false, keys[in], keys[out], values[in], values[out], size, passes[0], base,
+                decode_op, encode_op);
+            return out;
+        }
+
+        // decode key on first radix pass
+        radix_pass(state, buffers, false, keys[in], keys[out], values[in], values[out], size, passes[0], base,
+            decode_op, pass_through);
+
+        for (uint32_t pass = 1; pass < num_passes - 1; ++pass)
+        {
+            in = out;
+            out = !in;
+            radix_pass(state, buffers, true, keys[in], keys[out], values[in], values[out], size, passes[pass], base,
+                pass_through, pass_through);
+        }
+
+        // encode key on last radix pass
+        in = out;
+        out = !in;
+        radix_pass(state, buffers, true, keys[in], keys[out], values[in], values[out], size, passes[num_passes - 1],
+            base, pass_through, encode_op);
+
+        return out;
+    }
+};
+
+template <typename KeyType, typename ValueType, typename DecodeOp, typename EncodeOp>
+struct RadixSortMSDParallel;
+
+/**
+ * Internal function object for performing most significant digit first radix
+ * sort. Keys are partitioned on their highest varying 8 bit digit, then each
+ * partition is sorted recursively until it fits in cache, where it is
+ * finished with the LSD RadixSort. This streams large arrays through memory
+ * far fewer times than a pure LSD sort.
+ */
+template <typename KeyType, typename ValueType,
+    typename DecodeOp = PassThrough, typename EncodeOp = PassThrough>
+struct RadixSortMSD
+{
+private:
+    static const uint32_t kRadixBits = 8;
+    static const uint32_t kHistBuckets = 1 + (((sizeof(KeyType) * 8) - 1) / kRadixBits);
+    static const uint32_t kHistSize = (1 << kRadixBits);
+    static const uint32_t kHistMask = kHistSize - 1;
+
+    // partitions whose keys and values, plus their temporary buffers, fit in
+    // this many bytes are finished with the LSD sort
+    static const uint32_t kCacheBytes = 1 << 20;
+    static const uint32_t kLSDThreshold = kCacheBytes / (2 * (sizeof(KeyType) + sizeof(ValueType)));
+
+    typedef RadixSort<kRadixBits, KeyType, ValueType, DecodeOp, EncodeOp> LSDSort;
+
+    friend struct RadixSortMSDParallel<KeyType, ValueType, DecodeOp, EncodeOp>;
+
+    /**
+     * Partition keys and values from buffer a into buffer b on their highest
+     * varying digit, only considering digits up to and including the given
+     * bucket, filling offsets with the start of each partition. The original
+     * keys are stored. Returns the digit's bucket, or a bucket greater than
+     * max_bucket, leaving buffer b untouched, if all keys are the same.
+     */
+    static uint32_t partition(const KeyType* __restrict keys_a, KeyType* __restrict keys_b,
+        const ValueType* __restrict values_a, ValueType* __restrict values_b, uint32_t size,
+        uint32_t max_bucket, uint32_t (&offsets)[kHistSize + 1])
+    {
+        DecodeOp decode_op;
+
+        // Count every digit at once so digits where all keys are the same can
+        // be skipped without reading the keys again
+        uint32_t hist[kHistBuckets][kHistSize] = {};
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            const KeyType key = decode_op(keys_a[i]);
+            for (uint32_t bucket = 0; bucket <= max_bucket; ++bucket)
+            {
+                const uint32_t shift = bucket * kRadixBits;
+                const uint32_t pos = (key >> shift) & kHistMask;
+                ++hist[bucket][pos];
+            }
+        }
+
+        // Find the most significant digit which varies
+        const KeyType first_key = decode_op(keys_a[0]);
+        uint32_t bucket = max_bucket + 1;
+        while (bucket-- > 0)
+        {
+            if (hist[bucket][(first_key >> (bucket * kRadixBits)) & kHistMask] != size)
+            {
+                break;
+            }
+        }
+        if (bucket > max_bucket)
+        {
+            return bucket;
+        }
+
+        const uint32_t shift = bucket * kRadixBits;
+        offsets[0] = 0;
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            offsets[i + 1] = offsets[i] + hist[bucket][i];
+        }
+        uint32_t* __restrict next = hist[bucket];
+        std::memcpy(next, offsets, sizeof(uint32_t) * kHistSize);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            const KeyType key = keys_a[i];
+            const uint32_t pos = (decode_op(key) >> shift) & kHistMask;
+            const uint32_t index = next[pos]++;
+            keys_b[index] = key;
+            values_b[index] = values_a[i];
+        }
+        return bucket;
+    }
+
+    /**
+     * Sort keys and values in buffer a using buffer b as temporary storage,
+     * only considering digits up to and including the given bucket. Returns
+     * the buffer holding the sorted data, 0 for a and 1 for b.
+     */
+    static uint32_t sort(KeyType* __restrict keys_a, KeyType* __restrict keys_b,
+        ValueType* __restrict values_a, ValueType* __restrict values_b, uint32_t size,
+        uint32_t max_bucket)
+    {
+        if (size <= kLSDThreshold)
+        {
+            return LSDSort()(keys_a, keys_b, values_a, values_b, size);
+        }
+
+        uint32_t offsets[kHistSize + 1];
+        const uint32_t bucket = partition(keys_a, keys_b, values_a, values_b, size, max_bucket, offsets);
+        if (bucket > max_bucket)
+        {
+            // all keys are the same
+            return 0;
+        }
+
+        // Sort each partition, recording which buffer it ends up in
+        uint8_t partition_out[kHistSize];
+        uint32_t size_in_b = 0;
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            const uint32_t begin = offsets[i];
+            const uint32_t count = offsets[i + 1] - begin;
+            uint32_t out = 0;
+            if (count > 1 && bucket > 0)
+            {
+                out = sort(keys_b + begin, keys_a + begin, values_b + begin, values_a + begin, count,
+                    bucket - 1);
+            }
+            partition_out[i] = static_cast<uint8_t>(out);
+            size_in_b += out == 0 ? count : 0;
+        }
+
+        // Gather the partitions into whichever buffer holds most of the keys
+        const uint32_t out = size_in_b >= size - size_in_b ? 1 : 0;
+        KeyType* __restrict keys[2] = {keys_b, keys_a};
+        ValueType* __restrict values[2] = {values_b, values_a};
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            const uint32_t in = partition_out[i];
+            if (in != !out)
+            {
+                const uint32_t begin = offsets[i];
+                const uint32_t count = offsets[i + 1] - begin;
+                std::memcpy(keys[!in] + begin, keys[in] + begin, sizeof(KeyType) * count);
+                std::memcpy(values[!in] + begin, values[in] + begin, sizeof(ValueType) * count);
+            }
+        }
+        return out;
+    }
+
+public:
+    uint32_t operator()(KeyType* __restrict keys_in,
+        KeyType* __restrict keys_temp, ValueType* __restrict values_in,
+        ValueType* __restrict values_temp, uint32_t size) const
+    {
+        return sort(keys_in, keys_temp, values_in, values_temp, size, kHistBuckets - 1);
+    }
+};
+
+/**
+ * Internal function object for performing most significant digit first radix
+ * sort on multiple threads. The whole array is partitioned on its highest
+ * varying digit by all threads at once, as RadixSortParallel does a pass.
+ * Each partition then becomes a task on a per-thread work stealing deque:
+ * tasks too large to fit in cache are partitioned again into new tasks and
+ * the rest are finished with the LSD RadixSort. Threads take their own most
+ * recent task and steal the oldest, and so largest, task from other threads,
+ * which keeps threads busy when skewed keys make partitions uneven.
+ */
+template <typename KeyType, typename ValueType,
+    typename DecodeOp = PassThrough, typename EncodeOp = PassThrough>
+struct RadixSortMSDParallel
+{
+private:
+    typedef RadixSortMSD<KeyType, ValueType, DecodeOp, EncodeOp> SerialSort;
+    typedef typename SerialSort::LSDSort LSDSort;
+
+    static const uint32_t kRadixBits = SerialSort::kRadixBits;
+    static const uint32_t kHistBuckets = SerialSort::kHistBuckets;
+    static const uint32_t kHistSize = SerialSort::kHistSize;
+    static const uint32_t kHistMask = SerialSort::kHistMask;
+    static const uint32_t kLSDThreshold = SerialSort::kLSDThreshold;
+
+    // each thread is given at least this many keys, smaller arrays use fewer
+    // threads and arrays too small for two threads use RadixSortMSD
+    static const uint32_t kMinKeysPerThread = 1 << 16;
+
+    /**
+     * A partition to sort, held in the given buffer, where only digits below
+     * num_buckets can vary.
+     */
+    struct Task
+    {
+        uint32_t begin;
+        uint32_t size;
+        uint32_t num_buckets;
+        uint32_t in;
+    };
+
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct SharedState
+    {
+        KeyType* keys[2];
+        ValueType* values[2];
+        std::vector<TaskQueue> queues;
+        // tasks which have been queued but not yet finished
+        std::atomic<uint32_t> pending;
+
+        explicit SharedState(uint32_t num_threads) : queues(num_threads), pending(0) {}
+    };
+
+    static inline uint32_t chunk_begin(uint32_t size, uint32_t num_threads, uint32_t thread_index)
+    {
+        return static_cast<uint32_t>((uint64_t(size) * thread_index) / num_threads);
+    }
+
+    /**
+     * Copy a sorted range into buffer 0, where every task leaves its result.
+     */
+    static void move_to_output(SharedState& shared, uint32_t in, uint32_t begin, uint32_t size)
+    {
+        if (in != 0)
+        {
+            std::memcpy(shared.keys[0] + begin, shared.keys[1] + begin, sizeof(KeyType) * size);
+            std::memcpy(shared.values[0] + begin, shared.values[1] + begin, sizeof(ValueType) * size);
+        }
+    }
+
+    /**
+     * Queue a partition as a task, or move it straight to the output if there
+     * is nothing left to sort.
+     */
+    static void push_task(SharedState& shared, uint32_t thread_index, const Task& task)
+    {
+        if (task.size <= 1 || task.num_buckets == 0)
+        {
+            move_to_output(shared, task.in, task.begin, task.size);
+            return;
+        }
+        TaskQueue& queue = shared.queues[thread_index];
+        shared.pending.fetch_add(1);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+    }
+
+    /**
+     * Take the most recent task from this thread's queue, or failing that
+     * steal the oldest task from another thread's queue.
+     */
+    static bool pop_task(SharedState& shared, uint32_t thread_index, Task& task)
+    {
+        const uint32_t num_threads = static_cast<uint32_t>(shared.queues.size());
+        {
+            TaskQueue& queue = shared.queues[thread_index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+                return true;
+            }
+        }
+        for (uint32_t i = 1; i < num_threads; ++i)
+        {
+            TaskQueue& queue = shared.queues[(thread_index + i) % num_threads];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void run_task(SharedState& shared, uint32_t thread_index, const Task& task)
+    {
+        const uint32_t in = task.in;
+        const uint32_t out = !in;
+        KeyType* __restrict keys_in = shared.keys[in] + task.begin;
+        KeyType* __restrict keys_out = shared.keys[out] + task.begin;
+        ValueType* __restrict values_in = shared.values[in] + task.begin;
+        ValueType* __restrict values_out = shared.values[out] + task.begin;
+
+        if (task.size <= kLSDThreshold)
+        {
+            const uint32_t sorted = LSDSort()(keys_in, keys_out, values_in, values_out, task.size);
+            move_to_output(shared, sorted ? out : in, task.begin, task.size);
+            return;
+        }
+
+        uint32_t offsets[kHistSize + 1];
+        const uint32_t bucket = SerialSort::partition(keys_in, keys_out, values_in, values_out, task.size,
+            task.num_buckets - 1, offsets);
+        if (bucket >= task.num_buckets)
+        {
+            // all keys are the same
+            move_to_output(shared, in, task.begin, task.size);
+            return;
+        }
+
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            const Task partition = {task.begin + offsets[i], offsets[i + 1] - offsets[i], bucket, out};
+            push_task(shared, thread_index, partition);
+        }
+    }
+
+    static void worker(SharedState& shared, uint32_t thread_index)
+    {
+        Task task;
+        while (shared.pending.load() != 0)
+        {
+            if (pop_task(shared, thread_index, task))
+            {
+                run_task(shared, thread_index, task);
+                shared.pending.fetch_sub(1);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+    uint32_t operator()(KeyType* __restrict keys_in,
+        KeyType* __restrict keys_temp, ValueType* __restrict values_in,
+        ValueType* __restrict values_temp, uint32_t size, uint32_t num_threads) const
+    {
+        DecodeOp decode_op;
+
+        if (num_threads == 0)
+        {
+            num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        num_threads = std::min(num_threads, size / kMinKeysPerThread);
+        if (num_threads <= 1)
+        {
+            return SerialSort()(keys_in, keys_temp, values_in, values_temp, size);
+        }
+
+        // Count every digit of each chunk on its own thread
+        std::vector<std::array<std::array<uint32_t, kHistSize>, kHistBuckets>> thread_hist(num_threads);
+        parallel_for(num_threads, [&](uint32_t thread_index) {
+            const uint32_t begin = chunk_begin(size, num_threads, thread_index);
+            const uint32_t end = chunk_begin(size, num_threads, thread_index + 1);
+            uint32_t hist[kHistBuckets][kHistSize] = {};
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                const KeyType key = decode_op(keys_in[i]);
+                for (uint32_t bucket = 0; bucket < kHistBuckets; ++bucket)
+                {
+                    const uint32_t shift = bucket * kRadixBits;
+                    const uint32_t pos = (key >> shift) & kHistMask;
+                    ++hist[bucket][pos];
+                }
+            }
+            std::memcpy(thread_hist[thread_index].data(), hist, sizeof(hist));
+        });
+
+        // Find the most significant digit which varies
+        const KeyType first_key = decode_op(keys_in[0]);
+        uint32_t bucket = kHistBuckets;
+        while (bucket-- > 0)
+        {
+            const uint32_t pos = (first_key >> (bucket * kRadixBits)) & kHistMask;
+            uint32_t count = 0;
+            for (uint32_t thread_index = 0; thread_index < num_threads; ++thread_index)
+            {
+                count += thread_hist[thread_index][bucket][pos];
+            }
+            if (count != size)
+            {
+                break;
+            }
+        }
+        if (bucket >= kHistBuckets)
+        {
+            // all keys are the same
+            return 0;
+        }
+
+        // Partition into the temporary buffer, each thread's offsets starting
+        // after the same digit in all earlier chunks so the sort stays stable
+        uint32_t offsets[kHistSize + 1];
+        offsets[0] = 0;
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            uint32_t offset = offsets[i];
+            for (uint32_t thread_index = 0; thread_index < num_threads; ++thread_index)
+            {
+                const uint32_t count = thread_hist[thread_index][bucket][i];
+                thread_hist[thread_index][bucket][i] = offset;
+                offset += count;
+            }
+            offsets[i + 1] = offset;
+        }
+        const uint32_t shift = bucket * kRadixBits;
+        parallel_for(num_threads, [&](uint32_t thread_index) {
+            const uint32_t begin = chunk_begin(size, num_threads, thread_index);
+            const uint32_t end = chunk_begin(size, num_threads, thread_index + 1);
+            uint32_t* __restrict next = thread_hist[thread_index][bucket].data();
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                const KeyType key = keys_in[i];
+                const uint32_t pos = (decode_op(key) >> shift) & kHistMask;
+                const uint32_t index = next[pos]++;
+                keys_temp[index] = key;
+                values_temp[index] = values_in[i];
+            }
+        });
+
+        // Deal the partitions out between the threads and sort them, every
+        // task leaving its result in the input buffer
+        SharedState shared(num_threads);
+        shared.keys[0] = keys_in;
+        shared.keys[1] = keys_temp;
+        shared.values[0] = values_in;
+        shared.values[1] = values_temp;
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            const Task partition = {offsets[i], offsets[i + 1] - offsets[i], bucket, 1};
+            push_task(shared, i % num_threads, partition);
+        }
+        parallel_for(num_threads, [&](uint32_t thread_index) {
+            worker(shared, thread_index);
+        });
+
+        return 0;
+    }
+};
+
+/**
+ * Internal function object for performing in place radix sort. This is an
+ * American flag sort: keys are permuted into partitions on their highest
+ * varying 8 bit digit using only the histogram, then each partition is sorted
+ * recursively, so no temporary key or value buffers are needed. Unlike the
+ * other radix sorts it is not stable.
+ */
+template <typename KeyType, typename ValueType, typename DecodeOp>
+struct RadixSortInPlaceParallel;
+
+template <typename KeyType, typename ValueType, typename DecodeOp = PassThrough>
+struct RadixSortInPlace
+{
+private:
+    friend struct RadixSortInPlaceParallel<KeyType, ValueType, DecodeOp>;
+
+    static const uint32_t kRadixBits = 8;
+    static const uint32_t kHistBuckets = 1 + (((sizeof(KeyType) * 8) - 1) / kRadixBits);
+    static const uint32_t kHistSize = (1 << kRadixBits);
+    static const uint32_t kHistMask = kHistSize - 1;
+
+    /**
+     * Insertion sort keys and values on the decoded key.
+     */
+    static void insertion_sort_in_place(KeyType* __restrict keys, ValueType* __restrict values,
+        uint32_t size)
+    {
+        DecodeOp decode_op;
+        for (uint32_t i = 1; i < size; ++i)
+        {
+            const KeyType key = keys[i];
+            const KeyType decoded_key = decode_op(key);
+            const ValueType value = values[i];
+            uint32_t j = i;
+            for (; j > 0 && decode_op(keys[j - 1]) > decoded_key; --j)
+            {
+                keys[j] = keys[j - 1];
+                values[j] = values[j - 1];
+            }
+            keys[j] = key;
+            values[j] = value;
+        }
+    }
+
+    /**
+     * Sort keys and values in place, only considering digits up to and
+     * including the given bucket.
+     */
+    static void sort(KeyType* __restrict keys, ValueType* __restrict values, uint32_t size,
+        uint32_t max_bucket)
+    {
+        DecodeOp decode_op;
+
+        if (size <= kInsertionSortThreshold)
+        {
+            insertion_sort_in_place(keys, values, size);
+            return;
+        }
+
+        // Count every digit at once so digits where all keys are the same can
+        // be skipped without reading the keys again
+        uint32_t hist[kHistBuckets][kHistSize];
+        std::memset(hist, 0, sizeof(hist[0]) * (max_bucket + 1));
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            const KeyType key = decode_op(keys[i]);
+            for (uint32_t bucket = 0; bucket <= max_bucket; ++bucket)
+            {
+                const uint32_t shift = bucket * kRadixBits;
+                const uint32_t pos = (key >> shift) & kHistMask;
+                ++hist[bucket][pos];
+            }
+        }
+
+        // Find the most significant digit which varies
+        const KeyType first_key = decode_op(keys[0]);
+        uint32_t bucket = max_bucket + 1;
+        while (bucket-- > 0)
+        {
+            if (hist[bucket][(first_key >> (bucket * kRadixBits)) & kHistMask] != size)
+            {
+                break;
+            }
+        }
+        if (bucket > max_bucket)
+        {
+            // all keys are the same
+            return;
+        }
+
+        uint32_t offsets[kHistSize + 1];
+        offsets[0] = 0;
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            offsets[i + 1] = offsets[i] + hist[bucket][i];
+        }
+
+        // Fill each partition in turn, swapping every misplaced key and value
+        // into the next free slot of its own partition until a key belonging
+        // to the partition being filled turns up
+        const uint32_t shift = bucket * kRadixBits;
+        uint32_t* __restrict next = hist[bucket];
+        std::memcpy(next, offsets, sizeof(uint32_t) * kHistSize);
+        for (uint32_t pos = 0; pos < kHistSize; ++pos)
+        {
+            const uint32_t end = offsets[pos + 1];
+            while (next[pos] < end)
+            {
+                KeyType key = keys[next[pos]];
+                ValueType value = values[next[pos]];
+                uint32_t key_pos = (decode_op(key) >> shift) & kHistMask;
+                while (key_pos != pos)
+                {
+                    const uint32_t index = next[key_pos]++;
+                    std::swap(key, keys[index]);
+                    std::swap(value, values[index]);
+                    key_pos = (decode_op(key) >> shift) & kHistMask;
+                }
+                keys[next[pos]] = key;
+                values[next[pos]] = value;
+                ++next[pos];
+            }
+        }
+
+        if (bucket == 0)
+        {
+            return;
+        }
+
+        for (uint32_t pos = 0; pos < kHistSize; ++pos)
+        {
+            const uint32_t begin = offsets[pos];
+            const uint32_t count = offsets[pos + 1] - begin;
+            if (count > 1)
+            {
+                sort(keys + begin, values + begin, count, bucket - 1);
+            }
+        }
+    }
+
+public:
+    void operator()(KeyType* __restrict keys_in_out, ValueType* __restrict values_in_out,
+        uint32_t size) const
+    {
+        sort(keys_in_out, values_in_out, size, kHistBuckets - 1);
+    }
+};
+
+/**
+ * Internal function object for performing in place radix sort on multiple
+ * threads, in the style of PARADIS. Threads count the digits of their own
+ * chunk of the keys to find the partitions for the highest varying digit,
+ * then repeatedly:
+ *  - give each thread an equal stripe of every partition's unplaced keys,
+ *    which it permutes within its own stripes, leaving keys whose partition
+ *    stripe is already full where they are
+ *  - repair each partition by moving the keys which now belong there to its
+ *    head, leaving the rest to be placed in the next round
+ * until few enough keys are left to place them on one thread. Partitions too
+ * large for one thread are sorted the same way, while the rest are shared out
+ * between threads and sorted with RadixSortInPlace. Like RadixSortInPlace it
+ * is not stable.
+ */
+template <typename KeyType, typename ValueType, typename DecodeOp = PassThrough>
+struct RadixSortInPlaceParallel
+{
+private:
+    typedef RadixSortInPlace<KeyType, ValueType, DecodeOp> SerialSort;
+
+    static const uint32_t kRadixBits = SerialSort::kRadixBits;
+    static const uint32_t kHistBuckets = SerialSort::kHistBuckets;
+    static const uint32_t kHistSize = SerialSort::kHistSize;
+    static const uint32_t kHistMask = SerialSort::kHistMask;
+
+    // each thread is given at least this many keys, smaller arrays use fewer
+    // threads, and once fewer keys than this are left to place the
+    // permutation is finished on one thread
+    static const uint32_t kMinKeysPerThread = 1 << 16;
+
+    typedef std::array<uint32_t, kHistSize> Hist;
+
+    static inline uint32_t digit(KeyType key, uint32_t shift)
+    {
+        DecodeOp decode_op;
+        return (decode_op(key) >> shift) & kHistMask;
+    }
+
+    static inline uint32_t stripe_begin(uint32_t begin, uint32_t end, uint32_t num_threads, uint32_t thread_index)
+    {
+        return begin + static_cast<uint32_t>((uint64_t(end - begin) * thread_index) / num_threads);
+    }
+
+    /**
+     * Swap keys into the partitions starting at the given offsets on the
+     * digit at the given shift.
+     */
+    static void permute(KeyType* __restrict keys, ValueType* __restrict values, uint32_t size,
+        const uint32_t (&offsets)[kHistSize + 1], uint32_t shift, uint32_t num_threads)
+    {
+        // Keys before each partition's head are in place, keys between its
+        // head and tail still need placing
+        Hist heads;
+        Hist tails;
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            heads[i] = offsets[i];
+            tails[i] = offsets[i + 1];
+        }
+
+        std::vector<Hist> stripe_next(num_threads);
+        std::vector<Hist> stripe_end(num_threads);
+        uint32_t remaining = size;
+        while (remaining > kMinKeysPerThread)
+        {
+            for (uint32_t thread_index = 0; thread_index < num_threads; ++thread_index)
+            {
+                for (uint32_t i = 0; i < kHistSize; ++i)
+                {
+                    stripe_next[thread_index][i] = stripe_begin(heads[i], tails[i], num_threads, thread_index);
+                    stripe_end[thread_index][i] = stripe_begin(heads[i], tails[i], num_threads, thread_index + 1);
+                }
+            }
+
+            parallel_for(num_threads, [&](uint32_t thread_index) {
+                Hist& next = stripe_next[thread_index];
+                const Hist& end = stripe_end[thread_index];
+                for (uint32_t pos = 0; pos < kHistSize; ++pos)
+                {
+                    while (next[pos] < end[pos])
+                    {
+                        KeyType key = keys[next[pos]];
+                        ValueType value = values[next[pos]];
+                        uint32_t key_pos = digit(key, shift);
+                        while (key_pos != pos && next[key_pos] < end[key_pos])
+                        {
+                            const uint32_t index = next[key_pos]++;
+                            std::swap(key, keys[index]);
+                            std::swap(value, values[index]);
+                            key_pos = digit(key, shift);
+                        }
+                        keys[next[pos]] = key;
+                        values[next[pos]] = value;
+                        ++next[pos];
+                    }
+                }
+            });
+
+            parallel_for(num_threads, [&](uint32_t thread_index) {
+                for (uint32_t pos = thread_index; pos < kHistSize; pos += num_threads)
+                {
+                    uint32_t head = heads[pos];
+                    uint32_t tail = tails[pos];
+                    for (;;)
+                    {
+                        while (head < tail && digit(keys[head], shift) == pos)
+                        {
+                            ++head;
+                        }
+                        while (head < tail && digit(keys[tail - 1], shift) != pos)
+                        {
+                            --tail;
+                        }
+                        if (head >= tail)
+                        {
+                            break;
+                        }
+                        std::swap(keys[head], keys[tail - 1]);
+                        std::swap(values[head], values[tail - 1]);
+                        ++head;
+                        --tail;
+                    }
+                    heads[pos] = head;
+                }
+            });
+
+            uint32_t unplaced = 0;
+            for (uint32_t i = 0; i < kHistSize; ++i)
+            {
+                unplaced += tails[i] - heads[i];
+            }
+            if (unplaced == remaining)
+            {
+                break;
+            }
+            remaining = unplaced;
+        }
+
+        // Place the remaining keys on this thread
+        for (uint32_t pos = 0; pos < kHistSize; ++pos)
+        {
+            while (heads[pos] < tails[pos])
+            {
+                KeyType key = keys[heads[pos]];
+                ValueType value = values[heads[pos]];
+                uint32_t key_pos = digit(key, shift);
+                while (key_pos != pos)
+                {
+                    const uint32_t index = heads[key_pos]++;
+                    std::swap(key, keys[index]);
+                    std::swap(value, values[index]);
+                    key_pos = digit(key, shift);
+                }
+                keys[heads[pos]] = key;
+                values[heads[pos]] = value;
+                ++heads[pos];
+            }
+        }
+    }
+
+    /**
+     * Sort keys and values in place, only considering digits up to and
+     * including the given bucket.
+     */
+    static void sort(KeyType* __restrict keys, ValueType* __restrict values, uint32_t size,
+        uint32_t max_bucket, uint32_t num_threads)
+    {
+        DecodeOp decode_op;
+
+        num_threads = std::min(num_threads, size / kMinKeysPerThread);
+        if (num_threads <= 1)
+        {
+            SerialSort::sort(keys, values, size, max_bucket);
+            return;
+        }
+
+        // Count every digit of each chunk on its own thread
+        std::vector<std::array<Hist, kHistBuckets>> thread_hist(num_threads);
+        parallel_for(num_threads, [&](uint32_t thread_index) {
+            const uint32_t begin = stripe_begin(0, size, num_threads, thread_index);
+            const uint32_t end = stripe_begin(0, size, num_threads, thread_index + 1);
+            uint32_t hist[kHistBuckets][kHistSize];
+            std::memset(hist, 0, sizeof(hist[0]) * (max_bucket + 1));
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                const KeyType key = decode_op(keys[i]);
+                for (uint32_t bucket = 0; bucket <= max_bucket; ++bucket)
+                {
+                    const uint32_t shift = bucket * kRadixBits;
+                    const uint32_t pos = (key >> shift) & kHistMask;
+                    ++hist[bucket][pos];
+                }
+            }
+            std::memcpy(thread_hist[thread_index].data(), hist, sizeof(hist[0]) * (max_bucket + 1));
+        });
+
+        // Find the most significant digit which varies
+        const KeyType first_key = decode_op(keys[0]);
+        uint32_t bucket = max_bucket + 1;
+        while (bucket-- > 0)
+        {
+            const uint32_t pos = (first_key >> (bucket * kRadixBits)) & kHistMask;
+            uint32_t count = 0;
+            for (uint32_t thread_index = 0; thread_index < num_threads; ++thread_index)
+            {
+                count += thread_hist[thread_index][bucket][pos];
+            }
+            if (count != size)
+            {
+                break;
+            }
+        }
+        if (bucket > max_bucket)
+        {
+            // all keys are the same
+            return;
+        }
+
+        uint32_t offsets[kHistSize + 1];
+        offsets[0] = 0;
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            uint32_t count = 0;
+            for (uint32_t thread_index = 0; thread_index < num_threads; ++thread_index)
+            {
+                count += thread_hist[thread_index][bucket][i];
+            }
+            offsets[i + 1] = offsets[i] + count;
+        }
+
+        permute(keys, values, size, offsets, bucket * kRadixBits, num_threads);
+
+        if (bucket == 0)
+        {
+            return;
+        }
+
+        // Partitions too large for one thread are sorted by every thread in
+        // turn, the rest are shared out between threads largest first
+        std::vector<uint32_t> partitions;
+        for (uint32_t i = 0; i < kHistSize; ++i)
+        {
+            const uint32_t count = offsets[i + 1] - offsets[i];
+            if (count > size / num_threads)
+            {
+                sort(keys + offsets[i], values + offsets[i], count, bucket - 1, num_threads);
+            }
+            else if (count > 1)
+            {
+                partitions.push_back(i);
+            }
+        }
+        std::sort(partitions.begin(), partitions.end(), [&offsets](uint32_t a, uint32_t b) {
+            return offsets[a + 1] - offsets[a] > offsets[b + 1] - offsets[b];
+        });
+
+        std::atomic<uint32_t> next_partition(0);
+        parallel_for(num_threads, [&](uint32_t) {
+            for (uint32_t i = next_partition++; i < partitions.size(); i = next_partition++)
+            {
+                const uint32_t begin = offsets[partitions[i]];
+                const uint32_t count = offsets[partitions[i] + 1] - begin;
+                SerialSort::sort(keys + begin, values + begin, count, bucket - 1);
+            }
+        });
+    }
+
+public:
+    void operator()(KeyType* __restrict keys_in_out, ValueType* __restrict values_in_out,
+        uint32_t size, uint32_t num_threads) const
+    {
+        if (num_threads == 0)
+        {
+            num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        sort(keys_in_out, values_in_out, size, kHistBuckets - 1, num_threads);
+    }
+};
+
+/**
+ * Counting sort 8 or 16 bit keys, in one pass of a digit covering the whole
+ * key. 16 bit keys take two passes of 8 bit digits below kMinSize16 keys, as
+ * clearing and summing the 65536 entry histogram costs more than the second
+ * pass, and above it allocate their histogram.
+ */
+template <typename KeyType, typename ValueType, typename DecodeOp = PassThrough, typename EncodeOp = DecodeOp>
+struct CountingSort
+{
+private:
+    static_assert(sizeof(KeyType) <= 2, "counting sort is for 8 and 16 bit keys");
+
+    static const uint32_t kMinSize16 = 1 << 16;
+    static const uint32_t kKeyBits = sizeof(KeyType) * 8;
+
+    typedef DigitPlan<kKeyBits> LargePlan;
+    typedef typename std::conditional<kKeyBits == 16, DigitPlan<8, 8>, LargePlan>::type SmallPlan;
+
+    ScatterMode scatter_mode_;
+
+public:
+    explicit CountingSort(ScatterMode scatter_mode = kScatterAuto)
+        : scatter_mode_(scatter_mode)
+    {
+    }
+
+    uint32_t operator()(KeyType* __restrict keys_in, KeyType* __restrict keys_temp,
+        ValueType* __restrict values_in, ValueType* __restrict values_temp, uint32_t size) const
+    {
+        if (size < kMinSize16)
+        {
+            RadixSortPlan<SmallPlan, KeyType, ValueType, DecodeOp, EncodeOp> sort(scatter_mode_);
+            return sort(keys_in, keys_temp, values_in, values_temp, size);
+        }
+        RadixSortPlan<LargePlan, KeyType, ValueType, DecodeOp, EncodeOp> sort(scatter_mode_);
+        return sort(keys_in, keys_temp, values_in, values_temp, size);
+    }
+};
+
+/**
+ * Copy a value of a column of Word sized values.
+ */
+template <typename Word>
+struct CopyWord
+{
+    inline void operator()(void* __restrict out, uint32_t out_index, const void* __restrict in,
+        uint32_t in_index) const
+    {
+        static_cast<Word*>(out)[out_index] = static_cast<const Word*>(in)[in_index];
+    }
+};
+
+/**
+ * Copy a value of a column of values of any size.
+ */
+struct CopyBytes
+{
+    size_t value_size;
+
+    inline void operator()(void* __restrict out, uint32_t out_index, const void* __restrict in,
+        uint32_t in_index) const
+    {
+        std::memcpy(static_cast<uint8_t*>(out) + out_index * value_size,
+            static_cast<const uint8_t*>(in) + in_index * value_size, value_size);
+    }
+};
+
+/**
+ * Internal function object for reordering columns of values by a
+ * permutation. A direct gather of a column too large for the cache misses on
+ * almost every value, so these columns are gathered through a partition of
+ * the permutation by the block of the input each index reads, made once for
+ * all columns. The values of each block are gathered while the block is in
+ * cache into a staging buffer in partition order, then each thread
+ * interleaves the partitions back into output order, reading the next value
+ * of each partition in turn. Both steps only read and write in order, apart
+ * from within the cached block.
+ */
+struct ApplyPermutation
+{
+private:
+    static const uint32_t kMinKeysPerThread = 1 << 16;
+
+    // columns smaller than this mostly stay in the last level cache, and are
+    // gathered directly
+    static const uint64_t kMinPartitionBytes = 1 << 25;
+
+    // each partition reads a block of the input of about this size, which
+    // stays in the L2 cache
+    static const uint32_t kBlockBytes = 1 << 20;
+
+    // the interleave keeps a cache line of each partition in use
+    static const uint32_t kMaxPartitions = 4096;
+
+    const uint32_t* __restrict indices_;
+    uint32_t size_;
+    uint32_t num_threads_;
+    uint32_t shift_;
+    uint32_t num_partitions_;
+    // indices in partition order, and the offset of each thread's indices in
+    // each partition
+    std::vector<uint32_t> sources_;
+    std::vector<uint32_t> offsets_;
+    std::vector<uint64_t> staging_;
+
+    static inline uint32_t chunk_begin(uint32_t size, uint32_t num_threads, uint32_t thread_index)
+    {
+        return static_cast<uint32_t>((uint64_t(size) * thread_index) / num_threads);
+    }
+
+    /**
+     * Partition the indices by the block of the input they read, keeping
+     * their order within each partition.
+     */
+    void partition(size_t max_value_size)
+    {
+        shift_ = 0;
+        while ((uint64_t(2) << shift_) * max_value_size <= kBlockBytes)
+        {
+            ++shift_;
+        }
+        while (((size_ - 1) >> shift_) + 1 > kMaxPartitions)
+        {
+            ++shift_;
+        }
+        num_partitions_ = ((size_ - 1) >> shift_) + 1;
+
+        offsets_.assign(size_t(num_threads_) * num_partitions_, 0);
+        parallel_for(num_threads_, [this](uint32_t thread_index) {
+            uint32_t* __restrict counts = offsets_.data() + size_t(thread_index) * num_partitions_;
+            const uint32_t end = chunk_begin(size_, num_threads_, thread_index + 1);
+            for (uint32_t i = chunk_begin(size_, num_threads_, thread_index); i < end; ++i)
+            {
+                ++counts[indices_[i] >> shift_];
+            }
+        });
+
+        // each thread's indices follow those of earlier threads in each
+        // partition, so partitions keep the order of the output
+        uint32_t offset = 0;
+        for (uint32_t partition = 0; partition < num_partitions_; ++partition)
+        {
+            for (uint32_t thread_index = 0; thread_index < num_threads_; ++thread_index)
+            {
+                uint32_t& entry = offsets_[size_t(thread_index) * num_partitions_ + partition];
+                const uint32_t count = entry;
+                entry = offset;
+                offset += count;
+            }
+        }
+
+        sources_.resize(size_);
+        parallel_for(num_threads_, [this](uint32_t thread_index) {
+            uint32_t cursors[kMaxPartitions];
+            std::memcpy(cursors, offsets_.data() + size_t(thread_index) * num_partitions_,
+                sizeof(uint32_t) * num_partitions_);
+            const uint32_t end = chunk_begin(size_, num_threads_, thread_index + 1);
+            for (uint32_t i = chunk_begin(size_, num_threads_, thread_index); i < end; ++i)
+            {
+                const uint32_t index = indices_[i];
+                sources_[cursors[index >> shift_]++] = index;
+            }
+        });
+    }
+
+    template <typename CopyOp>
+    void gather(const void* __restrict values_in, void* __restrict values_out, CopyOp copy_op) const
+    {
+        parallel_for(num_threads_, [&](uint32_t thread_index) {
+            const uint32_t end = chunk_begin(size_, num_threads_, thread_index + 1);
+            for (uint32_t i = chunk_begin(size_, num_threads_, thread_index); i < end; ++i)
+            {
+                copy_op(values_out, i, values_in, indices_[i]);
+            }
+        });
+    }
+
+    template <typename CopyOp>
+    void gather_partitioned(const void* __restrict values_in, void* __restrict values_out, CopyOp copy_op)
+    {
+        void* __restrict staging = staging_.data();
+        parallel_for(num_threads_, [&](uint32_t thread_index) {
+            const uint32_t end = chunk_begin(size_, num_threads_, thread_index + 1);
+            for (uint32_t i = chunk_begin(size_, num_threads_, thread_index); i < end; ++i)
+            {
+                copy_op(staging, i, values_in, sources_[i]);
+            }
+        });
+
+        parallel_for(num_threads_, [&](uint32_t thread_index) {
+            uint32_t cursors[kMaxPartitions];
+            std::memcpy(cursors, offsets_.data() + size_t(thread_index) * num_partitions_,
+                sizeof(uint32_t) * num_partitions_);
+            const uint32_t end = chunk_begin(size_, num_threads_, thread_index + 1);
+            for (uint32_t i = chunk_begin(size_, num_threads_, thread_index); i < end; ++i)
+            {
+                copy_op(values_out, i, staging, cursors[indices_[i] >> shift_]++);
+            }
+        });
+    }
+
+    template <typename CopyOp>
+    void apply(const PermutationColumn& column, CopyOp copy_op)
+    {
+        if (uint64_t(size_) * column.value_size >= kMinPartitionBytes)
+        {
+            gather_partitioned(column.values_in, column.values_out, copy_op);
+        }
+        else
+        {
+            gather(column.values_in, column.values_out, copy_op);
+        }
+    }
+
+public:
+    ApplyPermutation(const uint32_t* __restrict indices, uint32_t size, uint32_t num_threads)
+        : indices_(indices)
+        , size_(size)
+        , num_threads_(num_threads)
+        , shift_(0)
+        , num_partitions_(0)
+    {
+        if (num_threads_ == 0)
+        {
+            num_threads_ = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        num_threads_ = std::max(std::min(num_threads_, size / kMinKeysPerThread), 1u);
+    }
+
+    void operator()(const PermutationColumn* columns, uint32_t num_columns)
+    {
+        size_t max_value_size = 0;
+        for (uint32_t column = 0; column < num_columns; ++column)
+        {
+            if (uint64_t(size_) * columns[column].value_size >= kMinPartitionBytes)
+            {
+                max_value_size = std::max(max_value_size, columns[column].value_size);
+            }
+        }
+        if (max_value_size != 0)
+        {
+            partition(max_value_size);
+            staging_.resize((uint64_t(size_) * max_value_size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        }
+
+        for (uint32_t column = 0; column < num_columns; ++column)
+        {
+            switch (columns[column].value_size)
+            {
+            case sizeof(uint8_t):
+                apply(columns[column], CopyWord<uint8_t>());
+                break;
+            case sizeof(uint16_t):
+                apply(columns[column], CopyWord<uint16_t>());
+                break;
+            case sizeof(uint32_t):
+                apply(columns[column], CopyWord<uint32_t>());
+                break;
+            case sizeof(uint64_t):
+                apply(columns[column], CopyWord<uint64_t>());
+                break;
+            default:
+                apply(columns[column], CopyBytes{columns[column].value_size});
+                break;
+            }
+        }
+    }
+};
+
+} // namespace detail
+
+
+template <typename ValueType>
+inline uint32_t radix8sort(uint32_t* __restrict keys_in_out,
+    uint32_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* values_temp,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<8, uint32_t, ValueType> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort(uint64_t* __restrict keys_in_out,
+    uint64_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* values_temp,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<8, uint64_t, ValueType> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort(uint32_t* __restrict keys_in,
+    uint32_t* __restrict keys_out, ValueType* __restrict values_in,
+    ValueType* __restrict values_out, uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<11, uint32_t, ValueType> sort(scatter_mode);
+    return sort(keys_in, keys_out, values_in, values_out, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort(uint64_t* __restrict keys_in,
+    uint64_t* __restrict keys_out, ValueType* __restrict values_in,
+    ValueType* __restrict values_out, uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<11, uint64_t, ValueType> sort(scatter_mode);
+    return sort(keys_in, keys_out, values_in, values_out, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort(float* __restrict keys_in_out_f32,
+    float* __restrict keys_temp_f32, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    // create uint32_t pointers to inputs to avoid float to int casting
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_f32);
+
+    detail::RadixSort<8, uint32_t, ValueType, detail::FloatFlip, detail::InvFloatFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort(float* __restrict keys_in_f32,
+    float* __restrict keys_out_f32, ValueType* __restrict values_in,
+    ValueType* __restrict values_out, uint32_t size, ScatterMode scatter_mode)
+{
+    // create uint32_t pointers to inputs to avoid float to int casting
+    uint32_t* __restrict keys_in = reinterpret_cast<uint32_t*>(keys_in_f32);
+    uint32_t* __restrict keys_out = reinterpret_cast<uint32_t*>(keys_out_f32);
+
+    detail::RadixSort<11, uint32_t, ValueType, detail::FloatFlip, detail::InvFloatFlip> sort(scatter_mode);
+    return sort(keys_in, keys_out, values_in, values_out, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort(double* __restrict keys_in_out_f64,
+    double* __restrict keys_temp_f64, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    // create uint64_t pointers to inputs to avoid double to int casting
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_f64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_f64);
+
+    detail::RadixSort<8, uint64_t, ValueType, detail::DoubleFlip, detail::InvDoubleFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort(double* __restrict keys_in_f64,
+    double* __restrict keys_out_f64, ValueType* __restrict values_in,
+    ValueType* __restrict values_out, uint32_t size, ScatterMode scatter_mode)
+{
+    // create uint64_t pointers to inputs to avoid double to int casting
+    uint64_t* __restrict keys_in = reinterpret_cast<uint64_t*>(keys_in_f64);
+    uint64_t* __restrict keys_out = reinterpret_cast<uint64_t*>(keys_out_f64);
+
+    detail::RadixSort<11, uint64_t, ValueType, detail::DoubleFlip, detail::InvDoubleFlip> sort(scatter_mode);
+    return sort(keys_in, keys_out, values_in, values_out, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort(int32_t* __restrict keys_in_out_i32,
+    int32_t* __restrict keys_temp_i32, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_i32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_i32);
+
+    detail::RadixSort<8, uint32_t, ValueType, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort(int64_t* __restrict keys_in_out_i64,
+    int64_t* __restrict keys_temp_i64, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_i64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_i64);
+
+    detail::RadixSort<8, uint64_t, ValueType, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort(int32_t* __restrict keys_in_out_i32,
+    int32_t* __restrict keys_temp_i32, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_i32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_i32);
+
+    detail::RadixSort<11, uint32_t, ValueType, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort(int64_t* __restrict keys_in_out_i64,
+    int64_t* __restrict keys_temp_i64, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_i64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_i64);
+
+    detail::RadixSort<11, uint64_t, ValueType, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+inline uint32_t radix8sort(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<8, uint32_t, detail::NoValue, detail::PassThrough, detail::PassThrough> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix8sort(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<8, uint64_t, detail::NoValue, detail::PassThrough, detail::PassThrough> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix8sort(float* __restrict keys_in_out_f32, float* __restrict keys_temp_f32,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_f32);
+
+    detail::RadixSort<8, uint32_t, detail::NoValue, detail::FloatFlip, detail::InvFloatFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix8sort(double* __restrict keys_in_out_f64, double* __restrict keys_temp_f64,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_f64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_f64);
+
+    detail::RadixSort<8, uint64_t, detail::NoValue, detail::DoubleFlip, detail::InvDoubleFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix8sort(int32_t* __restrict keys_in_out_i32, int32_t* __restrict keys_temp_i32,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_i32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_i32);
+
+    detail::RadixSort<8, uint32_t, detail::NoValue, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix8sort(int64_t* __restrict keys_in_out_i64, int64_t* __restrict keys_temp_i64,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_i64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_i64);
+
+    detail::RadixSort<8, uint64_t, detail::NoValue, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix11sort(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<11, uint32_t, detail::NoValue, detail::PassThrough, detail::PassThrough> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix11sort(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<11, uint64_t, detail::NoValue, detail::PassThrough, detail::PassThrough> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix11sort(float* __restrict keys_in_out_f32, float* __restrict keys_temp_f32,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_f32);
+
+    detail::RadixSort<11, uint32_t, detail::NoValue, detail::FloatFlip, detail::InvFloatFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix11sort(double* __restrict keys_in_out_f64, double* __restrict keys_temp_f64,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_f64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_f64);
+
+    detail::RadixSort<11, uint64_t, detail::NoValue, detail::DoubleFlip, detail::InvDoubleFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix11sort(int32_t* __restrict keys_in_out_i32, int32_t* __restrict keys_temp_i32,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_i32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_i32);
+
+    detail::RadixSort<11, uint32_t, detail::NoValue, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix11sort(int64_t* __restrict keys_in_out_i64, int64_t* __restrict keys_temp_i64,
+    uint32_t size, ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_i64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_i64);
+
+    detail::RadixSort<11, uint64_t, detail::NoValue, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, nullptr, nullptr, size);
+}
+
+
+inline uint32_t radix8argsort(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    detail::RadixSort<8, uint32_t, uint32_t, detail::PassThrough, detail::PassThrough> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+inline uint32_t radix8argsort(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    detail::RadixSort<8, uint64_t, uint32_t, detail::PassThrough, detail::PassThrough> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+inline uint32_t radix8argsort(float* __restrict keys_in_out_f32, float* __restrict keys_temp_f32,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_f32);
+
+    detail::RadixSort<8, uint32_t, uint32_t, detail::FloatFlip, detail::InvFloatFlip> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+inline uint32_t radix8argsort(double* __restrict keys_in_out_f64, double* __restrict keys_temp_f64,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_f64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_f64);
+
+    detail::RadixSort<8, uint64_t, uint32_t, detail::DoubleFlip, detail::InvDoubleFlip> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+inline uint32_t radix8argsort(int32_t* __restrict keys_in_out_i32, int32_t* __restrict keys_temp_i32,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_i32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_i32);
+
+    detail::RadixSort<8, uint32_t, uint32_t, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+inline uint32_t radix8argsort(int64_t* __restrict keys_in_out_i64, int64_t* __restrict keys_temp_i64,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_i64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_i64);
+
+    detail::RadixSort<8, uint64_t, uint32_t, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+inline uint32_t radix11argsort(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    detail::RadixSort<11, uint32_t, uint32_t, detail::PassThrough, detail::PassThrough> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+inline uint32_t radix11argsort(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    detail::RadixSort<11, uint64_t, uint32_t, detail::PassThrough, detail::PassThrough> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+inline uint32_t radix11argsort(float* __restrict keys_in_out_f32, float* __restrict keys_temp_f32,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_f32);
+
+    detail::RadixSort<11, uint32_t, uint32_t, detail::FloatFlip, detail::InvFloatFlip> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+inline uint32_t radix11argsort(double* __restrict keys_in_out_f64, double* __restrict keys_temp_f64,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_f64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_f64);
+
+    detail::RadixSort<11, uint64_t, uint32_t, detail::DoubleFlip, detail::InvDoubleFlip> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+inline uint32_t radix11argsort(int32_t* __restrict keys_in_out_i32, int32_t* __restrict keys_temp_i32,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_i32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_i32);
+
+    detail::RadixSort<11, uint32_t, uint32_t, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+inline uint32_t radix11argsort(int64_t* __restrict keys_in_out_i64, int64_t* __restrict keys_temp_i64,
+    uint32_t* __restrict indices_out, uint32_t* __restrict indices_temp, uint32_t size, bool sort_keys,
+    ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_i64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_i64);
+
+    detail::RadixSort<11, uint64_t, uint32_t, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort.argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_desc(uint32_t* __restrict keys_in_out,
+    uint32_t* __restrict keys_temp, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<8, uint32_t, ValueType, detail::DescendingDecode<detail::PassThrough>,
+        detail::DescendingEncode<detail::PassThrough>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_desc(uint64_t* __restrict keys_in_out,
+    uint64_t* __restrict keys_temp, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<8, uint64_t, ValueType, detail::DescendingDecode<detail::PassThrough>,
+        detail::DescendingEncode<detail::PassThrough>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_desc(float* __restrict keys_in_out_f32,
+    float* __restrict keys_temp_f32, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_f32);
+
+    detail::RadixSort<8, uint32_t, ValueType, detail::DescendingDecode<detail::FloatFlip>,
+        detail::DescendingEncode<detail::InvFloatFlip>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_desc(double* __restrict keys_in_out_f64,
+    double* __restrict keys_temp_f64, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_f64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_f64);
+
+    detail::RadixSort<8, uint64_t, ValueType, detail::DescendingDecode<detail::DoubleFlip>,
+        detail::DescendingEncode<detail::InvDoubleFlip>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_desc(int32_t* __restrict keys_in_out_i32,
+    int32_t* __restrict keys_temp_i32, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_i32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_i32);
+
+    detail::RadixSort<8, uint32_t, ValueType, detail::DescendingDecode<detail::SignFlip>,
+        detail::DescendingEncode<detail::SignFlip>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_desc(int64_t* __restrict keys_in_out_i64,
+    int64_t* __restrict keys_temp_i64, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_i64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_i64);
+
+    detail::RadixSort<8, uint64_t, ValueType, detail::DescendingDecode<detail::SignFlip>,
+        detail::DescendingEncode<detail::SignFlip>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_desc(uint32_t* __restrict keys_in_out,
+    uint32_t* __restrict keys_temp, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<11, uint32_t, ValueType, detail::DescendingDecode<detail::PassThrough>,
+        detail::DescendingEncode<detail::PassThrough>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_desc(uint64_t* __restrict keys_in_out,
+    uint64_t* __restrict keys_temp, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    detail::RadixSort<11, uint64_t, ValueType, detail::DescendingDecode<detail::PassThrough>,
+        detail::DescendingEncode<detail::PassThrough>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_desc(float* __restrict keys_in_out_f32,
+    float* __restrict keys_temp_f32, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_f32);
+
+    detail::RadixSort<11, uint32_t, ValueType, detail::DescendingDecode<detail::FloatFlip>,
+        detail::DescendingEncode<detail::InvFloatFlip>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_desc(double* __restrict keys_in_out_f64,
+    double* __restrict keys_temp_f64, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_f64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_f64);
+
+    detail::RadixSort<11, uint64_t, ValueType, detail::DescendingDecode<detail::DoubleFlip>,
+        detail::DescendingEncode<detail::InvDoubleFlip>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_desc(int32_t* __restrict keys_in_out_i32,
+    int32_t* __restrict keys_temp_i32, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_i32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_i32);
+
+    detail::RadixSort<11, uint32_t, ValueType, detail::DescendingDecode<detail::SignFlip>,
+        detail::DescendingEncode<detail::SignFlip>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_desc(int64_t* __restrict keys_in_out_i64,
+    int64_t* __restrict keys_temp_i64, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_i64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_i64);
+
+    detail::RadixSort<11, uint64_t, ValueType, detail::DescendingDecode<detail::SignFlip>,
+        detail::DescendingEncode<detail::SignFlip>> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_size64(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<8, detail::PassThrough, detail::PassThrough>(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        scatter_mode);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_size64(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<8, detail::PassThrough, detail::PassThrough>(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        scatter_mode);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_size64(float* __restrict keys_in_out, float* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<8, detail::FloatFlip, detail::InvFloatFlip>(reinterpret_cast<uint32_t*>(keys_in_out),
+        reinterpret_cast<uint32_t*>(keys_temp), values_in_out, values_temp, size, scatter_mode);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_size64(double* __restrict keys_in_out, double* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<8, detail::DoubleFlip, detail::InvDoubleFlip>(reinterpret_cast<uint64_t*>(keys_in_out),
+        reinterpret_cast<uint64_t*>(keys_temp), values_in_out, values_temp, size, scatter_mode);
+}
 
 
 template <typename ValueType>
-inline uint32_t radix11sort(uint64_t* __restrict keys_in,
-    uint64_t* __restrict keys_out, ValueType* __restrict values_in,
-    ValueType* __restrict values_out, uint32_t size)
+inline uint32_t radix8sort_size64(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
 {
-    detail::RadixSort<11, uint64_t, ValueType> sort;
-    return sort(keys_in, keys_out, values_in, values_out, size);
+    return detail::radix_sort_size64<8, detail::SignFlip, detail::SignFlip>(reinterpret_cast<uint32_t*>(keys_in_out),
+        reinterpret_cast<uint32_t*>(keys_temp), values_in_out, values_temp, size, scatter_mode);
 }
 
 
 template <typename ValueType>
-inline uint32_t radix8sort(float* __restrict keys_in_out_f32,
+inline uint32_t radix8sort_size64(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<8, detail::SignFlip, detail::SignFlip>(reinterpret_cast<uint64_t*>(keys_in_out),
+        reinterpret_cast<uint64_t*>(keys_temp), values_in_out, values_temp, size, scatter_mode);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_size64(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::PassThrough, detail::PassThrough>(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        scatter_mode);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_size64(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::PassThrough, detail::PassThrough>(keys_in_out, keys_temp, values_in_out, values_temp, size,
+        scatter_mode);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_size64(float* __restrict keys_in_out, float* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::FloatFlip, detail::InvFloatFlip>(reinterpret_cast<uint32_t*>(keys_in_out),
+        reinterpret_cast<uint32_t*>(keys_temp), values_in_out, values_temp, size, scatter_mode);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_size64(double* __restrict keys_in_out, double* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::DoubleFlip, detail::InvDoubleFlip>(reinterpret_cast<uint64_t*>(keys_in_out),
+        reinterpret_cast<uint64_t*>(keys_temp), values_in_out, values_temp, size, scatter_mode);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_size64(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::SignFlip, detail::SignFlip>(reinterpret_cast<uint32_t*>(keys_in_out),
+        reinterpret_cast<uint32_t*>(keys_temp), values_in_out, values_temp, size, scatter_mode);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_size64(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, size_t size, ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::SignFlip, detail::SignFlip>(reinterpret_cast<uint64_t*>(keys_in_out),
+        reinterpret_cast<uint64_t*>(keys_temp), values_in_out, values_temp, size, scatter_mode);
+}
+
+
+inline uint32_t radix8sort_size64(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<8, detail::PassThrough, detail::PassThrough>(keys_in_out, keys_temp,
+        static_cast<detail::NoValue*>(nullptr), static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+inline uint32_t radix8sort_size64(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<8, detail::PassThrough, detail::PassThrough>(keys_in_out, keys_temp,
+        static_cast<detail::NoValue*>(nullptr), static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+inline uint32_t radix8sort_size64(float* __restrict keys_in_out, float* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<8, detail::FloatFlip, detail::InvFloatFlip>(reinterpret_cast<uint32_t*>(keys_in_out),
+        reinterpret_cast<uint32_t*>(keys_temp), static_cast<detail::NoValue*>(nullptr),
+        static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+inline uint32_t radix8sort_size64(double* __restrict keys_in_out, double* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<8, detail::DoubleFlip, detail::InvDoubleFlip>(reinterpret_cast<uint64_t*>(keys_in_out),
+        reinterpret_cast<uint64_t*>(keys_temp), static_cast<detail::NoValue*>(nullptr),
+        static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+inline uint32_t radix8sort_size64(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<8, detail::SignFlip, detail::SignFlip>(reinterpret_cast<uint32_t*>(keys_in_out),
+        reinterpret_cast<uint32_t*>(keys_temp), static_cast<detail::NoValue*>(nullptr),
+        static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+inline uint32_t radix8sort_size64(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<8, detail::SignFlip, detail::SignFlip>(reinterpret_cast<uint64_t*>(keys_in_out),
+        reinterpret_cast<uint64_t*>(keys_temp), static_cast<detail::NoValue*>(nullptr),
+        static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+inline uint32_t radix11sort_size64(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::PassThrough, detail::PassThrough>(keys_in_out, keys_temp,
+        static_cast<detail::NoValue*>(nullptr), static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+inline uint32_t radix11sort_size64(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::PassThrough, detail::PassThrough>(keys_in_out, keys_temp,
+        static_cast<detail::NoValue*>(nullptr), static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+inline uint32_t radix11sort_size64(float* __restrict keys_in_out, float* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::FloatFlip, detail::InvFloatFlip>(reinterpret_cast<uint32_t*>(keys_in_out),
+        reinterpret_cast<uint32_t*>(keys_temp), static_cast<detail::NoValue*>(nullptr),
+        static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+inline uint32_t radix11sort_size64(double* __restrict keys_in_out, double* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::DoubleFlip, detail::InvDoubleFlip>(reinterpret_cast<uint64_t*>(keys_in_out),
+        reinterpret_cast<uint64_t*>(keys_temp), static_cast<detail::NoValue*>(nullptr),
+        static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+inline uint32_t radix11sort_size64(int32_t* __restrict keys_in_out, int32_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::SignFlip, detail::SignFlip>(reinterpret_cast<uint32_t*>(keys_in_out),
+        reinterpret_cast<uint32_t*>(keys_temp), static_cast<detail::NoValue*>(nullptr),
+        static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+inline uint32_t radix11sort_size64(int64_t* __restrict keys_in_out, int64_t* __restrict keys_temp, size_t size,
+    ScatterMode scatter_mode)
+{
+    return detail::radix_sort_size64<11, detail::SignFlip, detail::SignFlip>(reinterpret_cast<uint64_t*>(keys_in_out),
+        reinterpret_cast<uint64_t*>(keys_temp), static_cast<detail::NoValue*>(nullptr),
+        static_cast<detail::NoValue*>(nullptr), size, scatter_mode);
+}
+
+
+template <typename DigitPlan, typename ValueType>
+inline uint32_t radix_sort(uint32_t* __restrict keys_in_out, uint32_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    detail::RadixSortPlan<DigitPlan, uint32_t, ValueType> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename DigitPlan, typename ValueType>
+inline uint32_t radix_sort(uint64_t* __restrict keys_in_out, uint64_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    detail::RadixSortPlan<DigitPlan, uint64_t, ValueType> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename DigitPlan, typename ValueType>
+inline uint32_t radix_sort(float* __restrict keys_in_out_f32, float* __restrict keys_temp_f32,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    // create uint32_t pointers to inputs to avoid float to int casting
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_f32);
+
+    detail::RadixSortPlan<DigitPlan, uint32_t, ValueType, detail::FloatFlip, detail::InvFloatFlip> sort(
+        scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename DigitPlan, typename ValueType>
+inline uint32_t radix_sort(double* __restrict keys_in_out_f64, double* __restrict keys_temp_f64,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    // create uint64_t pointers to inputs to avoid double to int casting
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_f64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_f64);
+
+    detail::RadixSortPlan<DigitPlan, uint64_t, ValueType, detail::DoubleFlip, detail::InvDoubleFlip> sort(
+        scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename DigitPlan, typename ValueType>
+inline uint32_t radix_sort(int32_t* __restrict keys_in_out_i32, int32_t* __restrict keys_temp_i32,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_i32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_i32);
+
+    detail::RadixSortPlan<DigitPlan, uint32_t, ValueType, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename DigitPlan, typename ValueType>
+inline uint32_t radix_sort(int64_t* __restrict keys_in_out_i64, int64_t* __restrict keys_temp_i64,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    uint64_t* __restrict keys_in_out = reinterpret_cast<uint64_t*>(keys_in_out_i64);
+    uint64_t* __restrict keys_temp = reinterpret_cast<uint64_t*>(keys_temp_i64);
+
+    detail::RadixSortPlan<DigitPlan, uint64_t, ValueType, detail::SignFlip, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename RecordType, typename Projection>
+inline uint32_t radix_sort(RecordType* __restrict records_in_out, RecordType* __restrict records_temp,
+    uint32_t size, Projection projection)
+{
+    detail::RadixSortRecords<11, RecordType, Projection> sort(projection);
+    return sort(records_in_out, records_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_parallel(uint32_t* __restrict keys_in_out,
+    uint32_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* __restrict values_temp,
+    uint32_t size, uint32_t num_threads, ScatterMode scatter_mode)
+{
+    detail::RadixSortParallel<8, uint32_t, ValueType> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_parallel(uint64_t* __restrict keys_in_out,
+    uint64_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* __restrict values_temp,
+    uint32_t size, uint32_t num_threads, ScatterMode scatter_mode)
+{
+    detail::RadixSortParallel<8, uint64_t, ValueType> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix8sort_parallel(float* __restrict keys_in_out_f32,
+    float* __restrict keys_temp_f32, ValueType* __restrict values_in_out,
+    ValueType* __restrict values_temp, uint32_t size, uint32_t num_threads, ScatterMode scatter_mode)
+{
+    // create uint32_t pointers to inputs to avoid float to int casting
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
+    uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_f32);
+
+    detail::RadixSortParallel<8, uint32_t, ValueType, detail::FloatFlip, detail::InvFloatFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_parallel(uint32_t* __restrict keys_in_out,
+    uint32_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* __restrict values_temp,
+    uint32_t size, uint32_t num_threads, ScatterMode scatter_mode)
+{
+    detail::RadixSortParallel<11, uint32_t, ValueType> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_parallel(uint64_t* __restrict keys_in_out,
+    uint64_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* __restrict values_temp,
+    uint32_t size, uint32_t num_threads, ScatterMode scatter_mode)
+{
+    detail::RadixSortParallel<11, uint64_t, ValueType> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix11sort_parallel(float* __restrict keys_in_out_f32,
     float* __restrict keys_temp_f32, ValueType* __restrict values_in_out,
-    ValueType* __restrict values_temp, uint32_t size)
+    ValueType* __restrict values_temp, uint32_t size, uint32_t num_threads, ScatterMode scatter_mode)
 {
     // create uint32_t pointers to inputs to avoid float to int casting
     uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
     uint32_t* __restrict keys_temp = reinterpret_cast<uint32_t*>(keys_temp_f32);
 
-    detail::RadixSort<8, uint32_t, ValueType, detail::FloatFlip, detail::InvFloatFlip> sort;
+    detail::RadixSortParallel<11, uint32_t, ValueType, detail::FloatFlip, detail::InvFloatFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+
+template <typename ValueType>
+inline uint32_t counting_sort(uint8_t* __restrict keys_in_out, uint8_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    detail::CountingSort<uint8_t, ValueType> sort(scatter_mode);
     return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
 }
 
 
 template <typename ValueType>
-inline uint32_t radix11sort(float* __restrict keys_in_f32,
-    float* __restrict keys_out_f32, ValueType* __restrict values_in,
-    ValueType* __restrict values_out, uint32_t size)
+inline uint32_t counting_sort(int8_t* __restrict keys_in_out_i8, int8_t* __restrict keys_temp_i8,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    uint8_t* __restrict keys_in_out = reinterpret_cast<uint8_t*>(keys_in_out_i8);
+    uint8_t* __restrict keys_temp = reinterpret_cast<uint8_t*>(keys_temp_i8);
+
+    detail::CountingSort<uint8_t, ValueType, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t counting_sort(uint16_t* __restrict keys_in_out, uint16_t* __restrict keys_temp,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    detail::CountingSort<uint16_t, ValueType> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t counting_sort(int16_t* __restrict keys_in_out_i16, int16_t* __restrict keys_temp_i16,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    uint16_t* __restrict keys_in_out = reinterpret_cast<uint16_t*>(keys_in_out_i16);
+    uint16_t* __restrict keys_temp = reinterpret_cast<uint16_t*>(keys_temp_i16);
+
+    detail::CountingSort<uint16_t, ValueType, detail::SignFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t counting_sort(Float16* __restrict keys_in_out_f16, Float16* __restrict keys_temp_f16,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    uint16_t* __restrict keys_in_out = reinterpret_cast<uint16_t*>(keys_in_out_f16);
+    uint16_t* __restrict keys_temp = reinterpret_cast<uint16_t*>(keys_temp_f16);
+
+    detail::CountingSort<uint16_t, ValueType, detail::HalfFlip, detail::InvHalfFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t counting_sort(BFloat16* __restrict keys_in_out_bf16, BFloat16* __restrict keys_temp_bf16,
+    ValueType* __restrict values_in_out, ValueType* __restrict values_temp, uint32_t size,
+    ScatterMode scatter_mode)
+{
+    uint16_t* __restrict keys_in_out = reinterpret_cast<uint16_t*>(keys_in_out_bf16);
+    uint16_t* __restrict keys_temp = reinterpret_cast<uint16_t*>(keys_temp_bf16);
+
+    detail::CountingSort<uint16_t, ValueType, detail::HalfFlip, detail::InvHalfFlip> sort(scatter_mode);
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix_sort_msd(uint64_t* __restrict keys_in_out,
+    uint64_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* values_temp,
+    uint32_t size)
+{
+    detail::RadixSortMSD<uint64_t, ValueType> sort;
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+
+template <typename ValueType>
+inline uint32_t radix_sort_msd_parallel(uint64_t* __restrict keys_in_out,
+    uint64_t* __restrict keys_temp, ValueType* __restrict values_in_out, ValueType* __restrict values_temp,
+    uint32_t size, uint32_t num_threads)
+{
+    detail::RadixSortMSDParallel<uint64_t, ValueType> sort;
+    return sort(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+
+template <typename ValueType>
+inline void radix_sort_inplace(uint32_t* __restrict keys_in_out,
+    ValueType* __restrict values_in_out, uint32_t size)
+{
+    detail::RadixSortInPlace<uint32_t, ValueType> sort;
+    sort(keys_in_out, values_in_out, size);
+}
+
+
+template <typename ValueType>
+inline void radix_sort_inplace(uint64_t* __restrict keys_in_out,
+    ValueType* __restrict values_in_out, uint32_t size)
+{
+    detail::RadixSortInPlace<uint64_t, ValueType> sort;
+    sort(keys_in_out, values_in_out, size);
+}
+
+
+template <typename ValueType>
+inline void radix_sort_inplace(float* __restrict keys_in_out_f32,
+    ValueType* __restrict values_in_out, uint32_t size)
 {
     // create uint32_t pointers to inputs to avoid float to int casting
-    uint32_t* __restrict keys_in = reinterpret_cast<uint32_t*>(keys_in_f32);
-    uint32_t* __restrict keys_out = reinterpret_cast<uint32_t*>(keys_out_f32);
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
 
-    detail::RadixSort<11, uint32_t, ValueType, detail::FloatFlip, detail::InvFloatFlip> sort;
-    return sort(keys_in, keys_out, values_in, values_out, size);
+    detail::RadixSortInPlace<uint32_t, ValueType, detail::FloatFlip> sort;
+    sort(keys_in_out, values_in_out, size);
+}
+
+template <typename ValueType>
+inline void radix_sort_inplace_parallel(uint32_t* __restrict keys_in_out,
+    ValueType* __restrict values_in_out, uint32_t size, uint32_t num_threads)
+{
+    detail::RadixSortInPlaceParallel<uint32_t, ValueType> sort;
+    sort(keys_in_out, values_in_out, size, num_threads);
+}
+
+
+template <typename ValueType>
+inline void radix_sort_inplace_parallel(uint64_t* __restrict keys_in_out,
+    ValueType* __restrict values_in_out, uint32_t size, uint32_t num_threads)
+{
+    detail::RadixSortInPlaceParallel<uint64_t, ValueType> sort;
+    sort(keys_in_out, values_in_out, size, num_threads);
+}
+
+
+template <typename ValueType>
+inline void radix_sort_inplace_parallel(float* __restrict keys_in_out_f32,
+    ValueType* __restrict values_in_out, uint32_t size, uint32_t num_threads)
+{
+    // create uint32_t pointers to inputs to avoid float to int casting
+    uint32_t* __restrict keys_in_out = reinterpret_cast<uint32_t*>(keys_in_out_f32);
+
+    detail::RadixSortInPlaceParallel<uint32_t, ValueType, detail::FloatFlip> sort;
+    sort(keys_in_out, values_in_out, size, num_threads);
+}
+
+
+inline void apply_permutation(const uint32_t* __restrict indices, uint32_t size,
+    const PermutationColumn* columns, uint32_t num_columns, uint32_t num_threads)
+{
+    detail::ApplyPermutation apply(indices, size, num_threads);
+    apply(columns, num_columns);
+}
+
+
+template <typename ValueType>
+inline void apply_permutation(const uint32_t* __restrict indices, uint32_t size,
+    const ValueType* __restrict values_in, ValueType* __restrict values_out, uint32_t num_threads)
+{
+    static_assert(std::is_trivially_copyable<ValueType>::value, "values are copied as bytes");
+    const PermutationColumn column = {values_in, values_out, sizeof(ValueType)};
+    apply_permutation(indices, size, &column, 1, num_threads);
 }
 
 } // namespace bits
@@ -2,7 +2,13 @@
 #define BITS_TEST_COMMON_HPP
 
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <random>
+#include <type_traits>
+#include <vector>
 
 namespace bits
 {
@@ -29,6 +35,40 @@ inline void rand_keys(
     }
 }
 
+inline void rand_keys(std::mt19937& rnd32, int32_t* keys, uint32_t* indices, int32_t* copy, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys[i] = static_cast<int32_t>(rnd32());
+        copy[i] = keys[i];
+        indices[i] = i;
+    }
+}
+
+inline void rand_keys(std::mt19937_64& rnd64, int64_t* keys, uint32_t* indices, int64_t* copy, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys[i] = static_cast<int64_t>(rnd64());
+        copy[i] = keys[i];
+        indices[i] = i;
+    }
+}
+
+/**
+ * Random 8 and 16 bit keys, the low bits of a 32 bit random number.
+ */
+template <typename KeyType, typename = typename std::enable_if<sizeof(KeyType) <= 2>::type>
+inline void rand_keys(std::mt19937& rnd32, KeyType* keys, uint32_t* indices, KeyType* copy, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys[i] = static_cast<KeyType>(rnd32());
+        copy[i] = keys[i];
+        indices[i] = i;
+    }
+}
+
 inline void rand_keys(std::mt19937& rnd32, float* keys, uint32_t* indices, float* copy, uint32_t size)
 {
     for (uint32_t i = 0; i < size; ++i)
@@ -43,6 +83,20 @@ inline void rand_keys(std::mt19937& rnd32, float* keys, uint32_t* indices, float
     }
 }
 
+inline void rand_keys(std::mt19937_64& rnd64, double* keys, uint32_t* indices, double* copy, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys[i] = (double)(rnd64()) / 2048.0;
+        if (rand() & 1)
+        {
+            keys[i] = -keys[i];
+        }
+        copy[i] = keys[i];
+        indices[i] = i;
+    }
+}
+
 template <typename KeyType>
 struct RngType {};
 
@@ -60,6 +114,48 @@ struct RngType<uint64_t>
 };
 
 
+template <>
+struct RngType<int32_t>
+{
+	typedef std::mt19937 type;
+};
+
+
+template <>
+struct RngType<int64_t>
+{
+	typedef std::mt19937_64 type;
+};
+
+
+template <>
+struct RngType<uint8_t>
+{
+	typedef std::mt19937 type;
+};
+
+
+template <>
+struct RngType<int8_t>
+{
+	typedef std::mt19937 type;
+};
+
+
+template <>
+struct RngType<uint16_t>
+{
+	typedef std::mt19937 type;
+};
+
+
+template <>
+struct RngType<int16_t>
+{
+	typedef std::mt19937 type;
+};
+
+
 template <>
 struct RngType<float>
 {
@@ -67,28 +163,1022 @@ struct RngType<float>
 };
 
 
+template <>
+struct RngType<double>
+{
+	typedef std::mt19937_64 type;
+};
+
+
+template <typename KeyType, typename ValueType>
+void test_radixsort(uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t),
+    const KeyType* keys_in, uint32_t size)
+{
+    std::vector<KeyType> keys[2] = {std::vector<KeyType>(keys_in, keys_in + size),
+        std::vector<KeyType>(size)};
+    std::vector<ValueType> indices[2] = {std::vector<ValueType>(size), std::vector<ValueType>(size)};
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        indices[0][i] = i;
+    }
+
+    auto out = radixsort(keys[0].data(), keys[1].data(), indices[0].data(), indices[1].data(), size);
+
+    REQUIRE(out < 2);
+
+    const KeyType* keys_out = keys[out].data();
+    const ValueType* indices_out = indices[out].data();
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        if (i > 0)
+        {
+            REQUIRE(keys_out[i - 1] <= keys_out[i]);
+            if (keys_out[i - 1] == keys_out[i])
+            {
+                // radix sort is stable
+                REQUIRE(indices_out[i - 1] < indices_out[i]);
+            }
+        }
+        REQUIRE(keys_out[i] == keys_in[indices_out[i]]);
+    }
+}
+
 template <typename KeyType, typename ValueType, uint32_t N = 8>
 void test_radixsort(uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t))
 {
     static const size_t array_size = N;
     typename RngType<KeyType>::type rng;
-    KeyType keys[2][array_size];
+    KeyType keys[array_size];
     KeyType keys_copy[array_size];
-    uint32_t indices[2][array_size];
+    uint32_t indices[array_size];
 
-    rand_keys(rng, keys[0], indices[0], keys_copy, array_size);
-    auto out = radixsort(keys[0], keys[1], indices[0], indices[1], array_size);
+    rand_keys(rng, keys, indices, keys_copy, array_size);
+    test_radixsort(radixsort, keys_copy, array_size);
+}
 
-    REQUIRE(out < 2);
+/**
+ * Sort random keys for sizes either side of the small array thresholds.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_sizes(uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t))
+{
+    static const uint32_t sizes[] = {0, 1, 2, 3, 31, 32, 33, 63, 64, 65, 100, 127, 128, 129, 1000};
+    static const uint32_t max_size = 1000;
+    typename RngType<KeyType>::type rng;
+    KeyType keys[max_size];
+    KeyType keys_copy[max_size];
+    uint32_t indices[max_size];
+
+    rand_keys(rng, keys, indices, keys_copy, max_size);
+    for (uint32_t size : sizes)
+    {
+        test_radixsort(radixsort, keys_copy, size);
+    }
+
+    // duplicate keys must keep their order
+    for (uint32_t i = 0; i < max_size; ++i)
+    {
+        keys_copy[i] = keys_copy[i % 7];
+    }
+    for (uint32_t size : sizes)
+    {
+        test_radixsort(radixsort, keys_copy, size);
+    }
+}
+
+/**
+ * Sort keys where only the lowest bits vary, so most radix passes can be
+ * skipped, and keys which are all equal, so every radix pass can be skipped.
+ */
+template <typename KeyType, typename ValueType, uint32_t N = 1024>
+void test_radixsort_skip_passes(uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t))
+{
+    static const size_t array_size = N;
+    typename RngType<KeyType>::type rng;
+    KeyType keys[array_size];
+    for (uint32_t i = 0; i < array_size; ++i)
+    {
+        keys[i] = static_cast<KeyType>(rng() & 0x3ff);
+    }
+    test_radixsort(radixsort, keys, array_size);
+
+    for (uint32_t i = 0; i < array_size; ++i)
+    {
+        keys[i] = static_cast<KeyType>(42);
+    }
+    test_radixsort(radixsort, keys, array_size);
+
+    test_radixsort(radixsort, keys, 0);
+}
+
+/**
+ * Sort keys which span a narrow range straddling digit boundaries, so fewer
+ * radix passes are needed when sorting relative to the minimum key.
+ */
+template <typename KeyType, typename ValueType, uint32_t N = 1024>
+void test_radixsort_narrow_range(uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t),
+    KeyType base)
+{
+    static const size_t array_size = N;
+    typename RngType<KeyType>::type rng;
+    KeyType keys[array_size];
+    for (uint32_t i = 0; i < array_size; ++i)
+    {
+        keys[i] = static_cast<KeyType>(base + static_cast<KeyType>(rng() % 4096));
+    }
+    test_radixsort(radixsort, keys, array_size);
+}
+
+/**
+ * Sort keys which are already ascending, strictly descending and descending
+ * with duplicates, which must not simply be reversed.
+ */
+template <typename KeyType, typename ValueType, uint32_t N = 1024>
+void test_radixsort_presorted(uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t))
+{
+    static const size_t array_size = N;
+    typename RngType<KeyType>::type rng;
+    KeyType keys[array_size];
+    KeyType keys_copy[array_size];
+    uint32_t indices[array_size];
+
+    rand_keys(rng, keys, indices, keys_copy, array_size);
+    std::sort(keys_copy, keys_copy + array_size);
+    test_radixsort(radixsort, keys_copy, array_size);
+
+    // sorted keys are left in the input buffer
+    std::copy(keys_copy, keys_copy + array_size, keys);
+    KeyType keys_temp[array_size];
+    uint32_t indices_temp[array_size];
+    REQUIRE(radixsort(keys, keys_temp, indices, indices_temp, array_size) == 0);
+
+    std::reverse(keys_copy, keys_copy + array_size);
+    test_radixsort(radixsort, keys_copy, array_size);
+
+    // keys which are only out of order at the end
+    std::swap(keys_copy[array_size - 2], keys_copy[array_size - 1]);
+    test_radixsort(radixsort, keys_copy, array_size);
+    std::swap(keys_copy[array_size - 2], keys_copy[array_size - 1]);
+    std::reverse(keys_copy, keys_copy + array_size);
+    std::swap(keys_copy[array_size - 2], keys_copy[array_size - 1]);
+    test_radixsort(radixsort, keys_copy, array_size);
+    std::swap(keys_copy[array_size - 2], keys_copy[array_size - 1]);
+    std::reverse(keys_copy, keys_copy + array_size);
+
+    for (uint32_t i = 0; i < array_size; ++i)
+    {
+        keys_copy[i] = keys_copy[i & ~1u];
+    }
+    test_radixsort(radixsort, keys_copy, array_size);
+}
+
+/**
+ * Sort floating point keys drawn from values in ascending IEEE 754 total
+ * order, including infinities, signed zeros and NaNs with either sign and
+ * different payloads, which can't be compared with <. Keys must be ordered
+ * by their position in the list of values and equal keys must keep their
+ * order. inf is the bit pattern of +inf.
+ */
+template <typename KeyType, typename BitsType, typename ValueType>
+void test_radixsort_special(
+    uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t), const BitsType inf)
+{
+    static const uint32_t kSignBit = sizeof(BitsType) * 8 - 1;
+    const BitsType sign = BitsType(BitsType(1) << kSignBit);
+    const BitsType values[] = {BitsType(sign | inf | 2), BitsType(sign | inf | 1), BitsType(sign | inf),
+        BitsType(sign | (inf - 1)), BitsType(sign | 1), sign, 0, 1, BitsType(inf - 1), inf, BitsType(inf | 1),
+        BitsType(inf | 2)};
+    const uint32_t num_values = sizeof(values) / sizeof(values[0]);
+
+    static const uint32_t sizes[] = {8, 100, 1000};
+    std::mt19937 rng;
+    for (uint32_t size : sizes)
+    {
+        std::vector<uint32_t> ranks(size);
+        std::vector<KeyType> keys[2] = {std::vector<KeyType>(size), std::vector<KeyType>(size)};
+        std::vector<ValueType> indices[2] = {std::vector<ValueType>(size), std::vector<ValueType>(size)};
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            ranks[i] = rng() % num_values;
+            std::memcpy(&keys[0][i], &values[ranks[i]], sizeof(BitsType));
+            indices[0][i] = i;
+        }
+
+        const uint32_t out =
+            radixsort(keys[0].data(), keys[1].data(), indices[0].data(), indices[1].data(), size);
+        REQUIRE(out < 2);
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            const uint32_t index = indices[out][i];
+            REQUIRE(index < size);
+            REQUIRE(std::memcmp(&keys[out][i], &values[ranks[index]], sizeof(BitsType)) == 0);
+            if (i > 0)
+            {
+                const uint32_t prev = indices[out][i - 1];
+                REQUIRE(ranks[prev] <= ranks[index]);
+                if (ranks[prev] == ranks[index])
+                {
+                    REQUIRE(prev < index);
+                }
+            }
+        }
+    }
+}
+
+template <typename KeyType, typename BitsType, typename ValueType>
+void test_radixsort_special(uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t))
+{
+    const KeyType infinity = std::numeric_limits<KeyType>::infinity();
+    BitsType inf;
+    std::memcpy(&inf, &infinity, sizeof(inf));
+    test_radixsort_special<KeyType, BitsType>(radixsort, inf);
+}
+
+/**
+ * Decode the bits of a half float or bfloat16 to a float.
+ */
+inline float half_to_float(uint16_t bits)
+{
+    const int exponent = (bits >> 10) & 0x1f;
+    const int mantissa = bits & 0x3ff;
+    float value = exponent == 0 ? std::ldexp(float(mantissa), -24)
+        : exponent == 0x1f      ? (mantissa ? std::numeric_limits<float>::quiet_NaN()
+                                            : std::numeric_limits<float>::infinity())
+                                : std::ldexp(float(mantissa | 0x400), exponent - 25);
+    return (bits & 0x8000) ? -value : value;
+}
+
+inline float bfloat16_to_float(uint16_t bits)
+{
+    const uint32_t bits32 = uint32_t(bits) << 16;
+    float value;
+    std::memcpy(&value, &bits32, sizeof(value));
+    return value;
+}
+
+/**
+ * Sort random half float or bfloat16 keys, excluding NaNs, and check the
+ * result matches a stable sort of their decoded values with -0 before +0,
+ * then sort the result again to check it is left in order. The sizes cover
+ * the sorting network and both the two pass and single pass counting sorts.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_half(uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t),
+    float (*to_float)(uint16_t))
+{
+    static_assert(sizeof(KeyType) == 2, "half float keys are 16 bits");
+    auto less = [to_float](uint16_t a, uint16_t b) {
+        const float fa = to_float(a), fb = to_float(b);
+        return fa < fb || (fa == fb && (a >> 15) > (b >> 15));
+    };
+
+    static const uint32_t sizes[] = {30, 1000, (1 << 16) + 3};
+    std::mt19937 rng;
+    for (uint32_t size : sizes)
+    {
+        std::vector<uint16_t> bits(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            do
+            {
+                bits[i] = uint16_t(rng());
+            } while (to_float(bits[i]) != to_float(bits[i]));
+        }
+
+        std::vector<uint32_t> expected(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            expected[i] = i;
+        }
+        std::stable_sort(expected.begin(), expected.end(),
+            [&bits, &less](uint32_t a, uint32_t b) { return less(bits[a], bits[b]); });
+
+        std::vector<KeyType> keys[2] = {std::vector<KeyType>(size), std::vector<KeyType>(size)};
+        std::vector<ValueType> indices[2] = {std::vector<ValueType>(size), std::vector<ValueType>(size)};
+        std::memcpy(keys[0].data(), bits.data(), size * sizeof(KeyType));
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            indices[0][i] = i;
+        }
+
+        const uint32_t out =
+            radixsort(keys[0].data(), keys[1].data(), indices[0].data(), indices[1].data(), size);
+        REQUIRE(out < 2);
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            uint16_t key;
+            std::memcpy(&key, &keys[out][i], sizeof(key));
+            REQUIRE(indices[out][i] == expected[i]);
+            REQUIRE(key == bits[expected[i]]);
+        }
+
+        // sorting the sorted keys again must leave them in order
+        std::vector<KeyType> sorted_keys[2] = {keys[out], std::vector<KeyType>(size)};
+        std::vector<ValueType> sorted_indices[2] = {indices[out], std::vector<ValueType>(size)};
+        const uint32_t sorted_out = radixsort(sorted_keys[0].data(), sorted_keys[1].data(),
+            sorted_indices[0].data(), sorted_indices[1].data(), size);
+        REQUIRE(sorted_out < 2);
+        REQUIRE(sorted_indices[sorted_out] == indices[out]);
+    }
+}
+
+/**
+ * Sort keys into descending order and check the keys and values match a
+ * stable sort of the keys with std::greater, for random keys, keys with many
+ * duplicates, ascending and descending keys and keys in a narrow range, at
+ * sizes covering the sorting network and the radix passes.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_descending(uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t))
+{
+    auto check = [radixsort](const std::vector<KeyType>& keys_in) {
+        const uint32_t size = static_cast<uint32_t>(keys_in.size());
+        std::vector<uint32_t> expected(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            expected[i] = i;
+        }
+        std::stable_sort(expected.begin(), expected.end(),
+            [&keys_in](uint32_t a, uint32_t b) { return keys_in[a] > keys_in[b]; });
+
+        std::vector<KeyType> keys[2] = {keys_in, std::vector<KeyType>(size)};
+        std::vector<ValueType> indices[2] = {std::vector<ValueType>(size), std::vector<ValueType>(size)};
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            indices[0][i] = i;
+        }
+
+        const uint32_t out =
+            radixsort(keys[0].data(), keys[1].data(), indices[0].data(), indices[1].data(), size);
+        REQUIRE(out < 2);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            REQUIRE(indices[out][i] == expected[i]);
+            REQUIRE(keys[out][i] == keys_in[expected[i]]);
+        }
+    };
+
+    static const uint32_t sizes[] = {1, 2, 30, 100, 1000, 70000};
+    typename RngType<KeyType>::type rng;
+    for (uint32_t size : sizes)
+    {
+        std::vector<KeyType> keys(size);
+        std::vector<KeyType> keys_copy(size);
+        std::vector<uint32_t> indices(size);
+        rand_keys(rng, keys.data(), indices.data(), keys_copy.data(), size);
+        check(keys_copy);
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            keys_copy[i] = keys[rng() % std::min(size, 16u)];
+        }
+        check(keys_copy);
+
+        std::sort(keys_copy.begin(), keys_copy.end());
+        check(keys_copy);
+        std::reverse(keys_copy.begin(), keys_copy.end());
+        check(keys_copy);
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            keys_copy[i] = static_cast<KeyType>(1000 + rng() % 512);
+        }
+        check(keys_copy);
+    }
+}
+
+/**
+ * Sort keys which include the lowest and highest values of the key type at
+ * every size sorted by the sorting network, and check they are in ascending or
+ * descending order with equal keys kept in order. Their decoded keys are 0 or
+ * all ones, which must still sort ahead of the network's padding.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_extremes(uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t),
+    bool descending = false)
+{
+    const KeyType extremes[] = {std::numeric_limits<KeyType>::lowest(), std::numeric_limits<KeyType>::max(),
+        std::numeric_limits<KeyType>::has_infinity ? -std::numeric_limits<KeyType>::infinity()
+                                                   : std::numeric_limits<KeyType>::lowest(),
+        std::numeric_limits<KeyType>::has_infinity ? std::numeric_limits<KeyType>::infinity()
+                                                   : std::numeric_limits<KeyType>::max()};
+    typename RngType<KeyType>::type rng;
+    for (uint32_t size = 33; size <= 128; ++size)
+    {
+        std::vector<KeyType> keys_in(size);
+        std::vector<uint32_t> indices(size);
+        std::vector<KeyType> keys_copy(size);
+        rand_keys(rng, keys_in.data(), indices.data(), keys_copy.data(), size);
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            keys_in[rng() % size] = extremes[i];
+        }
+
+        std::vector<uint32_t> expected(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            expected[i] = i;
+        }
+        std::stable_sort(expected.begin(), expected.end(), [&keys_in, descending](uint32_t a, uint32_t b) {
+            return descending ? keys_in[a] > keys_in[b] : keys_in[a] < keys_in[b];
+        });
+
+        std::vector<KeyType> keys[2] = {keys_in, std::vector<KeyType>(size)};
+        std::vector<ValueType> values[2] = {std::vector<ValueType>(size), std::vector<ValueType>(size)};
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            values[0][i] = i;
+        }
+        const uint32_t out = radixsort(keys[0].data(), keys[1].data(), values[0].data(), values[1].data(), size);
+        REQUIRE(out < 2);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            REQUIRE(values[out][i] == expected[i]);
+            REQUIRE(keys[out][i] == keys_in[expected[i]]);
+        }
+    }
+}
+
+/**
+ * Sort keys with a key only sort and the sort of keys and values it is based
+ * on and check both return the same buffer holding identical keys.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_keys(uint32_t (*keys_radixsort)(KeyType*, KeyType*, uint32_t),
+    uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t), const KeyType* keys_in,
+    uint32_t size)
+{
+    std::vector<KeyType> keys[2] = {std::vector<KeyType>(keys_in, keys_in + size), std::vector<KeyType>(size)};
+    std::vector<ValueType> values[2] = {std::vector<ValueType>(size), std::vector<ValueType>(size)};
+    std::vector<KeyType> keys_only[2] = {keys[0], keys[1]};
+
+    const uint32_t out = radixsort(keys[0].data(), keys[1].data(), values[0].data(), values[1].data(), size);
+    const uint32_t keys_out = keys_radixsort(keys_only[0].data(), keys_only[1].data(), size);
+
+    REQUIRE(keys_out == out);
+    REQUIRE(std::memcmp(keys_only[out].data(), keys[out].data(), sizeof(KeyType) * size) == 0);
+}
+
+/**
+ * Compare a key only sort with its sort of keys and values for random keys,
+ * keys with many duplicates, ascending and descending keys and keys in a
+ * narrow range, at sizes covering the sorting network and the radix passes.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_keys(uint32_t (*keys_radixsort)(KeyType*, KeyType*, uint32_t),
+    uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t))
+{
+    static const uint32_t sizes[] = {1, 2, 30, 100, 1000, 70000};
+    typename RngType<KeyType>::type rng;
+    for (uint32_t size : sizes)
+    {
+        std::vector<KeyType> keys(size);
+        std::vector<KeyType> keys_copy(size);
+        std::vector<uint32_t> indices(size);
+        rand_keys(rng, keys.data(), indices.data(), keys_copy.data(), size);
+        test_radixsort_keys(keys_radixsort, radixsort, keys_copy.data(), size);
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            keys_copy[i] = keys[rng() % std::min(size, 16u)];
+        }
+        test_radixsort_keys(keys_radixsort, radixsort, keys_copy.data(), size);
+
+        std::sort(keys.begin(), keys.end());
+        test_radixsort_keys(keys_radixsort, radixsort, keys.data(), size);
+        std::reverse(keys.begin(), keys.end());
+        test_radixsort_keys(keys_radixsort, radixsort, keys.data(), size);
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            keys_copy[i] = static_cast<KeyType>(1000 + rng() % 512);
+        }
+        test_radixsort_keys(keys_radixsort, radixsort, keys_copy.data(), size);
+    }
+}
+
+/**
+ * Argsort keys and sort them with their indices as values with the sort the
+ * argsort is based on, and check both return the same buffer holding the same
+ * indices, and the same keys if the argsort sorts them. The index buffers
+ * start filled with garbage, which the argsort must not read.
+ */
+template <typename KeyType, typename ValueType, typename SortKeys>
+void test_radixsort_argsort(uint32_t (*argsort)(KeyType*, KeyType*, uint32_t*, uint32_t*, uint32_t, SortKeys),
+    uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t), const KeyType* keys_in,
+    uint32_t size, bool sort_keys)
+{
+    std::vector<KeyType> keys[2] = {std::vector<KeyType>(keys_in, keys_in + size), std::vector<KeyType>(size)};
+    std::vector<ValueType> values[2] = {std::vector<ValueType>(size), std::vector<ValueType>(size)};
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        values[0][i] = i;
+    }
+    std::vector<KeyType> arg_keys[2] = {keys[0], keys[1]};
+    std::vector<uint32_t> indices[2] = {std::vector<uint32_t>(size, 0xdeadbeef), std::vector<uint32_t>(size, 0xdeadbeef)};
+
+    const uint32_t out = radixsort(keys[0].data(), keys[1].data(), values[0].data(), values[1].data(), size);
+    const uint32_t arg_out = argsort(arg_keys[0].data(), arg_keys[1].data(), indices[0].data(), indices[1].data(),
+        size, SortKeys(sort_keys));
+
+    REQUIRE(arg_out == out);
+    REQUIRE(indices[out] == values[out]);
+    if (sort_keys)
+    {
+        REQUIRE(std::memcmp(arg_keys[out].data(), keys[out].data(), sizeof(KeyType) * size) == 0);
+    }
+}
+
+/**
+ * Compare an argsort with its sort of keys and values, with and without
+ * sorting the keys, for random keys, keys with many duplicates, ascending and
+ * descending keys and keys in a narrow range, at sizes covering the sorting
+ * network and the radix passes.
+ */
+template <typename KeyType, typename ValueType, typename SortKeys>
+void test_radixsort_argsort(uint32_t (*argsort)(KeyType*, KeyType*, uint32_t*, uint32_t*, uint32_t, SortKeys),
+    uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t))
+{
+    static const uint32_t sizes[] = {1, 2, 30, 100, 1000, 70000};
+    typename RngType<KeyType>::type rng;
+    for (uint32_t size : sizes)
+    {
+        std::vector<KeyType> keys(size);
+        std::vector<KeyType> keys_copy(size);
+        std::vector<uint32_t> indices(size);
+        rand_keys(rng, keys.data(), indices.data(), keys_copy.data(), size);
+        std::vector<KeyType> duplicates(size);
+        std::vector<KeyType> narrow(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            duplicates[i] = keys[rng() % std::min(size, 16u)];
+            narrow[i] = static_cast<KeyType>(1000 + rng() % 512);
+        }
+        std::vector<KeyType> ascending = keys;
+        std::sort(ascending.begin(), ascending.end());
+        std::vector<KeyType> descending(ascending.rbegin(), ascending.rend());
+
+        for (bool sort_keys : {true, false})
+        {
+            test_radixsort_argsort(argsort, radixsort, keys_copy.data(), size, sort_keys);
+            test_radixsort_argsort(argsort, radixsort, duplicates.data(), size, sort_keys);
+            test_radixsort_argsort(argsort, radixsort, ascending.data(), size, sort_keys);
+            test_radixsort_argsort(argsort, radixsort, descending.data(), size, sort_keys);
+            test_radixsort_argsort(argsort, radixsort, narrow.data(), size, sort_keys);
+        }
+    }
+}
+
+/**
+ * Make a value of value_size bytes for the given index, so values sorted with
+ * their keys can be checked against the permutation which sorts the keys.
+ */
+inline void make_value(uint8_t* value, size_t value_size, uint32_t index)
+{
+    for (size_t j = 0; j < value_size; ++j)
+    {
+        value[j] = static_cast<uint8_t>((index >> (8 * (j % 4))) ^ (j * 37));
+    }
+}
+
+/**
+ * Sort keys with 64 bit values and with values of several sizes, and check
+ * they return the same buffer holding the same keys as sorting the keys with
+ * their indices, and that the values were moved the same way as the indices.
+ */
+template <typename KeyType>
+void test_radixsort_values(uint32_t (*values64_radixsort)(KeyType*, KeyType*, uint64_t*, uint64_t*, uint32_t),
+    uint32_t (*values_radixsort)(KeyType*, KeyType*, void*, void*, uint32_t, size_t),
+    uint32_t (*radixsort)(KeyType*, KeyType*, uint32_t*, uint32_t*, uint32_t), const KeyType* keys_in,
+    uint32_t size)
+{
+    std::vector<KeyType> keys[2] = {std::vector<KeyType>(keys_in, keys_in + size), std::vector<KeyType>(size)};
+    std::vector<uint32_t> indices[2] = {std::vector<uint32_t>(size), std::vector<uint32_t>(size)};
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        indices[0][i] = i;
+    }
+    const uint32_t out = radixsort(keys[0].data(), keys[1].data(), indices[0].data(), indices[1].data(), size);
+
+    {
+        std::vector<KeyType> values_keys[2] = {std::vector<KeyType>(keys_in, keys_in + size), std::vector<KeyType>(size)};
+        std::vector<uint64_t> values[2] = {std::vector<uint64_t>(size), std::vector<uint64_t>(size)};
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            values[0][i] = i * UINT64_C(0x9e3779b97f4a7c15);
+        }
+        const uint32_t values_out = values64_radixsort(values_keys[0].data(), values_keys[1].data(), values[0].data(),
+            values[1].data(), size);
+        REQUIRE(values_out == out);
+        REQUIRE(std::memcmp(values_keys[out].data(), keys[out].data(), sizeof(KeyType) * size) == 0);
+        std::vector<uint64_t> expected(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            expected[i] = indices[out][i] * UINT64_C(0x9e3779b97f4a7c15);
+        }
+        REQUIRE(values[out] == expected);
+    }
 
-    const KeyType* keys_out = keys[out];
-    const uint32_t* indices_out = indices[out];
+    static const size_t value_sizes[] = {1, 2, 3, 4, 8, 12};
+    for (size_t value_size : value_sizes)
+    {
+        std::vector<KeyType> values_keys[2] = {std::vector<KeyType>(keys_in, keys_in + size), std::vector<KeyType>(size)};
+        std::vector<uint8_t> values[2] = {std::vector<uint8_t>(size * value_size), std::vector<uint8_t>(size * value_size)};
+        std::vector<uint8_t> expected(size * value_size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            make_value(&values[0][i * value_size], value_size, i);
+        }
+        const uint32_t values_out = values_radixsort(values_keys[0].data(), values_keys[1].data(), values[0].data(),
+            values[1].data(), size, value_size);
+        REQUIRE(values_out == out);
+        REQUIRE(std::memcmp(values_keys[out].data(), keys[out].data(), sizeof(KeyType) * size) == 0);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            make_value(&expected[i * value_size], value_size, indices[out][i]);
+        }
+        REQUIRE(values[out] == expected);
+    }
+}
 
-    for (uint32_t i = 1; i < array_size; ++i)
+/**
+ * Compare sorts with 64 bit and other sized values with the sort of keys and
+ * 32 bit values for random keys, keys with many duplicates, ascending and
+ * descending keys and keys in a narrow range, at sizes covering the sorting
+ * network and the radix passes.
+ */
+template <typename KeyType>
+void test_radixsort_values(uint32_t (*values64_radixsort)(KeyType*, KeyType*, uint64_t*, uint64_t*, uint32_t),
+    uint32_t (*values_radixsort)(KeyType*, KeyType*, void*, void*, uint32_t, size_t),
+    uint32_t (*radixsort)(KeyType*, KeyType*, uint32_t*, uint32_t*, uint32_t))
+{
+    static const uint32_t sizes[] = {1, 2, 30, 100, 1000, 70000};
+    typename RngType<KeyType>::type rng;
+    for (uint32_t size : sizes)
+    {
+        std::vector<KeyType> keys(size);
+        std::vector<KeyType> keys_copy(size);
+        std::vector<uint32_t> indices(size);
+        rand_keys(rng, keys.data(), indices.data(), keys_copy.data(), size);
+        test_radixsort_values(values64_radixsort, values_radixsort, radixsort, keys_copy.data(), size);
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            keys_copy[i] = keys[rng() % std::min(size, 16u)];
+        }
+        test_radixsort_values(values64_radixsort, values_radixsort, radixsort, keys_copy.data(), size);
+
+        std::sort(keys.begin(), keys.end());
+        test_radixsort_values(values64_radixsort, values_radixsort, radixsort, keys.data(), size);
+        std::reverse(keys.begin(), keys.end());
+        test_radixsort_values(values64_radixsort, values_radixsort, radixsort, keys.data(), size);
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            keys_copy[i] = static_cast<KeyType>(1000 + rng() % 512);
+        }
+        test_radixsort_values(values64_radixsort, values_radixsort, radixsort, keys_copy.data(), size);
+    }
+}
+
+/**
+ * Sort keys with values of several sizes, and keys only with null values, with
+ * a sort taking a size_t size, and check it returns the same buffer holding
+ * the same keys and values as the sort taking a 32 bit size, for random keys,
+ * keys with many duplicates and ascending keys. Sorts counting in 64 bit
+ * histograms skip different passes, so only their keys and values are
+ * compared unless same_buffer is set.
+ */
+template <typename KeyType>
+void test_radixsort_size64(uint32_t (*size64_radixsort)(KeyType*, KeyType*, void*, void*, size_t, size_t),
+    uint32_t (*values_radixsort)(KeyType*, KeyType*, void*, void*, uint32_t, size_t), bool same_buffer = true)
+{
+    static const uint32_t sizes[] = {1, 2, 30, 100, 1000, 70000};
+    static const size_t value_sizes[] = {0, 4, 8, 12};
+    typename RngType<KeyType>::type rng;
+    for (uint32_t size : sizes)
+    {
+        std::vector<KeyType> keys(size);
+        std::vector<KeyType> keys_copy(size);
+        std::vector<uint32_t> indices(size);
+        rand_keys(rng, keys.data(), indices.data(), keys_copy.data(), size);
+        for (uint32_t i = size / 2; i < size; ++i)
+        {
+            keys[i] = keys[rng() % std::min(size, 16u)];
+        }
+
+        for (int order = 0; order < 2; ++order)
+        {
+            for (size_t value_size : value_sizes)
+            {
+                std::vector<KeyType> expected_keys[2] = {keys, std::vector<KeyType>(size)};
+                std::vector<KeyType> size64_keys[2] = {keys, std::vector<KeyType>(size)};
+                std::vector<uint8_t> expected_values[2] = {std::vector<uint8_t>(size * value_size),
+                    std::vector<uint8_t>(size * value_size)};
+                for (uint32_t i = 0; i < size; ++i)
+                {
+                    make_value(&expected_values[0][i * value_size], value_size, i);
+                }
+                std::vector<uint8_t> size64_values[2] = {expected_values[0], expected_values[1]};
+
+                const uint32_t out = values_radixsort(expected_keys[0].data(), expected_keys[1].data(),
+                    value_size ? expected_values[0].data() : nullptr,
+                    value_size ? expected_values[1].data() : nullptr, size, value_size);
+                const uint32_t size64_out = size64_radixsort(size64_keys[0].data(), size64_keys[1].data(),
+                    value_size ? size64_values[0].data() : nullptr, value_size ? size64_values[1].data() : nullptr,
+                    size, value_size);
+                REQUIRE(size64_out < 2);
+                REQUIRE((!same_buffer || size64_out == out));
+                REQUIRE(std::memcmp(size64_keys[size64_out].data(), expected_keys[out].data(),
+                            sizeof(KeyType) * size) == 0);
+                REQUIRE(size64_values[size64_out] == expected_values[out]);
+            }
+            std::sort(keys.begin(), keys.end());
+        }
+    }
+}
+
+/**
+ * Reorder columns of several value sizes by a random permutation with one and
+ * several threads, and check each column holds the values the indices point
+ * to. At the largest size the 8 and 12 byte columns are large enough to be
+ * gathered through the partition of the permutation.
+ */
+template <typename ColumnType>
+void test_apply_permutation(
+    void (*apply_permutation)(const uint32_t*, uint32_t, const ColumnType*, uint32_t, uint32_t))
+{
+    static const uint32_t sizes[] = {0, 1, 1000, 70000, (1 << 22) + 3};
+    static const size_t value_sizes[] = {1, 2, 3, 4, 8, 12};
+    static const uint32_t num_columns = sizeof(value_sizes) / sizeof(value_sizes[0]);
+    std::mt19937 rng;
+    for (uint32_t size : sizes)
+    {
+        std::vector<uint32_t> indices(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            indices[i] = i;
+        }
+        std::shuffle(indices.begin(), indices.end(), rng);
+
+        std::vector<uint8_t> values_in[num_columns];
+        std::vector<uint8_t> values_out[num_columns];
+        std::vector<uint8_t> expected[num_columns];
+        ColumnType columns[num_columns];
+        for (uint32_t column = 0; column < num_columns; ++column)
+        {
+            const size_t value_size = value_sizes[column];
+            values_in[column].resize(size * value_size);
+            values_out[column].resize(size * value_size);
+            expected[column].resize(size * value_size);
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                make_value(&values_in[column][i * value_size], value_size, i);
+                make_value(&expected[column][i * value_size], value_size, indices[i]);
+            }
+            columns[column] = ColumnType{values_in[column].data(), values_out[column].data(), value_size};
+        }
+
+        for (uint32_t num_threads : {1u, 3u})
+        {
+            for (uint32_t column = 0; column < num_columns; ++column)
+            {
+                std::fill(values_out[column].begin(), values_out[column].end(), uint8_t(0));
+            }
+            apply_permutation(indices.data(), size, columns, num_columns, num_threads);
+            for (uint32_t column = 0; column < num_columns; ++column)
+            {
+                REQUIRE(values_out[column] == expected[column]);
+            }
+        }
+    }
+}
+
+/**
+ * Sort arrays large enough to be partitioned several times by the MSD sort,
+ * with random keys, keys whose upper bits are all zero and keys with many
+ * duplicates.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_large(uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t),
+    uint32_t size = 1 << 19)
+{
+    typename RngType<KeyType>::type rng;
+    std::vector<KeyType> keys(size);
+    std::vector<KeyType> keys_copy(size);
+    std::vector<uint32_t> indices(size);
+
+    rand_keys(rng, keys.data(), indices.data(), keys_copy.data(), size);
+    test_radixsort(radixsort, keys_copy.data(), size);
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys_copy[i] = static_cast<KeyType>(rng() & 0xffffffff);
+    }
+    test_radixsort(radixsort, keys_copy.data(), size);
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys_copy[i] = static_cast<KeyType>(rng() % 1000);
+    }
+    test_radixsort(radixsort, keys_copy.data(), size);
+}
+
+/**
+ * Sort keys in place and check they are sorted and the values are a
+ * permutation of the input. In place sorts are not stable so the order of
+ * values with equal keys is not checked.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_inplace(void (*radixsort)(KeyType*, ValueType*, uint32_t), const KeyType* keys_in,
+    uint32_t size)
+{
+    std::vector<KeyType> keys(keys_in, keys_in + size);
+    std::vector<ValueType> indices(size);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        indices[i] = i;
+    }
+
+    radixsort(keys.data(), indices.data(), size);
+
+    std::vector<bool> seen(size);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        if (i > 0)
+        {
+            REQUIRE(keys[i - 1] <= keys[i]);
+        }
+        REQUIRE(indices[i] < size);
+        REQUIRE(!seen[indices[i]]);
+        seen[indices[i]] = true;
+        REQUIRE(keys[i] == keys_in[indices[i]]);
+    }
+}
+
+/**
+ * Sort random keys of various sizes in place, along with keys with
+ * duplicates, keys where only the lowest bits vary and keys which are all
+ * equal.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_inplace(void (*radixsort)(KeyType*, ValueType*, uint32_t))
+{
+    static const uint32_t sizes[] = {0, 1, 2, 3, 31, 32, 33, 100, 1000, 1 << 16};
+    static const uint32_t max_size = 1 << 16;
+    typename RngType<KeyType>::type rng;
+    std::vector<KeyType> keys(max_size);
+    std::vector<KeyType> keys_copy(max_size);
+    std::vector<uint32_t> indices(max_size);
+
+    rand_keys(rng, keys.data(), indices.data(), keys_copy.data(), max_size);
+    for (uint32_t size : sizes)
+    {
+        test_radixsort_inplace(radixsort, keys_copy.data(), size);
+    }
+
+    for (uint32_t i = 0; i < max_size; ++i)
+    {
+        keys_copy[i] = keys_copy[i % 7];
+    }
+    test_radixsort_inplace(radixsort, keys_copy.data(), max_size);
+
+    for (uint32_t i = 0; i < max_size; ++i)
+    {
+        keys_copy[i] = static_cast<KeyType>(rng() & 0x3ff);
+    }
+    test_radixsort_inplace(radixsort, keys_copy.data(), max_size);
+
+    for (uint32_t i = 0; i < max_size; ++i)
+    {
+        keys_copy[i] = static_cast<KeyType>(42);
+    }
+    test_radixsort_inplace(radixsort, keys_copy.data(), max_size);
+}
+
+/**
+ * Sort arrays large enough to be split between threads in place, with random
+ * keys, keys whose upper bits are all zero, keys with many duplicates and
+ * keys which are all equal.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_inplace_large(void (*radixsort)(KeyType*, ValueType*, uint32_t), uint32_t size = 1 << 19)
+{
+    typename RngType<KeyType>::type rng;
+    std::vector<KeyType> keys(size);
+    std::vector<KeyType> keys_copy(size);
+    std::vector<uint32_t> indices(size);
+
+    rand_keys(rng, keys.data(), indices.data(), keys_copy.data(), size);
+    test_radixsort_inplace(radixsort, keys_copy.data(), size);
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys_copy[i] = static_cast<KeyType>(rng() & 0xffffff);
+    }
+    test_radixsort_inplace(radixsort, keys_copy.data(), size);
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys_copy[i] = static_cast<KeyType>(rng() % 1000);
+    }
+    test_radixsort_inplace(radixsort, keys_copy.data(), size);
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys_copy[i] = static_cast<KeyType>(42);
+    }
+    test_radixsort_inplace(radixsort, keys_copy.data(), size);
+}
+
+/**
+ * Sort keys with a parallel sort and the single threaded sort it is based on
+ * and check both return the same buffer holding identical keys and values.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_parallel(
+    uint32_t (*parallel_radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t, uint32_t),
+    uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t), const KeyType* keys_in,
+    uint32_t size, uint32_t num_threads)
+{
+    std::vector<KeyType> keys[2] = {std::vector<KeyType>(keys_in, keys_in + size), std::vector<KeyType>(size)};
+    std::vector<ValueType> values[2] = {std::vector<ValueType>(size), std::vector<ValueType>(size)};
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        values[0][i] = i;
+    }
+    std::vector<KeyType> parallel_keys[2] = {keys[0], keys[1]};
+    std::vector<ValueType> parallel_values[2] = {values[0], values[1]};
+
+    const uint32_t out = radixsort(keys[0].data(), keys[1].data(), values[0].data(), values[1].data(), size);
+    const uint32_t parallel_out = parallel_radixsort(parallel_keys[0].data(), parallel_keys[1].data(),
+        parallel_values[0].data(), parallel_values[1].data(), size, num_threads);
+
+    REQUIRE(parallel_out == out);
+    REQUIRE(std::memcmp(parallel_keys[out].data(), keys[out].data(), sizeof(KeyType) * size) == 0);
+    REQUIRE(parallel_values[out] == values[out]);
+}
+
+/**
+ * Compare a parallel sort with its single threaded sort for random keys,
+ * narrow range keys, duplicate keys and presorted keys, with arrays split
+ * between different numbers of threads.
+ */
+template <typename KeyType, typename ValueType>
+void test_radixsort_parallel(
+    uint32_t (*parallel_radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t, uint32_t),
+    uint32_t (*radixsort)(KeyType*, KeyType*, ValueType*, ValueType*, uint32_t))
+{
+    static const uint32_t num_threads[] = {0, 1, 2, 3, 4};
+    static const uint32_t size = (1 << 18) + 7;
+    typename RngType<KeyType>::type rng;
+    std::vector<KeyType> keys(size);
+    std::vector<KeyType> keys_copy(size);
+    std::vector<uint32_t> indices(size);
+
+    rand_keys(rng, keys.data(), indices.data(), keys_copy.data(), size);
+    test_radixsort_parallel(parallel_radixsort, radixsort, keys_copy.data(), 1000, 4);
+    for (uint32_t threads : num_threads)
+    {
+        test_radixsort_parallel(parallel_radixsort, radixsort, keys_copy.data(), size, threads);
+    }
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys_copy[i] = static_cast<KeyType>(static_cast<KeyType>(1000000) + static_cast<KeyType>(rng() % 4096));
+    }
+    test_radixsort_parallel(parallel_radixsort, radixsort, keys_copy.data(), size, 3);
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        keys_copy[i] = keys[i % 1000];
+    }
+    test_radixsort_parallel(parallel_radixsort, radixsort, keys_copy.data(), size, 3);
+
+    std::sort(keys_copy.begin(), keys_copy.end());
+    test_radixsort_parallel(parallel_radixsort, radixsort, keys_copy.data(), size, 3);
+
+    std::copy(keys.begin(), keys.end(), keys_copy.begin());
+    std::sort(keys_copy.begin(), keys_copy.end());
+    std::reverse(keys_copy.begin(), keys_copy.end());
+    test_radixsort_parallel(parallel_radixsort, radixsort, keys_copy.data(), size, 3);
+
+    // each thread's chunk is sorted but the whole array isn't
+    static const uint32_t block = 1 << 16;
+    std::copy(keys.begin(), keys.end(), keys_copy.begin());
+    for (uint32_t begin = 0; begin < 4 * block; begin += block)
+    {
+        std::sort(keys_copy.begin() + begin, keys_copy.begin() + begin + block);
+    }
+    test_radixsort_parallel(parallel_radixsort, radixsort, keys_copy.data(), 4 * block, 4);
+    for (uint32_t begin = 0; begin < 4 * block; begin += block)
     {
-        REQUIRE(keys_out[i - 1] <= keys_out[i]);
-        REQUIRE(keys_out[i] == keys_copy[indices_out[i]]);
+        std::reverse(keys_copy.begin() + begin, keys_copy.begin() + begin + block);
     }
+    test_radixsort_parallel(parallel_radixsort, radixsort, keys_copy.data(), 4 * block, 4);
 }
 
 } // namespace bits
@@ -2,6 +2,79 @@
 
 #include "test_common.hpp"
 #include "radixsort.h"
+#include "radixsort_isa.h"
+
+/**
+ * Sort with the given scatter mode, which must give the same results as
+ * writing directly, then restore the automatic scatter mode.
+ */
+void test_radixsort_scatter(radixsort_scatter_mode scatter_mode)
+{
+    radixsort_set_scatter_mode(scatter_mode);
+    REQUIRE(radixsort_get_scatter_mode() == scatter_mode);
+    bits::test_radixsort_sizes(radix8sort_u32);
+    bits::test_radixsort_large(radix8sort_u32, (1 << 16) + 3);
+    bits::test_radixsort_sizes(radix8sort_u64);
+    bits::test_radixsort_large(radix8sort_u64, (1 << 16) + 3);
+    bits::test_radixsort_sizes(radix8sort_f32);
+    bits::test_radixsort_large(radix8sort_f32, (1 << 16) + 3);
+    bits::test_radixsort_sizes(radix11sort_u32);
+    bits::test_radixsort_sizes(radix11sort_u64);
+    bits::test_radixsort_sizes(radix11sort_f32);
+    bits::test_radixsort_sizes(radix11sort_f64);
+    bits::test_radixsort_large(radix11sort_f64, (1 << 16) + 3);
+    bits::test_radixsort_special<double, uint64_t>(radix11sort_f64);
+    bits::test_radixsort_sizes(radix11sort_i32);
+    bits::test_radixsort_large(radix11sort_i64, (1 << 16) + 3);
+    bits::test_radixsort_descending(radix8sort_desc_u64);
+    bits::test_radixsort_descending(radix11sort_desc_f32);
+    bits::test_radixsort_keys(radix8sort_keys_u64, radix8sort_u64);
+    bits::test_radixsort_keys(radix11sort_keys_f32, radix11sort_f32);
+    bits::test_radixsort_argsort(radix8argsort_u64, radix8sort_u64);
+    bits::test_radixsort_argsort(radix11argsort_f32, radix11sort_f32);
+    bits::test_radixsort_values(radix8sort_values64_u64, radix8sort_values_u64, radix8sort_u64);
+    bits::test_radixsort_values(radix11sort_values64_f32, radix11sort_values_f32, radix11sort_f32);
+    bits::test_radixsort_parallel(radix11sort_parallel_u32, radix11sort_u32);
+    bits::test_radixsort_parallel(radix11sort_parallel_u64, radix11sort_u64);
+    bits::test_radixsort_parallel(radix11sort_parallel_f32, radix11sort_f32);
+    radixsort_set_scatter_mode(RADIXSORT_SCATTER_AUTO);
+}
+
+/**
+ * Sort with each instruction set level the CPU supports, which must give the
+ * same results, then restore the automatic level.
+ */
+void test_radixsort_isa(radixsort_isa isa)
+{
+    const radixsort_isa selected = radixsort_set_isa(isa);
+    REQUIRE(selected != RADIXSORT_ISA_AUTO);
+    REQUIRE(selected <= isa);
+    REQUIRE(radixsort_get_isa() == selected);
+    bits::test_radixsort(radix8sort_u32);
+    bits::test_radixsort(radix8sort_u64);
+    bits::test_radixsort(radix8sort_f32);
+    bits::test_radixsort_sizes(radix11sort_u32);
+    bits::test_radixsort_sizes(radix11sort_u64);
+    bits::test_radixsort_sizes(radix11sort_f32);
+    bits::test_radixsort_sizes(radix11sort_f64);
+    bits::test_radixsort_sizes(radix11sort_i32);
+    bits::test_radixsort_sizes(radix11sort_i64);
+    bits::test_radixsort_sizes(radixsort_msd_u64);
+    bits::test_radixsort_inplace(radixsort_inplace_u32);
+    bits::test_radixsort_parallel(radix11sort_parallel_u32, radix11sort_u32);
+    bits::test_radixsort_extremes(radix8sort_u64);
+    bits::test_radixsort_extremes(radix11sort_u32);
+    bits::test_radixsort_extremes(radix11sort_u64);
+    bits::test_radixsort_extremes(radix11sort_f32);
+    bits::test_radixsort_extremes(radix11sort_f64);
+    bits::test_radixsort_extremes(radix11sort_i64);
+    bits::test_radixsort_extremes(radix8sort_desc_u64, true);
+    bits::test_radixsort_extremes(radix11sort_desc_u32, true);
+    bits::test_radixsort_extremes(radix11sort_desc_u64, true);
+    bits::test_radixsort_extremes(radix11sort_desc_f64, true);
+    bits::test_radixsort_extremes(radix11sort_desc_i64, true);
+    radixsort_set_isa(RADIXSORT_ISA_AUTO);
+}
 
 TEST_CASE("c/radix8sort uint32_t")
 {
@@ -18,6 +91,11 @@ TEST_CASE("c/radix8sort float")
     bits::test_radixsort(radix8sort_f32);
 }
 
+TEST_CASE("c/radix8sort double")
+{
+    bits::test_radixsort(radix8sort_f64);
+}
+
 TEST_CASE("c/radix11sort uint32_t")
 {
     bits::test_radixsort(radix11sort_u32);
@@ -33,3 +111,675 @@ TEST_CASE("c/radix11sort float")
     bits::test_radixsort(radix11sort_f32);
 }
 
+TEST_CASE("c/radix11sort double")
+{
+    bits::test_radixsort(radix11sort_f64);
+}
+
+
+TEST_CASE("c/radix8sort uint32_t skip passes")
+{
+    bits::test_radixsort_skip_passes(radix8sort_u32);
+}
+
+TEST_CASE("c/radix8sort uint64_t skip passes")
+{
+    bits::test_radixsort_skip_passes(radix8sort_u64);
+}
+
+TEST_CASE("c/radix8sort float skip passes")
+{
+    bits::test_radixsort_skip_passes(radix8sort_f32);
+}
+
+TEST_CASE("c/radix8sort double skip passes")
+{
+    bits::test_radixsort_skip_passes(radix8sort_f64);
+}
+
+TEST_CASE("c/radix11sort uint32_t skip passes")
+{
+    bits::test_radixsort_skip_passes(radix11sort_u32);
+}
+
+TEST_CASE("c/radix11sort uint64_t skip passes")
+{
+    bits::test_radixsort_skip_passes(radix11sort_u64);
+}
+
+TEST_CASE("c/radix11sort float skip passes")
+{
+    bits::test_radixsort_skip_passes(radix11sort_f32);
+}
+
+TEST_CASE("c/radix11sort double skip passes")
+{
+    bits::test_radixsort_skip_passes(radix11sort_f64);
+}
+
+TEST_CASE("c/radix8sort uint32_t narrow range")
+{
+    bits::test_radixsort_narrow_range(radix8sort_u32, 0x00fffc00u);
+}
+
+TEST_CASE("c/radix8sort uint64_t narrow range")
+{
+    bits::test_radixsort_narrow_range(radix8sort_u64, UINT64_C(0x0123456789fffc00));
+}
+
+TEST_CASE("c/radix8sort float narrow range")
+{
+    bits::test_radixsort_narrow_range(radix8sort_f32, 1000000.0f);
+}
+
+TEST_CASE("c/radix8sort double narrow range")
+{
+    bits::test_radixsort_narrow_range(radix8sort_f64, 1000000.0);
+}
+
+TEST_CASE("c/radix11sort uint32_t narrow range")
+{
+    bits::test_radixsort_narrow_range(radix11sort_u32, 0x00fffc00u);
+}
+
+TEST_CASE("c/radix11sort uint64_t narrow range")
+{
+    bits::test_radixsort_narrow_range(radix11sort_u64, UINT64_C(0x0123456789fffc00));
+}
+
+TEST_CASE("c/radix11sort float narrow range")
+{
+    bits::test_radixsort_narrow_range(radix11sort_f32, 1000000.0f);
+}
+
+TEST_CASE("c/radix11sort double narrow range")
+{
+    bits::test_radixsort_narrow_range(radix11sort_f64, 1000000.0);
+}
+
+TEST_CASE("c/radix8sort uint32_t sizes")
+{
+    bits::test_radixsort_sizes(radix8sort_u32);
+}
+
+TEST_CASE("c/radix8sort uint64_t sizes")
+{
+    bits::test_radixsort_sizes(radix8sort_u64);
+}
+
+TEST_CASE("c/radix8sort float sizes")
+{
+    bits::test_radixsort_sizes(radix8sort_f32);
+}
+
+TEST_CASE("c/radix8sort double sizes")
+{
+    bits::test_radixsort_sizes(radix8sort_f64);
+}
+
+TEST_CASE("c/radix11sort uint32_t sizes")
+{
+    bits::test_radixsort_sizes(radix11sort_u32);
+}
+
+TEST_CASE("c/radix11sort uint64_t sizes")
+{
+    bits::test_radixsort_sizes(radix11sort_u64);
+}
+
+TEST_CASE("c/radix11sort float sizes")
+{
+    bits::test_radixsort_sizes(radix11sort_f32);
+}
+
+TEST_CASE("c/radix11sort double sizes")
+{
+    bits::test_radixsort_sizes(radix11sort_f64);
+}
+
+TEST_CASE("c/radix8sort uint32_t presorted")
+{
+    bits::test_radixsort_presorted(radix8sort_u32);
+}
+
+TEST_CASE("c/radix8sort uint64_t presorted")
+{
+    bits::test_radixsort_presorted(radix8sort_u64);
+}
+
+TEST_CASE("c/radix8sort float presorted")
+{
+    bits::test_radixsort_presorted(radix8sort_f32);
+}
+
+TEST_CASE("c/radix8sort double presorted")
+{
+    bits::test_radixsort_presorted(radix8sort_f64);
+}
+
+TEST_CASE("c/radix11sort uint32_t presorted")
+{
+    bits::test_radixsort_presorted(radix11sort_u32);
+}
+
+TEST_CASE("c/radix11sort uint64_t presorted")
+{
+    bits::test_radixsort_presorted(radix11sort_u64);
+}
+
+TEST_CASE("c/radix11sort float presorted")
+{
+    bits::test_radixsort_presorted(radix11sort_f32);
+}
+
+TEST_CASE("c/radix11sort double presorted")
+{
+    bits::test_radixsort_presorted(radix11sort_f64);
+}
+
+TEST_CASE("c/radix8sort int32_t")
+{
+    bits::test_radixsort(radix8sort_i32);
+    bits::test_radixsort_sizes(radix8sort_i32);
+    bits::test_radixsort_skip_passes(radix8sort_i32);
+    bits::test_radixsort_narrow_range(radix8sort_i32, -2048);
+    bits::test_radixsort_presorted(radix8sort_i32);
+}
+
+TEST_CASE("c/radix8sort int64_t")
+{
+    bits::test_radixsort(radix8sort_i64);
+    bits::test_radixsort_sizes(radix8sort_i64);
+    bits::test_radixsort_skip_passes(radix8sort_i64);
+    bits::test_radixsort_narrow_range(radix8sort_i64, INT64_C(-2048));
+    bits::test_radixsort_presorted(radix8sort_i64);
+}
+
+TEST_CASE("c/radix11sort int32_t")
+{
+    bits::test_radixsort(radix11sort_i32);
+    bits::test_radixsort_sizes(radix11sort_i32);
+    bits::test_radixsort_skip_passes(radix11sort_i32);
+    bits::test_radixsort_narrow_range(radix11sort_i32, -2048);
+    bits::test_radixsort_presorted(radix11sort_i32);
+}
+
+TEST_CASE("c/radix11sort int64_t")
+{
+    bits::test_radixsort(radix11sort_i64);
+    bits::test_radixsort_sizes(radix11sort_i64);
+    bits::test_radixsort_skip_passes(radix11sort_i64);
+    bits::test_radixsort_narrow_range(radix11sort_i64, INT64_C(-2048));
+    bits::test_radixsort_presorted(radix11sort_i64);
+}
+
+TEST_CASE("c/radix8sort_desc uint32_t")
+{
+    bits::test_radixsort_descending(radix8sort_desc_u32);
+}
+
+TEST_CASE("c/radix8sort_desc uint64_t")
+{
+    bits::test_radixsort_descending(radix8sort_desc_u64);
+}
+
+TEST_CASE("c/radix8sort_desc float")
+{
+    bits::test_radixsort_descending(radix8sort_desc_f32);
+}
+
+TEST_CASE("c/radix8sort_desc double")
+{
+    bits::test_radixsort_descending(radix8sort_desc_f64);
+}
+
+TEST_CASE("c/radix8sort_desc int32_t")
+{
+    bits::test_radixsort_descending(radix8sort_desc_i32);
+}
+
+TEST_CASE("c/radix8sort_desc int64_t")
+{
+    bits::test_radixsort_descending(radix8sort_desc_i64);
+}
+
+TEST_CASE("c/radix11sort_desc uint32_t")
+{
+    bits::test_radixsort_descending(radix11sort_desc_u32);
+}
+
+TEST_CASE("c/radix11sort_desc uint64_t")
+{
+    bits::test_radixsort_descending(radix11sort_desc_u64);
+}
+
+TEST_CASE("c/radix11sort_desc float")
+{
+    bits::test_radixsort_descending(radix11sort_desc_f32);
+}
+
+TEST_CASE("c/radix11sort_desc double")
+{
+    bits::test_radixsort_descending(radix11sort_desc_f64);
+}
+
+TEST_CASE("c/radix11sort_desc int32_t")
+{
+    bits::test_radixsort_descending(radix11sort_desc_i32);
+}
+
+TEST_CASE("c/radix11sort_desc int64_t")
+{
+    bits::test_radixsort_descending(radix11sort_desc_i64);
+}
+
+TEST_CASE("c/radix8sort_keys uint32_t")
+{
+    bits::test_radixsort_keys(radix8sort_keys_u32, radix8sort_u32);
+}
+
+TEST_CASE("c/radix8sort_keys uint64_t")
+{
+    bits::test_radixsort_keys(radix8sort_keys_u64, radix8sort_u64);
+}
+
+TEST_CASE("c/radix8sort_keys float")
+{
+    bits::test_radixsort_keys(radix8sort_keys_f32, radix8sort_f32);
+}
+
+TEST_CASE("c/radix8sort_keys double")
+{
+    bits::test_radixsort_keys(radix8sort_keys_f64, radix8sort_f64);
+}
+
+TEST_CASE("c/radix8sort_keys int32_t")
+{
+    bits::test_radixsort_keys(radix8sort_keys_i32, radix8sort_i32);
+}
+
+TEST_CASE("c/radix8sort_keys int64_t")
+{
+    bits::test_radixsort_keys(radix8sort_keys_i64, radix8sort_i64);
+}
+
+TEST_CASE("c/radix11sort_keys uint32_t")
+{
+    bits::test_radixsort_keys(radix11sort_keys_u32, radix11sort_u32);
+}
+
+TEST_CASE("c/radix11sort_keys uint64_t")
+{
+    bits::test_radixsort_keys(radix11sort_keys_u64, radix11sort_u64);
+}
+
+TEST_CASE("c/radix11sort_keys float")
+{
+    bits::test_radixsort_keys(radix11sort_keys_f32, radix11sort_f32);
+}
+
+TEST_CASE("c/radix11sort_keys double")
+{
+    bits::test_radixsort_keys(radix11sort_keys_f64, radix11sort_f64);
+}
+
+TEST_CASE("c/radix11sort_keys int32_t")
+{
+    bits::test_radixsort_keys(radix11sort_keys_i32, radix11sort_i32);
+}
+
+TEST_CASE("c/radix11sort_keys int64_t")
+{
+    bits::test_radixsort_keys(radix11sort_keys_i64, radix11sort_i64);
+}
+
+TEST_CASE("c/radix8argsort uint32_t")
+{
+    bits::test_radixsort_argsort(radix8argsort_u32, radix8sort_u32);
+}
+
+TEST_CASE("c/radix8argsort uint64_t")
+{
+    bits::test_radixsort_argsort(radix8argsort_u64, radix8sort_u64);
+}
+
+TEST_CASE("c/radix8argsort float")
+{
+    bits::test_radixsort_argsort(radix8argsort_f32, radix8sort_f32);
+}
+
+TEST_CASE("c/radix8argsort double")
+{
+    bits::test_radixsort_argsort(radix8argsort_f64, radix8sort_f64);
+}
+
+TEST_CASE("c/radix8argsort int32_t")
+{
+    bits::test_radixsort_argsort(radix8argsort_i32, radix8sort_i32);
+}
+
+TEST_CASE("c/radix8argsort int64_t")
+{
+    bits::test_radixsort_argsort(radix8argsort_i64, radix8sort_i64);
+}
+
+TEST_CASE("c/radix11argsort uint32_t")
+{
+    bits::test_radixsort_argsort(radix11argsort_u32, radix11sort_u32);
+}
+
+TEST_CASE("c/radix11argsort uint64_t")
+{
+    bits::test_radixsort_argsort(radix11argsort_u64, radix11sort_u64);
+}
+
+TEST_CASE("c/radix11argsort float")
+{
+    bits::test_radixsort_argsort(radix11argsort_f32, radix11sort_f32);
+}
+
+TEST_CASE("c/radix11argsort double")
+{
+    bits::test_radixsort_argsort(radix11argsort_f64, radix11sort_f64);
+}
+
+TEST_CASE("c/radix11argsort int32_t")
+{
+    bits::test_radixsort_argsort(radix11argsort_i32, radix11sort_i32);
+}
+
+TEST_CASE("c/radix11argsort int64_t")
+{
+    bits::test_radixsort_argsort(radix11argsort_i64, radix11sort_i64);
+}
+
+TEST_CASE("c/radix8sort_values uint32_t")
+{
+    bits::test_radixsort_values(radix8sort_values64_u32, radix8sort_values_u32, radix8sort_u32);
+}
+
+TEST_CASE("c/radix8sort_values uint64_t")
+{
+    bits::test_radixsort_values(radix8sort_values64_u64, radix8sort_values_u64, radix8sort_u64);
+}
+
+TEST_CASE("c/radix8sort_values float")
+{
+    bits::test_radixsort_values(radix8sort_values64_f32, radix8sort_values_f32, radix8sort_f32);
+}
+
+TEST_CASE("c/radix8sort_values double")
+{
+    bits::test_radixsort_values(radix8sort_values64_f64, radix8sort_values_f64, radix8sort_f64);
+}
+
+TEST_CASE("c/radix8sort_values int32_t")
+{
+    bits::test_radixsort_values(radix8sort_values64_i32, radix8sort_values_i32, radix8sort_i32);
+}
+
+TEST_CASE("c/radix8sort_values int64_t")
+{
+    bits::test_radixsort_values(radix8sort_values64_i64, radix8sort_values_i64, radix8sort_i64);
+}
+
+TEST_CASE("c/radix11sort_values uint32_t")
+{
+    bits::test_radixsort_values(radix11sort_values64_u32, radix11sort_values_u32, radix11sort_u32);
+}
+
+TEST_CASE("c/radix11sort_values uint64_t")
+{
+    bits::test_radixsort_values(radix11sort_values64_u64, radix11sort_values_u64, radix11sort_u64);
+}
+
+TEST_CASE("c/radix11sort_values float")
+{
+    bits::test_radixsort_values(radix11sort_values64_f32, radix11sort_values_f32, radix11sort_f32);
+}
+
+TEST_CASE("c/radix11sort_values double")
+{
+    bits::test_radixsort_values(radix11sort_values64_f64, radix11sort_values_f64, radix11sort_f64);
+}
+
+TEST_CASE("c/radix11sort_values int32_t")
+{
+    bits::test_radixsort_values(radix11sort_values64_i32, radix11sort_values_i32, radix11sort_i32);
+}
+
+TEST_CASE("c/radix11sort_values int64_t")
+{
+    bits::test_radixsort_values(radix11sort_values64_i64, radix11sort_values_i64, radix11sort_i64);
+}
+
+TEST_CASE("c/radixsort_size64 64 bit counts")
+{
+    // sort the small test arrays with the 64 bit counts used past UINT32_MAX
+    bits::test_radixsort_size64(radix8sort_size64_counts_u32, radix8sort_values_u32, false);
+    bits::test_radixsort_size64(radix8sort_size64_counts_u64, radix8sort_values_u64, false);
+    bits::test_radixsort_size64(radix8sort_size64_counts_f32, radix8sort_values_f32, false);
+    bits::test_radixsort_size64(radix8sort_size64_counts_f64, radix8sort_values_f64, false);
+    bits::test_radixsort_size64(radix8sort_size64_counts_i32, radix8sort_values_i32, false);
+    bits::test_radixsort_size64(radix8sort_size64_counts_i64, radix8sort_values_i64, false);
+    bits::test_radixsort_size64(radix11sort_size64_counts_u32, radix11sort_values_u32, false);
+    bits::test_radixsort_size64(radix11sort_size64_counts_u64, radix11sort_values_u64, false);
+    bits::test_radixsort_size64(radix11sort_size64_counts_f32, radix11sort_values_f32, false);
+    bits::test_radixsort_size64(radix11sort_size64_counts_f64, radix11sort_values_f64, false);
+    bits::test_radixsort_size64(radix11sort_size64_counts_i32, radix11sort_values_i32, false);
+    bits::test_radixsort_size64(radix11sort_size64_counts_i64, radix11sort_values_i64, false);
+}
+
+TEST_CASE("c/radix8sort_size64 uint32_t")
+{
+    bits::test_radixsort_size64(radix8sort_size64_u32, radix8sort_values_u32);
+}
+
+TEST_CASE("c/radix8sort_size64 uint64_t")
+{
+    bits::test_radixsort_size64(radix8sort_size64_u64, radix8sort_values_u64);
+}
+
+TEST_CASE("c/radix8sort_size64 float")
+{
+    bits::test_radixsort_size64(radix8sort_size64_f32, radix8sort_values_f32);
+}
+
+TEST_CASE("c/radix8sort_size64 double")
+{
+    bits::test_radixsort_size64(radix8sort_size64_f64, radix8sort_values_f64);
+}
+
+TEST_CASE("c/radix8sort_size64 int32_t")
+{
+    bits::test_radixsort_size64(radix8sort_size64_i32, radix8sort_values_i32);
+}
+
+TEST_CASE("c/radix8sort_size64 int64_t")
+{
+    bits::test_radixsort_size64(radix8sort_size64_i64, radix8sort_values_i64);
+}
+
+TEST_CASE("c/radix11sort_size64 uint32_t")
+{
+    bits::test_radixsort_size64(radix11sort_size64_u32, radix11sort_values_u32);
+}
+
+TEST_CASE("c/radix11sort_size64 uint64_t")
+{
+    bits::test_radixsort_size64(radix11sort_size64_u64, radix11sort_values_u64);
+}
+
+TEST_CASE("c/radix11sort_size64 float")
+{
+    bits::test_radixsort_size64(radix11sort_size64_f32, radix11sort_values_f32);
+}
+
+TEST_CASE("c/radix11sort_size64 double")
+{
+    bits::test_radixsort_size64(radix11sort_size64_f64, radix11sort_values_f64);
+}
+
+TEST_CASE("c/radix11sort_size64 int32_t")
+{
+    bits::test_radixsort_size64(radix11sort_size64_i32, radix11sort_values_i32);
+}
+
+TEST_CASE("c/radix11sort_size64 int64_t")
+{
+    bits::test_radixsort_size64(radix11sort_size64_i64, radix11sort_values_i64);
+}
+
+TEST_CASE("c/counting_sort uint8_t")
+{
+    bits::test_radixsort(counting_sort_u8);
+    bits::test_radixsort_sizes(counting_sort_u8);
+    bits::test_radixsort_skip_passes(counting_sort_u8);
+    bits::test_radixsort_presorted(counting_sort_u8);
+    bits::test_radixsort_large(counting_sort_u8, (1 << 16) + 3);
+}
+
+TEST_CASE("c/counting_sort int8_t")
+{
+    bits::test_radixsort(counting_sort_i8);
+    bits::test_radixsort_sizes(counting_sort_i8);
+    bits::test_radixsort_skip_passes(counting_sort_i8);
+    bits::test_radixsort_presorted(counting_sort_i8);
+    bits::test_radixsort_large(counting_sort_i8, (1 << 16) + 3);
+}
+
+TEST_CASE("c/counting_sort uint16_t")
+{
+    bits::test_radixsort(counting_sort_u16);
+    bits::test_radixsort_sizes(counting_sort_u16);
+    bits::test_radixsort_skip_passes(counting_sort_u16);
+    bits::test_radixsort_narrow_range(counting_sort_u16, uint16_t(0x7c00));
+    bits::test_radixsort_presorted(counting_sort_u16);
+    bits::test_radixsort_large(counting_sort_u16, (1 << 16) + 3);
+}
+
+TEST_CASE("c/counting_sort int16_t")
+{
+    bits::test_radixsort(counting_sort_i16);
+    bits::test_radixsort_sizes(counting_sort_i16);
+    bits::test_radixsort_skip_passes(counting_sort_i16);
+    bits::test_radixsort_narrow_range(counting_sort_i16, int16_t(-2048));
+    bits::test_radixsort_presorted(counting_sort_i16);
+    bits::test_radixsort_large(counting_sort_i16, (1 << 16) + 3);
+}
+
+TEST_CASE("c/counting_sort half float")
+{
+    bits::test_radixsort_half(counting_sort_f16, bits::half_to_float);
+    bits::test_radixsort_special(counting_sort_f16, uint16_t(0x7c00));
+}
+
+TEST_CASE("c/counting_sort bfloat16")
+{
+    bits::test_radixsort_half(counting_sort_bf16, bits::bfloat16_to_float);
+    bits::test_radixsort_special(counting_sort_bf16, uint16_t(0x7f80));
+}
+
+TEST_CASE("c/radix8sort float special values")
+{
+    bits::test_radixsort_special<float, uint32_t>(radix8sort_f32);
+}
+
+TEST_CASE("c/radix11sort float special values")
+{
+    bits::test_radixsort_special<float, uint32_t>(radix11sort_f32);
+}
+
+TEST_CASE("c/radix8sort double special values")
+{
+    bits::test_radixsort_special<double, uint64_t>(radix8sort_f64);
+}
+
+TEST_CASE("c/radix11sort double special values")
+{
+    bits::test_radixsort_special<double, uint64_t>(radix11sort_f64);
+}
+
+TEST_CASE("c/radixsort_msd uint64_t")
+{
+    bits::test_radixsort(radixsort_msd_u64);
+    bits::test_radixsort_sizes(radixsort_msd_u64);
+    bits::test_radixsort_large(radixsort_msd_u64);
+}
+
+TEST_CASE("c/radixsort_inplace uint32_t")
+{
+    bits::test_radixsort_inplace(radixsort_inplace_u32);
+}
+
+TEST_CASE("c/radixsort_inplace uint64_t")
+{
+    bits::test_radixsort_inplace(radixsort_inplace_u64);
+}
+
+TEST_CASE("c/radixsort_inplace float")
+{
+    bits::test_radixsort_inplace(radixsort_inplace_f32);
+}
+
+TEST_CASE("c/radix8sort_parallel uint32_t")
+{
+    bits::test_radixsort_parallel(radix8sort_parallel_u32, radix8sort_u32);
+}
+
+TEST_CASE("c/radix8sort_parallel uint64_t")
+{
+    bits::test_radixsort_parallel(radix8sort_parallel_u64, radix8sort_u64);
+}
+
+TEST_CASE("c/radix8sort_parallel float")
+{
+    bits::test_radixsort_parallel(radix8sort_parallel_f32, radix8sort_f32);
+}
+
+TEST_CASE("c/radix11sort_parallel uint32_t")
+{
+    bits::test_radixsort_parallel(radix11sort_parallel_u32, radix11sort_u32);
+}
+
+TEST_CASE("c/radix11sort_parallel uint64_t")
+{
+    bits::test_radixsort_parallel(radix11sort_parallel_u64, radix11sort_u64);
+}
+
+TEST_CASE("c/radix11sort_parallel float")
+{
+    bits::test_radixsort_parallel(radix11sort_parallel_f32, radix11sort_f32);
+}
+
+TEST_CASE("c/radixsort buffered scatter")
+{
+    test_radixsort_scatter(RADIXSORT_SCATTER_BUFFERED);
+}
+
+TEST_CASE("c/radixsort streaming scatter")
+{
+    test_radixsort_scatter(RADIXSORT_SCATTER_STREAMING);
+}
+
+TEST_CASE("c/radixsort block scatter")
+{
+    test_radixsort_scatter(RADIXSORT_SCATTER_BLOCK);
+}
+
+TEST_CASE("c/radixsort isa")
+{
+    const radixsort_isa supported = radixsort_get_isa();
+    REQUIRE(supported != RADIXSORT_ISA_AUTO);
+    REQUIRE(radixsort_set_isa(RADIXSORT_ISA_AVX512) == supported);
+    REQUIRE(radixsort_set_isa(RADIXSORT_ISA_AUTO) == supported);
+    test_radixsort_isa(RADIXSORT_ISA_BASELINE);
+    test_radixsort_isa(RADIXSORT_ISA_AVX2);
+    test_radixsort_isa(RADIXSORT_ISA_AVX512);
+    REQUIRE(radixsort_get_isa() == supported);
+}
+
+TEST_CASE("c/radixsort_apply_permutation")
+{
+    bits::test_apply_permutation(radixsort_apply_permutation);
+}
@@ -21,6 +21,12 @@ uint32_t radix8sort_f32(float*  keys_in_out, float*  keys_temp,
     return bits::radix8sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
 }
 
+uint32_t radix8sort_f64(double* keys_in_out, double* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix8sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
 uint32_t radix11sort_u32(uint32_t*  keys_in, uint32_t*  keys_out,
     uint32_t*  values_in, uint32_t*  values_out, uint32_t size)
 {
@@ -39,32 +45,1435 @@ uint32_t radix11sort_f32(float*  keys_in, float*  keys_out,
     return bits::radix11sort(keys_in, keys_out, values_in, values_out, size);
 }
 
-TEST_CASE("cpp/radix8sort uint32_t")
+uint32_t radix11sort_f64(double* keys_in, double* keys_out,
+    uint32_t* values_in, uint32_t* values_out, uint32_t size)
 {
-    bits::test_radixsort(radix8sort_u32);
+    return bits::radix11sort(keys_in, keys_out, values_in, values_out, size);
 }
 
-TEST_CASE("cpp/radix8sort uint64_t")
+uint32_t radix8sort_i32(int32_t* keys_in_out, int32_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
 {
-    bits::test_radixsort(radix8sort_u64);
+    return bits::radix8sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
 }
 
-TEST_CASE("cpp/radix8sort float")
+uint32_t radix8sort_i64(int64_t* keys_in_out, int64_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
 {
-    bits::test_radixsort(radix8sort_f32);
+    return bits::radix8sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
 }
 
-TEST_CASE("cpp/radix11sort uint32_t")
+uint32_t radix11sort_i32(int32_t* keys_in_out, int32_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
 {
-    bits::test_radixsort(radix11sort_u32);
+    return bits::radix11sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
 }
 
-TEST_CASE("cpp/radix11sort uint64_t")
+uint32_t radix11sort_i64(int64_t* keys_in_out, int64_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
 {
-    bits::test_radixsort(radix11sort_u64);
+    return bits::radix11sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
 }
 
-TEST_CASE("cpp/radix11sort float")
+uint32_t radix8sort_keys_u32(uint32_t* keys_in_out, uint32_t* keys_temp, uint32_t size)
 {
-    bits::test_radixsort(radix11sort_f32);
+    return bits::radix8sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix8sort_keys_u64(uint64_t* keys_in_out, uint64_t* keys_temp, uint32_t size)
+{
+    return bits::radix8sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix8sort_keys_f32(float* keys_in_out, float* keys_temp, uint32_t size)
+{
+    return bits::radix8sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix8sort_keys_f64(double* keys_in_out, double* keys_temp, uint32_t size)
+{
+    return bits::radix8sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix8sort_keys_i32(int32_t* keys_in_out, int32_t* keys_temp, uint32_t size)
+{
+    return bits::radix8sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix8sort_keys_i64(int64_t* keys_in_out, int64_t* keys_temp, uint32_t size)
+{
+    return bits::radix8sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix11sort_keys_u32(uint32_t* keys_in_out, uint32_t* keys_temp, uint32_t size)
+{
+    return bits::radix11sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix11sort_keys_u64(uint64_t* keys_in_out, uint64_t* keys_temp, uint32_t size)
+{
+    return bits::radix11sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix11sort_keys_f32(float* keys_in_out, float* keys_temp, uint32_t size)
+{
+    return bits::radix11sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix11sort_keys_f64(double* keys_in_out, double* keys_temp, uint32_t size)
+{
+    return bits::radix11sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix11sort_keys_i32(int32_t* keys_in_out, int32_t* keys_temp, uint32_t size)
+{
+    return bits::radix11sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix11sort_keys_i64(int64_t* keys_in_out, int64_t* keys_temp, uint32_t size)
+{
+    return bits::radix11sort(keys_in_out, keys_temp, size);
+}
+
+uint32_t radix8argsort_u32(uint32_t* keys_in_out, uint32_t* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix8argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix8argsort_u64(uint64_t* keys_in_out, uint64_t* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix8argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix8argsort_f32(float* keys_in_out, float* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix8argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix8argsort_f64(double* keys_in_out, double* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix8argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix8argsort_i32(int32_t* keys_in_out, int32_t* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix8argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix8argsort_i64(int64_t* keys_in_out, int64_t* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix8argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix11argsort_u32(uint32_t* keys_in_out, uint32_t* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix11argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix11argsort_u64(uint64_t* keys_in_out, uint64_t* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix11argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix11argsort_f32(float* keys_in_out, float* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix11argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix11argsort_f64(double* keys_in_out, double* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix11argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix11argsort_i32(int32_t* keys_in_out, int32_t* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix11argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix11argsort_i64(int64_t* keys_in_out, int64_t* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix11argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys);
+}
+
+uint32_t radix8sort_desc_u32(uint32_t* keys_in_out, uint32_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix8sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radix8sort_desc_u64(uint64_t* keys_in_out, uint64_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix8sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radix8sort_desc_f32(float* keys_in_out, float* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix8sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radix8sort_desc_f64(double* keys_in_out, double* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix8sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radix8sort_desc_i32(int32_t* keys_in_out, int32_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix8sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radix8sort_desc_i64(int64_t* keys_in_out, int64_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix8sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radix11sort_desc_u32(uint32_t* keys_in_out, uint32_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix11sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radix11sort_desc_u64(uint64_t* keys_in_out, uint64_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix11sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radix11sort_desc_f32(float* keys_in_out, float* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix11sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radix11sort_desc_f64(double* keys_in_out, double* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix11sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radix11sort_desc_i32(int32_t* keys_in_out, int32_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix11sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radix11sort_desc_i64(int64_t* keys_in_out, int64_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix11sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t counting_sort_u8(uint8_t* keys_in_out, uint8_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::counting_sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t counting_sort_i8(int8_t* keys_in_out, int8_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::counting_sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t counting_sort_u16(uint16_t* keys_in_out, uint16_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::counting_sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t counting_sort_i16(int16_t* keys_in_out, int16_t* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::counting_sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t counting_sort_f16(bits::Float16* keys_in_out, bits::Float16* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::counting_sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t counting_sort_bf16(bits::BFloat16* keys_in_out, bits::BFloat16* keys_temp,
+    uint32_t* values_in_out, uint32_t* values_temp, uint32_t size)
+{
+    return bits::counting_sort(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+uint32_t radixsort_msd_u64(uint64_t*  keys_in, uint64_t*  keys_out,
+    uint32_t*  values_in, uint32_t*  values_out, uint32_t size)
+{
+    return bits::radix_sort_msd(keys_in, keys_out, values_in, values_out, size);
+}
+
+uint32_t radix8sort_parallel_u32(uint32_t* keys_in_out, uint32_t* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size, uint32_t num_threads)
+{
+    return bits::radix8sort_parallel(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+uint32_t radix8sort_parallel_u64(uint64_t* keys_in_out, uint64_t* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size, uint32_t num_threads)
+{
+    return bits::radix8sort_parallel(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+uint32_t radix8sort_parallel_f32(float* keys_in_out, float* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size, uint32_t num_threads)
+{
+    return bits::radix8sort_parallel(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+uint32_t radix11sort_parallel_u32(uint32_t* keys_in_out, uint32_t* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size, uint32_t num_threads)
+{
+    return bits::radix11sort_parallel(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+uint32_t radix11sort_parallel_u64(uint64_t* keys_in_out, uint64_t* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size, uint32_t num_threads)
+{
+    return bits::radix11sort_parallel(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+uint32_t radix11sort_parallel_f32(float* keys_in_out, float* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size, uint32_t num_threads)
+{
+    return bits::radix11sort_parallel(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads);
+}
+
+void radixsort_inplace_u32(uint32_t* keys_in_out, uint32_t* values_in_out, uint32_t size)
+{
+    bits::radix_sort_inplace(keys_in_out, values_in_out, size);
+}
+
+void radixsort_inplace_u64(uint64_t* keys_in_out, uint32_t* values_in_out, uint32_t size)
+{
+    bits::radix_sort_inplace(keys_in_out, values_in_out, size);
+}
+
+void radixsort_inplace_f32(float* keys_in_out, uint32_t* values_in_out, uint32_t size)
+{
+    bits::radix_sort_inplace(keys_in_out, values_in_out, size);
+}
+
+uint32_t radixsort_msd_parallel_u64(uint64_t* keys_in, uint64_t* keys_out, uint32_t* values_in,
+    uint32_t* values_out, uint32_t size)
+{
+    return bits::radix_sort_msd_parallel(keys_in, keys_out, values_in, values_out, size, 4);
+}
+
+void radixsort_inplace_parallel_u32(uint32_t* keys_in_out, uint32_t* values_in_out, uint32_t size)
+{
+    bits::radix_sort_inplace_parallel(keys_in_out, values_in_out, size, 4);
+}
+
+void radixsort_inplace_parallel_u64(uint64_t* keys_in_out, uint32_t* values_in_out, uint32_t size)
+{
+    bits::radix_sort_inplace_parallel(keys_in_out, values_in_out, size, 4);
+}
+
+void radixsort_inplace_parallel_f32(float* keys_in_out, uint32_t* values_in_out, uint32_t size)
+{
+    bits::radix_sort_inplace_parallel(keys_in_out, values_in_out, size, 4);
+}
+
+template <bits::ScatterMode kScatterMode, typename KeyType>
+uint32_t radix8sort_scatter(KeyType* keys_in_out, KeyType* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix8sort(keys_in_out, keys_temp, values_in_out, values_temp, size, kScatterMode);
+}
+
+template <bits::ScatterMode kScatterMode, typename KeyType>
+uint32_t radix11sort_scatter(KeyType* keys_in_out, KeyType* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix11sort(keys_in_out, keys_temp, values_in_out, values_temp, size, kScatterMode);
+}
+
+template <bits::ScatterMode kScatterMode, typename KeyType>
+uint32_t radix11sort_keys_scatter(KeyType* keys_in_out, KeyType* keys_temp, uint32_t size)
+{
+    return bits::radix11sort(keys_in_out, keys_temp, size, kScatterMode);
+}
+
+template <bits::ScatterMode kScatterMode, typename KeyType>
+uint32_t radix11argsort_scatter(KeyType* keys_in_out, KeyType* keys_temp, uint32_t* indices_out,
+    uint32_t* indices_temp, uint32_t size, bool sort_keys)
+{
+    return bits::radix11argsort(keys_in_out, keys_temp, indices_out, indices_temp, size, sort_keys, kScatterMode);
+}
+
+template <bits::ScatterMode kScatterMode, typename KeyType>
+uint32_t radix11sort_desc_scatter(KeyType* keys_in_out, KeyType* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix11sort_desc(keys_in_out, keys_temp, values_in_out, values_temp, size, kScatterMode);
+}
+
+template <bits::ScatterMode kScatterMode, typename KeyType>
+uint32_t radix11sort_parallel_scatter(KeyType* keys_in_out, KeyType* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size, uint32_t num_threads)
+{
+    return bits::radix11sort_parallel(keys_in_out, keys_temp, values_in_out, values_temp, size, num_threads,
+        kScatterMode);
+}
+
+template <typename KeyType>
+uint32_t radix8sort_size64(KeyType* keys_in_out, KeyType* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix8sort_size64(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+template <typename KeyType>
+uint32_t radix11sort_size64(KeyType* keys_in_out, KeyType* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size)
+{
+    return bits::radix11sort_size64(keys_in_out, keys_temp, values_in_out, values_temp, size);
+}
+
+template <typename KeyType>
+uint32_t radix8sort_keys_size64(KeyType* keys_in_out, KeyType* keys_temp, uint32_t size)
+{
+    return bits::radix8sort_size64(keys_in_out, keys_temp, size);
+}
+
+template <typename KeyType>
+uint32_t radix11sort_keys_size64(KeyType* keys_in_out, KeyType* keys_temp, uint32_t size)
+{
+    return bits::radix11sort_size64(keys_in_out, keys_temp, size);
+}
+
+/**
+ * Sort with 64 bit histogram counts, which the size64 sorts only use for
+ * arrays of more than UINT32_MAX keys.
+ */
+template <bits::ScatterMode kScatterMode, typename KeyType, typename SortKeyType, typename DecodeOp,
+    typename EncodeOp>
+uint32_t radix11sort_counts64(KeyType* keys_in_out, KeyType* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size)
+{
+    bits::detail::RadixSort<11, SortKeyType, uint32_t, DecodeOp, EncodeOp, uint64_t> sort(kScatterMode);
+    return sort(reinterpret_cast<SortKeyType*>(keys_in_out), reinterpret_cast<SortKeyType*>(keys_temp),
+        values_in_out, values_temp, uint64_t(size));
+}
+
+/**
+ * Sort with 64 bit histogram counts and the given scatter, which must give the
+ * same results as the sorts with 32 bit counts.
+ */
+template <bits::ScatterMode kScatterMode>
+void test_radixsort_counts64()
+{
+    using bits::detail::PassThrough;
+    bits::test_radixsort_sizes(radix11sort_counts64<kScatterMode, uint32_t, uint32_t, PassThrough, PassThrough>);
+    bits::test_radixsort_large(radix11sort_counts64<kScatterMode, uint32_t, uint32_t, PassThrough, PassThrough>,
+        (1 << 16) + 3);
+    bits::test_radixsort_presorted(radix11sort_counts64<kScatterMode, uint64_t, uint64_t, PassThrough, PassThrough>);
+    bits::test_radixsort_narrow_range(
+        radix11sort_counts64<kScatterMode, uint64_t, uint64_t, PassThrough, PassThrough>, UINT64_C(0x0123456789fffc00));
+    bits::test_radixsort_large(radix11sort_counts64<kScatterMode, uint64_t, uint64_t, PassThrough, PassThrough>,
+        (1 << 16) + 3);
+    bits::test_radixsort_large(
+        radix11sort_counts64<kScatterMode, float, uint32_t, bits::detail::FloatFlip, bits::detail::InvFloatFlip>,
+        (1 << 16) + 3);
+    bits::test_radixsort_large(
+        radix11sort_counts64<kScatterMode, int64_t, uint64_t, bits::detail::SignFlip, bits::detail::SignFlip>,
+        (1 << 16) + 3);
+}
+
+/**
+ * Sort with the buffered, streaming and block scatters, which must give the
+ * same results as writing directly.
+ */
+template <bits::ScatterMode kScatterMode, typename KeyType>
+void test_radixsort_scatter()
+{
+    bits::test_radixsort_sizes(radix8sort_scatter<kScatterMode, KeyType>);
+    bits::test_radixsort_large(radix8sort_scatter<kScatterMode, KeyType>, (1 << 16) + 3);
+    bits::test_radixsort_sizes(radix11sort_scatter<kScatterMode, KeyType>);
+    bits::test_radixsort_large(radix11sort_scatter<kScatterMode, KeyType>, (1 << 16) + 3);
+    bits::test_radixsort_descending(radix11sort_desc_scatter<kScatterMode, KeyType>);
+    bits::test_radixsort_keys(radix11sort_keys_scatter<kScatterMode, KeyType>,
+        radix11sort_scatter<bits::kScatterDirect, KeyType>);
+    bits::test_radixsort_argsort(radix11argsort_scatter<kScatterMode, KeyType>,
+        radix11sort_scatter<bits::kScatterDirect, KeyType>);
+    bits::test_radixsort_parallel(radix11sort_parallel_scatter<kScatterMode, KeyType>,
+        radix11sort_scatter<bits::kScatterDirect, KeyType>);
+}
+
+struct LargeValue
+{
+    uint32_t index;
+    uint8_t bytes[252];
+};
+
+/**
+ * Sort keys with values too large to stage in the buffers of the other
+ * scatter modes, at a size where the automatic mode picks streaming.
+ */
+template <bits::ScatterMode kScatterMode>
+void test_radixsort_large_values(uint32_t num_threads = 0)
+{
+    const uint32_t size = 100000;
+    std::mt19937 rng;
+    std::vector<uint32_t> keys_in(size);
+    std::vector<uint32_t> indices(size);
+    std::vector<uint32_t> keys_copy(size);
+    bits::rand_keys(rng, keys_in.data(), indices.data(), keys_copy.data(), size);
+
+    std::vector<uint32_t> keys[2] = {keys_in, std::vector<uint32_t>(size)};
+    std::vector<LargeValue> values[2] = {std::vector<LargeValue>(size), std::vector<LargeValue>(size)};
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        values[0][i].index = i;
+        std::memset(values[0][i].bytes, static_cast<int>(i), sizeof(values[0][i].bytes));
+    }
+    const uint32_t out = num_threads == 0
+        ? bits::radix11sort(keys[0].data(), keys[1].data(), values[0].data(), values[1].data(), size, kScatterMode)
+        : bits::radix11sort_parallel(keys[0].data(), keys[1].data(), values[0].data(), values[1].data(), size,
+              num_threads, kScatterMode);
+    REQUIRE(out < 2);
+
+    std::stable_sort(indices.begin(), indices.end(), [&keys_in](uint32_t a, uint32_t b) {
+        return keys_in[a] < keys_in[b];
+    });
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const LargeValue& value = values[out][i];
+        REQUIRE(keys[out][i] == keys_in[indices[i]]);
+        REQUIRE(value.index == indices[i]);
+        REQUIRE(value.bytes[0] == static_cast<uint8_t>(indices[i]));
+        REQUIRE(value.bytes[sizeof(value.bytes) - 1] == static_cast<uint8_t>(indices[i]));
+    }
+}
+
+template <typename DigitPlan, typename KeyType>
+uint32_t radix_sort_plan(KeyType* keys_in_out, KeyType* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size)
+{
+    const uint32_t out = bits::radix_sort<DigitPlan>(keys_in_out, keys_temp, values_in_out, values_temp, size);
+    if (DigitPlan::kNumDigits % 2 == 0)
+    {
+        REQUIRE(out == 0);
+    }
+    return out;
+}
+
+/**
+ * Sort with the given digit plan, plans with an even number of digits always
+ * leaving the result in the in_out buffers.
+ */
+template <typename DigitPlan, typename KeyType>
+void test_radixsort_plan(KeyType narrow_base)
+{
+    bits::test_radixsort(radix_sort_plan<DigitPlan, KeyType>);
+    bits::test_radixsort_sizes(radix_sort_plan<DigitPlan, KeyType>);
+    bits::test_radixsort_skip_passes(radix_sort_plan<DigitPlan, KeyType>);
+    bits::test_radixsort_narrow_range(radix_sort_plan<DigitPlan, KeyType>, narrow_base);
+    bits::test_radixsort_presorted(radix_sort_plan<DigitPlan, KeyType>);
+    bits::test_radixsort_large(radix_sort_plan<DigitPlan, KeyType>, (1 << 16) + 3);
+}
+
+/**
+ * A record with its key between other members, for sorting by a projection.
+ */
+template <typename KeyType>
+struct Record
+{
+    uint32_t value;
+    KeyType key;
+    uint32_t check[3];
+};
+
+/**
+ * Sort keys and values as records with radix_sort and a key projection, and
+ * copy them out of the buffer holding the sorted records, checking the rest
+ * of each record moved with its key.
+ */
+template <typename KeyType>
+uint32_t radix_sort_records(KeyType* keys_in_out, KeyType* keys_temp, uint32_t* values_in_out,
+    uint32_t* values_temp, uint32_t size)
+{
+    std::vector<Record<KeyType>> records[2] = {std::vector<Record<KeyType>>(size),
+        std::vector<Record<KeyType>>(size)};
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        records[0][i].value = values_in_out[i];
+        records[0][i].key = keys_in_out[i];
+        records[0][i].check[0] = values_in_out[i] * 3;
+        records[0][i].check[1] = ~values_in_out[i];
+        records[0][i].check[2] = values_in_out[i] ^ 0x5a5a5a5a;
+    }
+
+    const uint32_t out = bits::radix_sort(records[0].data(), records[1].data(), size,
+        [](const Record<KeyType>& record) { return record.key; });
+
+    KeyType* keys[2] = {keys_in_out, keys_temp};
+    uint32_t* values[2] = {values_in_out, values_temp};
+    bool moved_whole = true;
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const Record<KeyType>& record = records[out][i];
+        keys[out][i] = record.key;
+        values[out][i] = record.value;
+        moved_whole &= record.check[0] == record.value * 3 && record.check[1] == ~record.value &&
+            record.check[2] == (record.value ^ 0x5a5a5a5a);
+    }
+    REQUIRE(moved_whole);
+    return out;
+}
+
+/**
+ * Sort records by their keys through the tests of keys and values.
+ */
+template <typename KeyType>
+void test_radixsort_records(KeyType narrow_base)
+{
+    bits::test_radixsort(radix_sort_records<KeyType>);
+    bits::test_radixsort_sizes(radix_sort_records<KeyType>);
+    bits::test_radixsort_skip_passes(radix_sort_records<KeyType>);
+    bits::test_radixsort_narrow_range(radix_sort_records<KeyType>, narrow_base);
+    bits::test_radixsort_presorted(radix_sort_records<KeyType>);
+    bits::test_radixsort_large(radix_sort_records<KeyType>, (1 << 16) + 3);
+}
+
+void apply_permutation(const uint32_t* indices, uint32_t size, const bits::PermutationColumn* columns,
+    uint32_t num_columns, uint32_t num_threads)
+{
+    bits::apply_permutation(indices, size, columns, num_columns, num_threads);
+}
+
+TEST_CASE("cpp/radix8sort uint32_t")
+{
+    bits::test_radixsort(radix8sort_u32);
+}
+
+TEST_CASE("cpp/radix8sort uint64_t")
+{
+    bits::test_radixsort(radix8sort_u64);
+}
+
+TEST_CASE("cpp/radix8sort float")
+{
+    bits::test_radixsort(radix8sort_f32);
+}
+
+TEST_CASE("cpp/radix8sort double")
+{
+    bits::test_radixsort(radix8sort_f64);
+}
+
+TEST_CASE("cpp/radix11sort uint32_t")
+{
+    bits::test_radixsort(radix11sort_u32);
+}
+
+TEST_CASE("cpp/radix11sort uint64_t")
+{
+    bits::test_radixsort(radix11sort_u64);
+}
+
+TEST_CASE("cpp/radix11sort float")
+{
+    bits::test_radixsort(radix11sort_f32);
+}
+
+TEST_CASE("cpp/radix11sort double")
+{
+    bits::test_radixsort(radix11sort_f64);
+}
+
+TEST_CASE("cpp/radix8sort uint32_t skip passes")
+{
+    bits::test_radixsort_skip_passes(radix8sort_u32);
+}
+
+TEST_CASE("cpp/radix8sort uint64_t skip passes")
+{
+    bits::test_radixsort_skip_passes(radix8sort_u64);
+}
+
+TEST_CASE("cpp/radix8sort float skip passes")
+{
+    bits::test_radixsort_skip_passes(radix8sort_f32);
+}
+
+TEST_CASE("cpp/radix8sort double skip passes")
+{
+    bits::test_radixsort_skip_passes(radix8sort_f64);
+}
+
+TEST_CASE("cpp/radix11sort uint32_t skip passes")
+{
+    bits::test_radixsort_skip_passes(radix11sort_u32);
+}
+
+TEST_CASE("cpp/radix11sort uint64_t skip passes")
+{
+    bits::test_radixsort_skip_passes(radix11sort_u64);
+}
+
+TEST_CASE("cpp/radix11sort float skip passes")
+{
+    bits::test_radixsort_skip_passes(radix11sort_f32);
+}
+
+TEST_CASE("cpp/radix11sort double skip passes")
+{
+    bits::test_radixsort_skip_passes(radix11sort_f64);
+}
+
+TEST_CASE("cpp/radix8sort uint32_t narrow range")
+{
+    bits::test_radixsort_narrow_range(radix8sort_u32, 0x00fffc00u);
+}
+
+TEST_CASE("cpp/radix8sort uint64_t narrow range")
+{
+    bits::test_radixsort_narrow_range(radix8sort_u64, UINT64_C(0x0123456789fffc00));
+}
+
+TEST_CASE("cpp/radix8sort float narrow range")
+{
+    bits::test_radixsort_narrow_range(radix8sort_f32, 1000000.0f);
+}
+
+TEST_CASE("cpp/radix8sort double narrow range")
+{
+    bits::test_radixsort_narrow_range(radix8sort_f64, 1000000.0);
+}
+
+TEST_CASE("cpp/radix11sort uint32_t narrow range")
+{
+    bits::test_radixsort_narrow_range(radix11sort_u32, 0x00fffc00u);
+}
+
+TEST_CASE("cpp/radix11sort uint64_t narrow range")
+{
+    bits::test_radixsort_narrow_range(radix11sort_u64, UINT64_C(0x0123456789fffc00));
+}
+
+TEST_CASE("cpp/radix11sort float narrow range")
+{
+    bits::test_radixsort_narrow_range(radix11sort_f32, 1000000.0f);
+}
+
+TEST_CASE("cpp/radix11sort double narrow range")
+{
+    bits::test_radixsort_narrow_range(radix11sort_f64, 1000000.0);
+}
+
+TEST_CASE("cpp/radix8sort uint32_t sizes")
+{
+    bits::test_radixsort_sizes(radix8sort_u32);
+}
+
+TEST_CASE("cpp/radix8sort uint64_t sizes")
+{
+    bits::test_radixsort_sizes(radix8sort_u64);
+}
+
+TEST_CASE("cpp/radix8sort float sizes")
+{
+    bits::test_radixsort_sizes(radix8sort_f32);
+}
+
+TEST_CASE("cpp/radix8sort double sizes")
+{
+    bits::test_radixsort_sizes(radix8sort_f64);
+}
+
+TEST_CASE("cpp/radix11sort uint32_t sizes")
+{
+    bits::test_radixsort_sizes(radix11sort_u32);
+}
+
+TEST_CASE("cpp/radix11sort uint64_t sizes")
+{
+    bits::test_radixsort_sizes(radix11sort_u64);
+}
+
+TEST_CASE("cpp/radix11sort float sizes")
+{
+    bits::test_radixsort_sizes(radix11sort_f32);
+}
+
+TEST_CASE("cpp/radix11sort double sizes")
+{
+    bits::test_radixsort_sizes(radix11sort_f64);
+}
+
+TEST_CASE("cpp/radix8sort uint32_t presorted")
+{
+    bits::test_radixsort_presorted(radix8sort_u32);
+}
+
+TEST_CASE("cpp/radix8sort uint64_t presorted")
+{
+    bits::test_radixsort_presorted(radix8sort_u64);
+}
+
+TEST_CASE("cpp/radix8sort float presorted")
+{
+    bits::test_radixsort_presorted(radix8sort_f32);
+}
+
+TEST_CASE("cpp/radix8sort double presorted")
+{
+    bits::test_radixsort_presorted(radix8sort_f64);
+}
+
+TEST_CASE("cpp/radix11sort uint32_t presorted")
+{
+    bits::test_radixsort_presorted(radix11sort_u32);
+}
+
+TEST_CASE("cpp/radix11sort uint64_t presorted")
+{
+    bits::test_radixsort_presorted(radix11sort_u64);
+}
+
+TEST_CASE("cpp/radix11sort float presorted")
+{
+    bits::test_radixsort_presorted(radix11sort_f32);
+}
+
+TEST_CASE("cpp/radix11sort double presorted")
+{
+    bits::test_radixsort_presorted(radix11sort_f64);
+}
+
+TEST_CASE("cpp/radix_sort_msd uint64_t")
+{
+    bits::test_radixsort(radixsort_msd_u64);
+    bits::test_radixsort_sizes(radixsort_msd_u64);
+    bits::test_radixsort_large(radixsort_msd_u64);
+}
+
+TEST_CASE("cpp/radix_sort_msd_parallel uint64_t")
+{
+    bits::test_radixsort(radixsort_msd_parallel_u64);
+    bits::test_radixsort_sizes(radixsort_msd_parallel_u64);
+    bits::test_radixsort_large(radixsort_msd_parallel_u64);
+}
+
+TEST_CASE("cpp/radix8sort int32_t")
+{
+    bits::test_radixsort(radix8sort_i32);
+    bits::test_radixsort_sizes(radix8sort_i32);
+    bits::test_radixsort_skip_passes(radix8sort_i32);
+    bits::test_radixsort_narrow_range(radix8sort_i32, -2048);
+    bits::test_radixsort_presorted(radix8sort_i32);
+}
+
+TEST_CASE("cpp/radix8sort int64_t")
+{
+    bits::test_radixsort(radix8sort_i64);
+    bits::test_radixsort_sizes(radix8sort_i64);
+    bits::test_radixsort_skip_passes(radix8sort_i64);
+    bits::test_radixsort_narrow_range(radix8sort_i64, INT64_C(-2048));
+    bits::test_radixsort_presorted(radix8sort_i64);
+}
+
+TEST_CASE("cpp/radix11sort int32_t")
+{
+    bits::test_radixsort(radix11sort_i32);
+    bits::test_radixsort_sizes(radix11sort_i32);
+    bits::test_radixsort_skip_passes(radix11sort_i32);
+    bits::test_radixsort_narrow_range(radix11sort_i32, -2048);
+    bits::test_radixsort_presorted(radix11sort_i32);
+}
+
+TEST_CASE("cpp/radix11sort int64_t")
+{
+    bits::test_radixsort(radix11sort_i64);
+    bits::test_radixsort_sizes(radix11sort_i64);
+    bits::test_radixsort_skip_passes(radix11sort_i64);
+    bits::test_radixsort_narrow_range(radix11sort_i64, INT64_C(-2048));
+    bits::test_radixsort_presorted(radix11sort_i64);
+}
+
+TEST_CASE("cpp/radix8sort_desc uint32_t")
+{
+    bits::test_radixsort_descending(radix8sort_desc_u32);
+}
+
+TEST_CASE("cpp/radix8sort_desc uint64_t")
+{
+    bits::test_radixsort_descending(radix8sort_desc_u64);
+}
+
+TEST_CASE("cpp/radix8sort_desc float")
+{
+    bits::test_radixsort_descending(radix8sort_desc_f32);
+}
+
+TEST_CASE("cpp/radix8sort_desc double")
+{
+    bits::test_radixsort_descending(radix8sort_desc_f64);
+}
+
+TEST_CASE("cpp/radix8sort_desc int32_t")
+{
+    bits::test_radixsort_descending(radix8sort_desc_i32);
+}
+
+TEST_CASE("cpp/radix8sort_desc int64_t")
+{
+    bits::test_radixsort_descending(radix8sort_desc_i64);
+}
+
+TEST_CASE("cpp/radix11sort_desc uint32_t")
+{
+    bits::test_radixsort_descending(radix11sort_desc_u32);
+}
+
+TEST_CASE("cpp/radix11sort_desc uint64_t")
+{
+    bits::test_radixsort_descending(radix11sort_desc_u64);
+}
+
+TEST_CASE("cpp/radix11sort_desc float")
+{
+    bits::test_radixsort_descending(radix11sort_desc_f32);
+}
+
+TEST_CASE("cpp/radix11sort_desc double")
+{
+    bits::test_radixsort_descending(radix11sort_desc_f64);
+}
+
+TEST_CASE("cpp/radix11sort_desc int32_t")
+{
+    bits::test_radixsort_descending(radix11sort_desc_i32);
+}
+
+TEST_CASE("cpp/radix11sort_desc int64_t")
+{
+    bits::test_radixsort_descending(radix11sort_desc_i64);
+}
+
+TEST_CASE("cpp/radixsort extreme keys")
+{
+    bits::test_radixsort_extremes(radix8sort_u64);
+    bits::test_radixsort_extremes(radix11sort_u32);
+    bits::test_radixsort_extremes(radix11sort_u64);
+    bits::test_radixsort_extremes(radix11sort_f32);
+    bits::test_radixsort_extremes(radix11sort_f64);
+    bits::test_radixsort_extremes(radix11sort_i64);
+    bits::test_radixsort_extremes(radix8sort_desc_u64, true);
+    bits::test_radixsort_extremes(radix11sort_desc_u32, true);
+    bits::test_radixsort_extremes(radix11sort_desc_u64, true);
+    bits::test_radixsort_extremes(radix11sort_desc_f64, true);
+    bits::test_radixsort_extremes(radix11sort_desc_i64, true);
+}
+
+TEST_CASE("cpp/radix8sort keys only uint32_t")
+{
+    bits::test_radixsort_keys(radix8sort_keys_u32, radix8sort_u32);
+}
+
+TEST_CASE("cpp/radix8sort keys only uint64_t")
+{
+    bits::test_radixsort_keys(radix8sort_keys_u64, radix8sort_u64);
+}
+
+TEST_CASE("cpp/radix8sort keys only float")
+{
+    bits::test_radixsort_keys(radix8sort_keys_f32, radix8sort_f32);
+}
+
+TEST_CASE("cpp/radix8sort keys only double")
+{
+    bits::test_radixsort_keys(radix8sort_keys_f64, radix8sort_f64);
+}
+
+TEST_CASE("cpp/radix8sort keys only int32_t")
+{
+    bits::test_radixsort_keys(radix8sort_keys_i32, radix8sort_i32);
+}
+
+TEST_CASE("cpp/radix8sort keys only int64_t")
+{
+    bits::test_radixsort_keys(radix8sort_keys_i64, radix8sort_i64);
+}
+
+TEST_CASE("cpp/radix11sort keys only uint32_t")
+{
+    bits::test_radixsort_keys(radix11sort_keys_u32, radix11sort_u32);
+}
+
+TEST_CASE("cpp/radix11sort keys only uint64_t")
+{
+    bits::test_radixsort_keys(radix11sort_keys_u64, radix11sort_u64);
+}
+
+TEST_CASE("cpp/radix11sort keys only float")
+{
+    bits::test_radixsort_keys(radix11sort_keys_f32, radix11sort_f32);
+}
+
+TEST_CASE("cpp/radix11sort keys only double")
+{
+    bits::test_radixsort_keys(radix11sort_keys_f64, radix11sort_f64);
+}
+
+TEST_CASE("cpp/radix11sort keys only int32_t")
+{
+    bits::test_radixsort_keys(radix11sort_keys_i32, radix11sort_i32);
+}
+
+TEST_CASE("cpp/radix11sort keys only int64_t")
+{
+    bits::test_radixsort_keys(radix11sort_keys_i64, radix11sort_i64);
+}
+
+TEST_CASE("cpp/radix8sort_size64 uint32_t")
+{
+    bits::test_radixsort_sizes(radix8sort_size64<uint32_t>);
+    bits::test_radixsort_keys(radix8sort_keys_size64<uint32_t>, radix8sort_size64<uint32_t>);
+}
+
+TEST_CASE("cpp/radix8sort_size64 uint64_t")
+{
+    bits::test_radixsort_sizes(radix8sort_size64<uint64_t>);
+    bits::test_radixsort_keys(radix8sort_keys_size64<uint64_t>, radix8sort_size64<uint64_t>);
+}
+
+TEST_CASE("cpp/radix8sort_size64 float")
+{
+    bits::test_radixsort_sizes(radix8sort_size64<float>);
+    bits::test_radixsort_keys(radix8sort_keys_size64<float>, radix8sort_size64<float>);
+}
+
+TEST_CASE("cpp/radix8sort_size64 double")
+{
+    bits::test_radixsort_sizes(radix8sort_size64<double>);
+    bits::test_radixsort_keys(radix8sort_keys_size64<double>, radix8sort_size64<double>);
+}
+
+TEST_CASE("cpp/radix8sort_size64 int32_t")
+{
+    bits::test_radixsort_sizes(radix8sort_size64<int32_t>);
+    bits::test_radixsort_keys(radix8sort_keys_size64<int32_t>, radix8sort_size64<int32_t>);
+}
+
+TEST_CASE("cpp/radix8sort_size64 int64_t")
+{
+    bits::test_radixsort_sizes(radix8sort_size64<int64_t>);
+    bits::test_radixsort_keys(radix8sort_keys_size64<int64_t>, radix8sort_size64<int64_t>);
+}
+
+TEST_CASE("cpp/radix11sort_size64 uint32_t")
+{
+    bits::test_radixsort_sizes(radix11sort_size64<uint32_t>);
+    bits::test_radixsort_keys(radix11sort_keys_size64<uint32_t>, radix11sort_size64<uint32_t>);
+}
+
+TEST_CASE("cpp/radix11sort_size64 uint64_t")
+{
+    bits::test_radixsort_sizes(radix11sort_size64<uint64_t>);
+    bits::test_radixsort_keys(radix11sort_keys_size64<uint64_t>, radix11sort_size64<uint64_t>);
+}
+
+TEST_CASE("cpp/radix11sort_size64 float")
+{
+    bits::test_radixsort_sizes(radix11sort_size64<float>);
+    bits::test_radixsort_keys(radix11sort_keys_size64<float>, radix11sort_size64<float>);
+}
+
+TEST_CASE("cpp/radix11sort_size64 double")
+{
+    bits::test_radixsort_sizes(radix11sort_size64<double>);
+    bits::test_radixsort_keys(radix11sort_keys_size64<double>, radix11sort_size64<double>);
+}
+
+TEST_CASE("cpp/radix11sort_size64 int32_t")
+{
+    bits::test_radixsort_sizes(radix11sort_size64<int32_t>);
+    bits::test_radixsort_keys(radix11sort_keys_size64<int32_t>, radix11sort_size64<int32_t>);
+}
+
+TEST_CASE("cpp/radix11sort_size64 int64_t")
+{
+    bits::test_radixsort_sizes(radix11sort_size64<int64_t>);
+    bits::test_radixsort_keys(radix11sort_keys_size64<int64_t>, radix11sort_size64<int64_t>);
+}
+
+TEST_CASE("cpp/radix11sort 64 bit histogram counts")
+{
+    test_radixsort_counts64<bits::kScatterDirect>();
+    test_radixsort_counts64<bits::kScatterBuffered>();
+    test_radixsort_counts64<bits::kScatterStreaming>();
+    test_radixsort_counts64<bits::kScatterBlock>();
+}
+
+TEST_CASE("cpp/radix8argsort uint32_t")
+{
+    bits::test_radixsort_argsort(radix8argsort_u32, radix8sort_u32);
+}
+
+TEST_CASE("cpp/radix8argsort uint64_t")
+{
+    bits::test_radixsort_argsort(radix8argsort_u64, radix8sort_u64);
+}
+
+TEST_CASE("cpp/radix8argsort float")
+{
+    bits::test_radixsort_argsort(radix8argsort_f32, radix8sort_f32);
+}
+
+TEST_CASE("cpp/radix8argsort double")
+{
+    bits::test_radixsort_argsort(radix8argsort_f64, radix8sort_f64);
+}
+
+TEST_CASE("cpp/radix8argsort int32_t")
+{
+    bits::test_radixsort_argsort(radix8argsort_i32, radix8sort_i32);
+}
+
+TEST_CASE("cpp/radix8argsort int64_t")
+{
+    bits::test_radixsort_argsort(radix8argsort_i64, radix8sort_i64);
+}
+
+TEST_CASE("cpp/radix11argsort uint32_t")
+{
+    bits::test_radixsort_argsort(radix11argsort_u32, radix11sort_u32);
+}
+
+TEST_CASE("cpp/radix11argsort uint64_t")
+{
+    bits::test_radixsort_argsort(radix11argsort_u64, radix11sort_u64);
+}
+
+TEST_CASE("cpp/radix11argsort float")
+{
+    bits::test_radixsort_argsort(radix11argsort_f32, radix11sort_f32);
+}
+
+TEST_CASE("cpp/radix11argsort double")
+{
+    bits::test_radixsort_argsort(radix11argsort_f64, radix11sort_f64);
+}
+
+TEST_CASE("cpp/radix11argsort int32_t")
+{
+    bits::test_radixsort_argsort(radix11argsort_i32, radix11sort_i32);
+}
+
+TEST_CASE("cpp/radix11argsort int64_t")
+{
+    bits::test_radixsort_argsort(radix11argsort_i64, radix11sort_i64);
+}
+
+TEST_CASE("cpp/counting_sort uint8_t")
+{
+    bits::test_radixsort(counting_sort_u8);
+    bits::test_radixsort_sizes(counting_sort_u8);
+    bits::test_radixsort_skip_passes(counting_sort_u8);
+    bits::test_radixsort_presorted(counting_sort_u8);
+    bits::test_radixsort_large(counting_sort_u8, (1 << 16) + 3);
+}
+
+TEST_CASE("cpp/counting_sort int8_t")
+{
+    bits::test_radixsort(counting_sort_i8);
+    bits::test_radixsort_sizes(counting_sort_i8);
+    bits::test_radixsort_skip_passes(counting_sort_i8);
+    bits::test_radixsort_presorted(counting_sort_i8);
+    bits::test_radixsort_large(counting_sort_i8, (1 << 16) + 3);
+}
+
+TEST_CASE("cpp/counting_sort uint16_t")
+{
+    bits::test_radixsort(counting_sort_u16);
+    bits::test_radixsort_sizes(counting_sort_u16);
+    bits::test_radixsort_skip_passes(counting_sort_u16);
+    bits::test_radixsort_narrow_range(counting_sort_u16, uint16_t(0x7c00));
+    bits::test_radixsort_presorted(counting_sort_u16);
+    bits::test_radixsort_large(counting_sort_u16, (1 << 16) + 3);
+}
+
+TEST_CASE("cpp/counting_sort int16_t")
+{
+    bits::test_radixsort(counting_sort_i16);
+    bits::test_radixsort_sizes(counting_sort_i16);
+    bits::test_radixsort_skip_passes(counting_sort_i16);
+    bits::test_radixsort_narrow_range(counting_sort_i16, int16_t(-2048));
+    bits::test_radixsort_presorted(counting_sort_i16);
+    bits::test_radixsort_large(counting_sort_i16, (1 << 16) + 3);
+}
+
+TEST_CASE("cpp/counting_sort half float")
+{
+    bits::test_radixsort_half(counting_sort_f16, bits::half_to_float);
+    bits::test_radixsort_special(counting_sort_f16, uint16_t(0x7c00));
+}
+
+TEST_CASE("cpp/counting_sort bfloat16")
+{
+    bits::test_radixsort_half(counting_sort_bf16, bits::bfloat16_to_float);
+    bits::test_radixsort_special(counting_sort_bf16, uint16_t(0x7f80));
+}
+
+TEST_CASE("cpp/radix8sort float special values")
+{
+    bits::test_radixsort_special<float, uint32_t>(radix8sort_f32);
+}
+
+TEST_CASE("cpp/radix11sort float special values")
+{
+    bits::test_radixsort_special<float, uint32_t>(radix11sort_f32);
+}
+
+TEST_CASE("cpp/radix8sort double special values")
+{
+    bits::test_radixsort_special<double, uint64_t>(radix8sort_f64);
+}
+
+TEST_CASE("cpp/radix11sort double special values")
+{
+    bits::test_radixsort_special<double, uint64_t>(radix11sort_f64);
+}
+
+TEST_CASE("cpp/radix_sort_inplace uint32_t")
+{
+    bits::test_radixsort_inplace(radixsort_inplace_u32);
+}
+
+TEST_CASE("cpp/radix_sort_inplace uint64_t")
+{
+    bits::test_radixsort_inplace(radixsort_inplace_u64);
+}
+
+TEST_CASE("cpp/radix_sort_inplace float")
+{
+    bits::test_radixsort_inplace(radixsort_inplace_f32);
+}
+
+TEST_CASE("cpp/radix8sort_parallel uint32_t")
+{
+    bits::test_radixsort_parallel(radix8sort_parallel_u32, radix8sort_u32);
+}
+
+TEST_CASE("cpp/radix8sort_parallel uint64_t")
+{
+    bits::test_radixsort_parallel(radix8sort_parallel_u64, radix8sort_u64);
+}
+
+TEST_CASE("cpp/radix8sort_parallel float")
+{
+    bits::test_radixsort_parallel(radix8sort_parallel_f32, radix8sort_f32);
+}
+
+TEST_CASE("cpp/radix11sort_parallel uint32_t")
+{
+    bits::test_radixsort_parallel(radix11sort_parallel_u32, radix11sort_u32);
+}
+
+TEST_CASE("cpp/radix11sort_parallel uint64_t")
+{
+    bits::test_radixsort_parallel(radix11sort_parallel_u64, radix11sort_u64);
+}
+
+TEST_CASE("cpp/radix11sort_parallel float")
+{
+    bits::test_radixsort_parallel(radix11sort_parallel_f32, radix11sort_f32);
+}
+
+TEST_CASE("cpp/radix_sort_inplace_parallel uint32_t")
+{
+    bits::test_radixsort_inplace(radixsort_inplace_parallel_u32);
+    bits::test_radixsort_inplace_large(radixsort_inplace_parallel_u32);
+}
+
+TEST_CASE("cpp/radix_sort_inplace_parallel uint64_t")
+{
+    bits::test_radixsort_inplace(radixsort_inplace_parallel_u64);
+    bits::test_radixsort_inplace_large(radixsort_inplace_parallel_u64);
+}
+
+TEST_CASE("cpp/radix_sort_inplace_parallel float")
+{
+    bits::test_radixsort_inplace(radixsort_inplace_parallel_f32);
+    bits::test_radixsort_inplace_large(radixsort_inplace_parallel_f32);
+}
+
+TEST_CASE("cpp/radixsort buffered scatter")
+{
+    test_radixsort_scatter<bits::kScatterBuffered, uint32_t>();
+    test_radixsort_scatter<bits::kScatterBuffered, uint64_t>();
+    test_radixsort_scatter<bits::kScatterBuffered, float>();
+    bits::test_radixsort_sizes(radix11sort_scatter<bits::kScatterBuffered, double>);
+    bits::test_radixsort_large(radix11sort_scatter<bits::kScatterBuffered, double>, (1 << 16) + 3);
+    bits::test_radixsort_special<double, uint64_t>(radix11sort_scatter<bits::kScatterBuffered, double>);
+    bits::test_radixsort_large(radix11sort_scatter<bits::kScatterBuffered, int32_t>, (1 << 16) + 3);
+    bits::test_radixsort_large(radix11sort_scatter<bits::kScatterBuffered, int64_t>, (1 << 16) + 3);
+}
+
+TEST_CASE("cpp/radixsort streaming scatter")
+{
+    test_radixsort_scatter<bits::kScatterStreaming, uint32_t>();
+    test_radixsort_scatter<bits::kScatterStreaming, uint64_t>();
+    test_radixsort_scatter<bits::kScatterStreaming, float>();
+    bits::test_radixsort_sizes(radix11sort_scatter<bits::kScatterStreaming, double>);
+    bits::test_radixsort_large(radix11sort_scatter<bits::kScatterStreaming, double>, (1 << 16) + 3);
+    bits::test_radixsort_special<double, uint64_t>(radix11sort_scatter<bits::kScatterStreaming, double>);
+    bits::test_radixsort_large(radix11sort_scatter<bits::kScatterStreaming, int32_t>, (1 << 16) + 3);
+    bits::test_radixsort_large(radix11sort_scatter<bits::kScatterStreaming, int64_t>, (1 << 16) + 3);
+}
+
+TEST_CASE("cpp/radixsort block scatter")
+{
+    test_radixsort_scatter<bits::kScatterBlock, uint32_t>();
+    test_radixsort_scatter<bits::kScatterBlock, uint64_t>();
+    test_radixsort_scatter<bits::kScatterBlock, float>();
+    bits::test_radixsort_sizes(radix11sort_scatter<bits::kScatterBlock, double>);
+    bits::test_radixsort_large(radix11sort_scatter<bits::kScatterBlock, double>, (1 << 16) + 3);
+    bits::test_radixsort_special<double, uint64_t>(radix11sort_scatter<bits::kScatterBlock, double>);
+    bits::test_radixsort_large(radix11sort_scatter<bits::kScatterBlock, int32_t>, (1 << 16) + 3);
+    bits::test_radixsort_large(radix11sort_scatter<bits::kScatterBlock, int64_t>, (1 << 16) + 3);
+}
+
+TEST_CASE("cpp/radixsort large values")
+{
+    test_radixsort_large_values<bits::kScatterAuto>();
+    test_radixsort_large_values<bits::kScatterBuffered>();
+    test_radixsort_large_values<bits::kScatterStreaming>();
+    test_radixsort_large_values<bits::kScatterBlock>();
+    test_radixsort_large_values<bits::kScatterAuto>(4);
+}
+
+TEST_CASE("cpp/radix_sort uint32_t digit plans")
+{
+    test_radixsort_plan<bits::DigitPlan<11, 11, 10>, uint32_t>(0x00fffc00u);
+    test_radixsort_plan<bits::DigitPlan<16, 16>, uint32_t>(0x00fffc00u);
+    test_radixsort_plan<bits::DigitPlan<6, 13, 13>, uint32_t>(0x00fffc00u);
+}
+
+TEST_CASE("cpp/radix_sort uint64_t digit plans")
+{
+    test_radixsort_plan<bits::DigitPlan<11, 11, 11, 11, 10, 10>, uint64_t>(UINT64_C(0x0123456789fffc00));
+    test_radixsort_plan<bits::DigitPlan<16, 16, 16, 16>, uint64_t>(UINT64_C(0x0123456789fffc00));
+    test_radixsort_plan<bits::DigitPlan<13, 13, 13, 13, 12>, uint64_t>(UINT64_C(0x0123456789fffc00));
+}
+
+TEST_CASE("cpp/radix_sort float digit plans")
+{
+    test_radixsort_plan<bits::DigitPlan<11, 11, 10>, float>(1000000.0f);
+    test_radixsort_plan<bits::DigitPlan<16, 16>, float>(1000000.0f);
+}
+
+TEST_CASE("cpp/radix_sort double digit plans")
+{
+    test_radixsort_plan<bits::DigitPlan<11, 11, 11, 11, 10, 10>, double>(1000000.0);
+    test_radixsort_plan<bits::DigitPlan<16, 16, 16, 16>, double>(1000000.0);
+}
+
+TEST_CASE("cpp/radix_sort signed digit plans")
+{
+    test_radixsort_plan<bits::DigitPlan<11, 11, 10>, int32_t>(-2048);
+    test_radixsort_plan<bits::DigitPlan<16, 16>, int32_t>(-2048);
+    test_radixsort_plan<bits::DigitPlan<16, 16, 16, 16>, int64_t>(INT64_C(-2048));
+}
+
+TEST_CASE("cpp/radix_sort records uint32_t")
+{
+    test_radixsort_records<uint32_t>(0x00fffc00u);
+}
+
+TEST_CASE("cpp/radix_sort records uint64_t")
+{
+    test_radixsort_records<uint64_t>(UINT64_C(0x0123456789fffc00));
+}
+
+TEST_CASE("cpp/radix_sort records float")
+{
+    test_radixsort_records<float>(1000000.0f);
+    bits::test_radixsort_special<float, uint32_t>(radix_sort_records<float>);
+}
+
+TEST_CASE("cpp/radix_sort records double")
+{
+    test_radixsort_records<double>(1000000.0);
+    bits::test_radixsort_special<double, uint64_t>(radix_sort_records<double>);
+}
+
+TEST_CASE("cpp/radix_sort records signed")
+{
+    test_radixsort_records<int32_t>(-2048);
+    test_radixsort_records<int64_t>(INT64_C(-2048));
+}
+
+TEST_CASE("cpp/radix_sort records projected keys")
+{
+    // narrow keys are widened keeping their sign, and keys may be computed
+    // from the record
+    std::mt19937 rng;
+    for (uint32_t size : {100u, 1000u})
+    {
+        std::vector<Record<int16_t>> records(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            records[i].value = i;
+            records[i].key = static_cast<int16_t>(rng());
+        }
+
+        std::vector<Record<int16_t>> sorted[2] = {records, std::vector<Record<int16_t>>(size)};
+        std::vector<Record<int16_t>> expected = records;
+        std::stable_sort(expected.begin(), expected.end(),
+            [](const Record<int16_t>& a, const Record<int16_t>& b) { return a.key < b.key; });
+        uint32_t out = bits::radix_sort(sorted[0].data(), sorted[1].data(), size,
+            [](const Record<int16_t>& record) { return record.key; });
+        REQUIRE(out < 2);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            REQUIRE(sorted[out][i].value == expected[i].value);
+        }
+
+        sorted[0] = records;
+        expected = records;
+        std::stable_sort(expected.begin(), expected.end(), [](const Record<int16_t>& a, const Record<int16_t>& b) {
+            return (a.key & 0xff) > (b.key & 0xff);
+        });
+        out = bits::radix_sort(sorted[0].data(), sorted[1].data(), size,
+            [](const Record<int16_t>& record) { return uint8_t(~record.key); });
+        REQUIRE(out < 2);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            REQUIRE(sorted[out][i].value == expected[i].value);
+        }
+    }
+}
+
+TEST_CASE("cpp/apply_permutation")
+{
+    bits::test_apply_permutation(apply_permutation);
+
+    // a column of one type
+    std::vector<uint32_t> indices = {3, 0, 2, 1};
+    const std::vector<double> values_in = {0.5, 1.5, 2.5, 3.5};
+    std::vector<double> values_out(indices.size());
+    bits::apply_permutation(indices.data(), 4, values_in.data(), values_out.data());
+    REQUIRE(values_out == std::vector<double>({3.5, 0.5, 2.5, 1.5}));
 }